@@ -33,6 +33,8 @@
 
 #include <djv_convert.h>
 
+#include <djv_file_batch.h>
+#include <djv_file_prefetch.h>
 #include <djv_image_io.h>
 #include <djv_user.h>
 #include <djv_system.h>
@@ -48,7 +50,8 @@ using djv::Time;
 
 Options::Options() :
     scale(1.0),
-    channel(Gl_Image_Options::CHANNEL(0))
+    channel(Gl_Image_Options::CHANNEL(0)),
+    memory_stats(false)
 {}
 
 //------------------------------------------------------------------------------
@@ -59,7 +62,9 @@ Input::Input() :
     layer(0),
     proxy(Pixel_Data_Info::PROXY(0)),
     slate_frames(0),
-    timeout(0)
+    timeout(0),
+    prefetch(8),
+    batch(0)
 {}
 
 //------------------------------------------------------------------------------
@@ -94,7 +99,10 @@ const String
     label_timeout = "Timeout...",
     label_estimate = "[%%%] Estimated = %% (%% Frames/Second)",
     label_complete = "[100%] ",
-    label_elapsed = "Elapsed = %%";
+    label_elapsed = "Elapsed = %%",
+    label_page_faults = "Page faults = %% per frame",
+    label_memory = "Memory:",
+    label_memory_stat = "    %%";
 
 const String
     error_command_line_input = "Input",
@@ -222,6 +230,14 @@ void Application::command_line(String & in) throw (Error)
             {
                 in >> _input.timeout;
             }
+            else if ("-prefetch" == arg)
+            {
+                in >> _input.prefetch;
+            }
+            else if ("-batch" == arg)
+            {
+                in >> _input.batch;
+            }
 
             // Output options.
 
@@ -251,6 +267,13 @@ void Application::command_line(String & in) throw (Error)
                 in >> _output.tag_auto;
             }
 
+            // Other options.
+
+            else if ("-memory_stats" == arg)
+            {
+                _options.memory_stats = true;
+            }
+
             // Arguments.
 
             else
@@ -352,6 +375,15 @@ const String label_command_line_help =
 "         Set the maximum number of seconds to wait for each input frame."
 " Default = %%.\n"
 "\n"
+"     -prefetch (value)\n"
+"         Set the number of input frames that are read into the cache ahead"
+" of loading. Default = %%.\n"
+"\n"
+"     -batch (value)\n"
+"         Set the number of input frames that are read together with a single"
+" batch of system calls. This is only available on Linux with io_uring"
+" support. Default = %%.\n"
+"\n"
 " Output Options\n"
 "\n"
 "     -pixel (value)\n"
@@ -367,6 +399,13 @@ const String label_command_line_help =
 "         Automatically generate image tags (e.g., timecode). Options = %%."
 " Default = %%.\n"
 "\n"
+" Other Options\n"
+"\n"
+"     -memory_stats\n"
+"         Print the memory usage for each category (e.g., images, temporary"
+" buffers, memory-mapped files) and the page faults per frame after the"
+" conversion.\n"
+"\n"
 "%%"
 " Examples\n"
 "\n"
@@ -411,6 +450,8 @@ String Application::command_line_help() const
         arg(String_Util::lower(Pixel_Data_Info::label_proxy()), ", ").
         arg(String_Util::lower(String_Util::label(_input.proxy))).
         arg(_input.timeout).
+        arg(_input.prefetch).
+        arg(_input.batch).
         arg(String_Util::lower(Pixel::label_pixel()), ", ").
         arg(String_Util::lower(Speed::label_fps()), ", ").
         arg(String_Util::lower(String_Util::label_bool()), ", ").
@@ -601,8 +642,11 @@ bool Application::work()
 
     // Work.
 
-    _offscreen_buffer =
-        std::auto_ptr<Gl_Offscreen_Buffer>(new Gl_Offscreen_Buffer(save_info));
+    if (Gl_Image::BACKEND_OPENGL == Gl_Image::default_backend)
+    {
+        _offscreen_buffer = std::auto_ptr<Gl_Offscreen_Buffer>(
+            new Gl_Offscreen_Buffer(save_info));
+    }
 
     static const int progress_length = 10;
     int progress_count = 0;
@@ -625,11 +669,55 @@ bool Application::work()
 
     const int64_t length = static_cast<int64_t>(save_info.seq.list.size());
 
+    const int64_t load_length =
+        static_cast<int64_t>(load_info.seq.list.size());
+
+    const uint64_t page_faults = System::page_faults();
+
+    const bool batch =
+        _input.batch > 0 &&
+        File::SEQ == _input.file.type() &&
+        File_Batch::global()->available();
+
     for (int64_t i = 0; i < length; ++i)
     {
         Timer frame_timer;
         frame_timer.start();
 
+        // Read the next batch of input frames.
+
+        if (batch && 0 == i % _input.batch && i < load_length)
+        {
+            List<String> files;
+
+            const int64_t end = Math::min(i + _input.batch, load_length);
+
+            for (int64_t j = i; j < end; ++j)
+            {
+                files += _input.file.get(load_info.seq.list[j]);
+            }
+
+            File_Batch::global()->read(files);
+        }
+
+        // Start reading the next input frames.
+
+        if (! batch &&
+            _input.prefetch > 0 &&
+            File::SEQ == _input.file.type() &&
+            i + 1 < static_cast<int64_t>(load_info.seq.list.size()))
+        {
+            File_Prefetch::global()->seq(
+                _input.file,
+                List<int64_t>(
+                    load_info.seq.list,
+                    i + 1,
+                    Math::min(
+                        static_cast<int64_t>(_input.prefetch),
+                        static_cast<int64_t>(load_info.seq.list.size()) -
+                            i - 1)));
+        }
+
         // Load.
 
         Image image;
@@ -769,6 +857,25 @@ bool Application::work()
     print(String_Format(label_elapsed).
         arg(Time::label_time(timer.seconds())));
 
+    if (_options.memory_stats)
+    {
+        print(label_memory);
+
+        const List<String> stats = Memory::label_stats();
+
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            print(String_Format(label_memory_stat).arg(stats[i]));
+        }
+
+        if (length > 0)
+        {
+            print(String_Format(label_page_faults).
+                arg(static_cast<int>(
+                    (System::page_faults() - page_faults) / length)));
+        }
+    }
+
     return true;
 }
 
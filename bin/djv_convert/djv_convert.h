@@ -66,6 +66,7 @@ struct Options
     V2f                       scale;
     Gl_Image_Options::CHANNEL channel;
     V2i                       size;
+    bool                      memory_stats;
 };
 
 //------------------------------------------------------------------------------
@@ -88,6 +89,8 @@ struct Input
     File                   slate;
     int                    slate_frames;
     int                    timeout;
+    int                    prefetch;
+    int                    batch;
 };
 
 //------------------------------------------------------------------------------
@@ -35,8 +35,6 @@
 
 #include <djv_assert.h>
 
-#include <algorithm>
-
 namespace djv_view
 {
 
@@ -55,12 +53,20 @@ Cache_Ref::Cache_Ref(Image * in, const void * key, int64_t frame) :
     _image(in),
     _key(key),
     _frame(frame),
-    _ref_count(1)
+    _ref_count(1),
+    _prev(0),
+    _next(0),
+    _hash_next(0)
 {
     ++ref_alive;
 
     //DJV_DEBUG("Cache_Ref::Cache_Ref");
     //DJV_DEBUG_PRINT("alive = " << ref_alive);
+
+    if (_image.get())
+    {
+        _image->memory_tag(Memory::TAG_CACHE);
+    }
 }
 
 Cache_Ref::~Cache_Ref()
@@ -110,8 +116,19 @@ int Cache_Ref::ref_count() const
 // Cache
 //------------------------------------------------------------------------------
 
+namespace
+{
+
+const size_t hash_size_min = 1024;
+
+} // namespace
+
 Cache::Cache() :
     signal(this),
+    _head(0),
+    _tail(0),
+    _hash(0, hash_size_min),
+    _hash_size(0),
     _cache_max(default_size()[4] * Memory::megabyte),
     _cache_size(0),
     _type(CACHE_LRU_PLAYBACK)
@@ -129,11 +146,15 @@ Cache::~Cache()
 
     // Cleanup.
 
-    const Ref_List::iterator end = _refs.end();
+    Cache_Ref * ref = _head;
 
-    for (Ref_List::iterator i = _refs.begin(); i != end; ++i)
+    while (ref)
     {
-        delete *i;
+        Cache_Ref * next = ref->_next;
+
+        delete ref;
+
+        ref = next;
     }
 }
 
@@ -148,13 +169,29 @@ Cache_Ref * Cache::create(Image * image, const void * key, int64_t frame)
     debug();
 #endif
 
+    // Replace any existing reference to the same frame.
+
+    if (Cache_Ref * ref = hash_find(key, frame))
+    {
+        if (! ref->ref_count())
+        {
+            ref_del(ref);
+        }
+        else
+        {
+            index_del(ref);
+        }
+    }
+
     // Create a new reference.
 
     Cache_Ref * out = new Cache_Ref(image, key, frame);
 
     // Add the reference to the end of the list.
 
-    _refs += out;
+    list_add(out);
+
+    index_add(out);
 
     // Update the cache size.
 
@@ -184,29 +221,20 @@ Cache_Ref * Cache::get(const void * key, int64_t frame)
     //debug();
 #endif
 
-    Cache_Ref * out = 0;
+    Cache_Ref * out = hash_find(key, frame);
 
-    const Ref_List::iterator end = _refs.end();
-
-    for (Ref_List::iterator i = _refs.begin(); i != end; ++i)
-        if (key == (*i)->key() && frame == (*i)->frame())
-        {
-            // Found the reference.
-
-            out = *i;
-
-            // Increment the reference count.
-
-            out->ref_inc();
+    if (out)
+    {
+        // Increment the reference count.
 
-            // Move the reference to the end of the list.
+        out->ref_inc();
 
-            _refs.erase(i);
+        // Move the reference to the end of the list.
 
-            _refs += out;
+        list_del(out);
 
-            break;
-        }
+        list_add(out);
+    }
 
 #if defined(DJV_DEBUG)
     debug();
@@ -226,43 +254,29 @@ void Cache::del(const void * key)
     debug();
 #endif
 
-    // Find null references matching key.
-
-    List<Ref_List::iterator> dels;
-
-    const Ref_List::iterator end = _refs.end();
-
-    for (Ref_List::iterator i = _refs.begin(); i != end; ++i)
-        if (
-            ! (*i)->ref_count() &&
-            key == (*i)->key())
-        {
-            dels.push_front(i);
-        }
-
-    // Delete the null references.
-
-    //DJV_DEBUG_PRINT("delete list = " << dels.size());
+    const Key_Map::iterator i = _keys.find(key);
 
-    for (size_t i = 0; i < dels.size(); ++i)
+    if (i != _keys.end())
     {
-        _cache_size -= (*dels[i])->get()->bytes_data();
-
-        delete *dels[i];
-
-        _refs.erase(dels[i]);
-    }
+        // Delete the null references matching key. Initialize any remaining
+        // references matching key; they will be cleaned up later.
 
-    // Initialize any remaining references matching key; they will be cleaned
-    // up later.
+        const List<int64_t> frames = i->second.frames;
 
-    const Ref_List::const_iterator end2 = _refs.end();
-
-    for (Ref_List::const_iterator i = _refs.begin(); i != end2; ++i)
-        if (key == (*i)->key())
+        for (size_t j = 0; j < frames.size(); ++j)
         {
-            (*i)->key(0);
+            Cache_Ref * ref = hash_find(key, frames[j]);
+
+            if (! ref->ref_count())
+            {
+                ref_del(ref);
+            }
+            else
+            {
+                index_del(ref);
+            }
         }
+    }
 
     // Signal that the cache has changed.
 
@@ -281,29 +295,20 @@ void Cache::del()
     debug();
 #endif
 
-    // Find all null references.
+    // Delete all the null references.
 
-    List<Ref_List::iterator> dels;
+    Cache_Ref * ref = _head;
 
-    const Ref_List::iterator end = _refs.end();
+    while (ref)
+    {
+        Cache_Ref * next = ref->_next;
 
-    for (Ref_List::iterator i = _refs.begin(); i != end; ++i)
-        if (! (*i)->ref_count())
+        if (! ref->ref_count())
         {
-            dels.push_front(i);
+            ref_del(ref);
         }
 
-    // Delete the null references.
-
-    //DJV_DEBUG_PRINT("delete list = " << dels.size());
-
-    for (size_t i = 0; i < dels.size(); ++i)
-    {
-        _cache_size -= (*dels[i])->get()->bytes_data();
-
-        delete *dels[i];
-
-        _refs.erase(dels[i]);
+        ref = next;
     }
 
     // Signal that the cache has changed.
@@ -315,21 +320,16 @@ void Cache::del()
 #endif
 }
 
-List<int64_t> Cache::frames(const void * key)
+bool Cache::contains(const void * key, int64_t frame) const
 {
-    List<int64_t> out;
-
-    const Ref_List::const_iterator end = _refs.end();
-
-    for (Ref_List::const_iterator i = _refs.begin(); i != end; ++i)
-        if (key == (*i)->key())
-        {
-            out += (*i)->frame();
-        }
+    return hash_find(key, frame) != 0;
+}
 
-    std::sort(out.begin(), out.end());
+List<int64_t> Cache::frames(const void * key) const
+{
+    const Key_Map::const_iterator i = _keys.find(key);
 
-    return out;
+    return i != _keys.end() ? List<int64_t>(i->second.frames) : List<int64_t>();
 }
 
 void Cache::max(int in)
@@ -357,17 +357,11 @@ int Cache::max() const
 
 int Cache::size(const void * key) const
 {
-    uint64_t size = 0;
-
-    const Ref_List::const_iterator end = _refs.end();
+    const Key_Map::const_iterator i = _keys.find(key);
 
-    for (Ref_List::const_iterator i = _refs.begin(); i != end; ++i)
-        if (key == (*i)->key())
-        {
-            size += (*i)->get()->bytes_data();
-        }
-
-    return static_cast<int>(size / Memory::megabyte);
+    return i != _keys.end() ?
+        static_cast<int>(i->second.size / Memory::megabyte) :
+        0;
 }
 
 int Cache::size() const
@@ -443,10 +437,8 @@ void Cache::purge()
     debug();
 #endif
 
-    // Find null references we can delete to bring the cache size below the
-    // maximum size.
-
-    List<Ref_List::iterator> dels;
+    // Delete the least recently used null references until the cache size is
+    // below the maximum size.
 
     switch (_type)
     {
@@ -455,42 +447,26 @@ void Cache::purge()
 
         case CACHE_LRU_PLAYBACK:
         {
-            // Find null references that are before the current frame.
+            // Start with the null references that are before the current
+            // frame.
 
-            const int64_t frame =
-                _refs.begin() != _refs.end() ?
-                (_refs.back()->frame()) :
-                0;
+            const int64_t frame = _tail ? _tail->frame() : 0;
 
             //DJV_DEBUG_PRINT("frame = " << frame);
 
-            const Ref_List::iterator end = _refs.end();
+            Cache_Ref * ref = _head;
 
-            for (Ref_List::iterator i = _refs.begin(); i != end; ++i)
+            while (ref && _cache_size > _cache_max)
             {
-                if (
-                    ! (*i)->ref_count() &&
-                    (*i)->frame() < frame &&
-                    _cache_size > _cache_max)
-                {
-                    _cache_size -= (*i)->get()->bytes_data();
+                Cache_Ref * next = ref->_next;
 
-                    dels.push_front(i);
+                if (! ref->ref_count() && ref->frame() < frame)
+                {
+                    ref_del(ref);
                 }
-            }
-
-            // Delete the null references.
-
-            //DJV_DEBUG_PRINT("delete list = " << dels.size());
 
-            for (size_t i = 0; i < dels.size(); ++i)
-            {
-                delete *dels[i];
-
-                _refs.erase(dels[i]);
+                ref = next;
             }
-
-            dels.clear();
         }
         break;
 
@@ -498,38 +474,209 @@ void Cache::purge()
             break;
     }
 
-    const Ref_List::iterator end = _refs.end();
+    Cache_Ref * ref = _head;
 
-    for (Ref_List::iterator i = _refs.begin(); i != end; ++i)
+    while (ref && _cache_size > _cache_max)
     {
-        if (
-            ! (*i)->ref_count() &&
-            _cache_size > _cache_max)
+        Cache_Ref * next = ref->_next;
+
+        if (! ref->ref_count())
         {
-            _cache_size -= (*i)->get()->bytes_data();
+            ref_del(ref);
+        }
+
+        ref = next;
+    }
+
+    // Signal that the cache has changed.
+
+    signal.emit(true);
 
-            dels.push_front(i);
+#if defined(DJV_DEBUG)
+    debug();
+#endif
+}
+
+void Cache::list_add(Cache_Ref * in)
+{
+    in->_prev = _tail;
+    in->_next = 0;
+
+    if (_tail)
+    {
+        _tail->_next = in;
+    }
+    else
+    {
+        _head = in;
+    }
+
+    _tail = in;
+}
+
+void Cache::list_del(Cache_Ref * in)
+{
+    if (in->_prev)
+    {
+        in->_prev->_next = in->_next;
+    }
+    else
+    {
+        _head = in->_next;
+    }
+
+    if (in->_next)
+    {
+        in->_next->_prev = in->_prev;
+    }
+    else
+    {
+        _tail = in->_prev;
+    }
+
+    in->_prev = 0;
+    in->_next = 0;
+}
+
+size_t Cache::hash(const void * key, int64_t frame) const
+{
+    size_t out = reinterpret_cast<size_t>(key) >> 3;
+
+    out ^= static_cast<size_t>(frame) * 2654435761u;
+    out ^= out >> 16;
+
+    // The table size is always a power of two.
+
+    return out & (_hash.size() - 1);
+}
+
+Cache_Ref * Cache::hash_find(const void * key, int64_t frame) const
+{
+    if (! key)
+    {
+        return 0;
+    }
+
+    Cache_Ref * ref = _hash[hash(key, frame)];
+
+    while (ref && ! (key == ref->_key && frame == ref->_frame))
+    {
+        ref = ref->_hash_next;
+    }
+
+    return ref;
+}
+
+void Cache::hash_add(Cache_Ref * in)
+{
+    if (_hash_size + 1 > _hash.size())
+    {
+        hash_resize(_hash.size() * 2);
+    }
+
+    Cache_Ref *& bucket = _hash[hash(in->_key, in->_frame)];
+
+    in->_hash_next = bucket;
+
+    bucket = in;
+
+    ++_hash_size;
+}
+
+void Cache::hash_del(Cache_Ref * in)
+{
+    Cache_Ref ** ref = &_hash[hash(in->_key, in->_frame)];
+
+    while (*ref && *ref != in)
+    {
+        ref = &(*ref)->_hash_next;
+    }
+
+    DJV_ASSERT(*ref);
+
+    *ref = in->_hash_next;
+
+    in->_hash_next = 0;
+
+    --_hash_size;
+}
+
+void Cache::hash_resize(size_t size)
+{
+    //DJV_DEBUG("Cache::hash_resize");
+    //DJV_DEBUG_PRINT("size = " << static_cast<int>(size));
+
+    List<Cache_Ref *> tmp(0, size);
+
+    _hash.swap(tmp);
+
+    for (size_t i = 0; i < tmp.size(); ++i)
+    {
+        Cache_Ref * ref = tmp[i];
+
+        while (ref)
+        {
+            Cache_Ref * next = ref->_hash_next;
+
+            Cache_Ref *& bucket = _hash[hash(ref->_key, ref->_frame)];
+
+            ref->_hash_next = bucket;
+
+            bucket = ref;
+
+            ref = next;
         }
     }
+}
+
+void Cache::index_add(Cache_Ref * in)
+{
+    if (! in->_key)
+    {
+        return;
+    }
+
+    hash_add(in);
 
-    // Delete the null references.
+    Key_Index & index = _keys[in->_key];
 
-    //DJV_DEBUG_PRINT("delete list = " << dels.size());
+    index.frames.add(in->_frame);
+    index.size += in->get()->bytes_data();
+}
 
-    for (size_t i = 0; i < dels.size(); ++i)
+void Cache::index_del(Cache_Ref * in)
+{
+    if (! in->_key)
     {
-        delete *dels[i];
+        return;
+    }
+
+    hash_del(in);
+
+    const Key_Map::iterator i = _keys.find(in->_key);
+
+    DJV_ASSERT(i != _keys.end());
 
-        _refs.erase(dels[i]);
+    i->second.frames.erase(in->_frame);
+    i->second.size -= in->get()->bytes_data();
+
+    if (i->second.frames.empty())
+    {
+        _keys.erase(i);
     }
 
-    // Signal that the cache has changed.
+    in->_key = 0;
+}
 
-    signal.emit(true);
+void Cache::ref_del(Cache_Ref * in)
+{
+    index_del(in);
 
-#if defined(DJV_DEBUG)
-    debug();
-#endif
+    list_del(in);
+
+    _cache_size -= in->get()->bytes_data();
+
+    delete in;
 }
 
 Cache * Cache::global()
@@ -547,18 +694,17 @@ Cache * Cache::global()
 void Cache::debug()
 {
     //DJV_DEBUG("Cache::debug");
-    //DJV_DEBUG_PRINT("refs = " << _refs.size());
+    //DJV_DEBUG_PRINT("refs = " << static_cast<int>(_hash_size));
     //DJV_DEBUG_PRINT("cache max = " <<
     //    static_cast<int>(_cache_max / Memory::megabyte));
     //DJV_DEBUG_PRINT("cache size = " <<
     //    static_cast<int>(_cache_size / Memory::megabyte));
 
-    //const Ref_List::const_iterator end = _refs.end();
-    //for (Ref_List::const_iterator i = _refs.begin(); i != end; ++i)
+    //for (const Cache_Ref * i = _head; i; i = i->_next)
     //    DJV_DEBUG_PRINT(
-    //        "item (ref = " << (*i)->ref_count() << ") = " <<
-    //        reinterpret_cast<int64_t>((*i)->key()) << " " <<
-    //        (*i)->frame());
+    //        "item (ref = " << i->ref_count() << ") = " <<
+    //        reinterpret_cast<int64_t>(i->key()) << " " <<
+    //        i->frame());
 }
 
 //------------------------------------------------------------------------------
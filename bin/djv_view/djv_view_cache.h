@@ -36,6 +36,9 @@
 
 #include <djv_callback.h>
 #include <djv_image.h>
+#include <djv_set.h>
+
+#include <map>
 
 namespace djv_view
 {
@@ -63,10 +66,6 @@ public:
 
     Image * get();
 
-    //! Set the key.
-
-    void key(const void *);
-
     //! Get the key.
 
     const void * key() const;
@@ -89,16 +88,33 @@ public:
 
 private:
 
+    // The key can only be changed by the cache, since references are indexed
+    // by key.
+
+    void key(const void *);
+
     std::auto_ptr<Image> _image;
     const void *         _key;
     int64_t              _frame;
     int                  _ref_count;
+
+    // The LRU list and hash table links are managed by the cache.
+
+    Cache_Ref *          _prev;
+    Cache_Ref *          _next;
+    Cache_Ref *          _hash_next;
+
+    friend class Cache;
 };
 
 //------------------------------------------------------------------------------
 //! \class Cache
 //!
 //! This class provides a memory cache.
+//!
+//! References are indexed with a hash table keyed by (key, frame) and kept in
+//! least recently used order with an intrusive list, so looking up, adding,
+//! and evicting a reference does not depend on the size of the cache.
 //------------------------------------------------------------------------------
 
 class Cache : public Callback
@@ -129,9 +145,14 @@ public:
 
     void del();
 
-    //! Get a list of frames for the given key.
+    //! Get whether the given frame is in the cache. This does not change the
+    //! order of the references.
+
+    bool contains(const void * key, int64_t frame) const;
+
+    //! Get a sorted list of frames for the given key.
 
-    List<int64_t> frames(const void * key);
+    List<int64_t> frames(const void * key) const;
 
     //! Set the maximum cache size.
 
@@ -197,12 +218,59 @@ private:
 
     void purge();
 
-    typedef List<Cache_Ref *> Ref_List;
+    // Add a reference to the end of the LRU list.
+
+    void list_add(Cache_Ref *);
+
+    // Remove a reference from the LRU list.
+
+    void list_del(Cache_Ref *);
+
+    // Hash table.
+
+    size_t hash(const void * key, int64_t frame) const;
+
+    Cache_Ref * hash_find(const void * key, int64_t frame) const;
+
+    void hash_add(Cache_Ref *);
+
+    void hash_del(Cache_Ref *);
+
+    void hash_resize(size_t);
+
+    // Add a reference to the hash table and key index.
+
+    void index_add(Cache_Ref *);
+
+    // Remove a reference from the hash table and key index, the reference is
+    // kept in the LRU list with a null key until it is released.
+
+    void index_del(Cache_Ref *);
+
+    // Delete a reference.
+
+    void ref_del(Cache_Ref *);
+
+    struct Key_Index
+    {
+        Key_Index() :
+            size(0)
+        {}
+
+        Set<int64_t> frames;
+        uint64_t     size;
+    };
+
+    typedef std::map<const void *, Key_Index> Key_Map;
 
-    Ref_List _refs;
-    uint64_t _cache_max;
-    uint64_t _cache_size;
-    CACHE    _type;
+    Cache_Ref *       _head;
+    Cache_Ref *       _tail;
+    List<Cache_Ref *> _hash;
+    size_t            _hash_size;
+    Key_Map           _keys;
+    uint64_t          _cache_max;
+    uint64_t          _cache_size;
+    CACHE             _type;
 };
 
 //------------------------------------------------------------------------------
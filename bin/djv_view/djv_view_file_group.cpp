@@ -55,6 +55,7 @@
 
 #include <djv_directory.h>
 #include <djv_file.h>
+#include <djv_file_prefetch.h>
 #include <djv_image_io.h>
 
 #include <FL/Fl.H>
@@ -85,6 +86,7 @@ File_Group::File_Group(
     _u8_conversion          (File_Prefs::global()->u8_conversion()),
     _cache                  (File_Prefs::global()->cache()),
     _cache_ref              (0),
+    _cache_fill             (File_Prefs::global()->cache_fill()),
     _menu                   (0),
     _open_widget            (0),
     _reload_widget          (0),
@@ -100,6 +102,7 @@ File_Group::File_Group(
         _proxy         = copy->_proxy;
         _u8_conversion = copy->_u8_conversion;
         _cache         = copy->_cache;
+        _cache_fill    = copy->_cache_fill;
     }
 
     // Create widgets.
@@ -147,6 +150,8 @@ File_Group::File_Group(
     File_Prefs::global()->u8_conversion_signal.set(
         this, u8_conversion_callback);
     File_Prefs::global()->cache_signal.set(this, cache_callback);
+    File_Prefs::global()->cache_fill_signal.set(this, cache_fill_callback);
+    File_Prefs::global()->read_ahead_signal.set(this, read_ahead_callback);
 
     Cache::global()->signal.set(this, cache_update_callback);
 
@@ -165,6 +170,10 @@ void File_Group::del()
 
     // Cleanup.
 
+    Fl::remove_timeout(cache_fill_timeout_callback, this);
+
+    _queue.stop();
+
     if (_cache_ref)
     {
         _cache_ref->ref_del();
@@ -191,6 +200,7 @@ const String
     menu_proxy = "Pro&xy Scale",
     menu_u8_conversion = "&8-bit Conversion",
     menu_cache = "&Memory Cache",
+    menu_cache_fill = "&Fill Memory Cache",
     menu_cache_clear = "Clear Memory Cac&he",
     menu_messages = "Messa&ges",
     menu_prefs = "&Preferences",
@@ -322,6 +332,14 @@ void File_Group::menu_update(Menu_Item_Group * in, bool seq)
         Menu_Item::TOGGLE,
         _cache);
 
+    in->add(
+        menu_cache_fill,
+        0,
+        _cache_fill_callback,
+        this,
+        Menu_Item::TOGGLE | (! _cache ? Menu_Item::INACTIVE : 0),
+        _cache_fill);
+
     in->add(
         menu_cache_clear,
         0,
@@ -380,6 +398,8 @@ void File_Group::open(const File & in)
 
     cache_del();
 
+    _queue.stop();
+
     _file = File();
     _info = Image_Io_Info();
     _load.reset();
@@ -452,6 +472,8 @@ void File_Group::open(const File & in)
     {
         _layers[i] = _info[i].layer_name;
     }
+
+    read_ahead_update();
 }
 
 void File_Group::open_callback(const File & in)
@@ -469,6 +491,26 @@ void File_Group::_open_callback()
     open_callback(true);
 }
 
+namespace
+{
+
+void u8_convert(const djv::Image & in, djv::Image & out)
+{
+    Pixel_Data_Info info(in.info());
+    info.pixel = Pixel::pixel(info.pixel, Pixel::U8);
+    out.set(info);
+    out.tag = in.tag;
+    out.color_profile = Color_Profile();
+
+    Gl_Image_Options options;
+    options.color_profile = in.color_profile;
+    options.proxy_scale = false;
+
+    Gl_Image::copy(in, out, options);
+}
+
+} // namespace
+
 const djv::Image * File_Group::get(int64_t frame) const
 {
     //DJV_DEBUG("File_Group::get");
@@ -495,36 +537,44 @@ const djv::Image * File_Group::get(int64_t frame) const
     {
         if (_load.get())
         {
-            //DJV_DEBUG_PRINT("loading image");
-
             try
             {
-                _load->load(
-                    _u8_conversion ? that->_image_tmp2 : that->_image_tmp,
-                    Image_Io_Frame_Info(
-                        _info.seq.list.size() ? _info.seq.list[frame] : -1,
-                        _layer,
-                        _proxy));
-                
+                // Use the frame from the read ahead queue if it has been
+                // decoded, otherwise load it now.
+
+                that->_image_queue =
+                    std::auto_ptr<djv::Image>(that->_queue.take(frame));
+
+                djv::Image * image = that->_image_queue.get();
+
+                if (! image)
+                {
+                    //DJV_DEBUG_PRINT("loading image");
+
+                    image =
+                        _u8_conversion ?
+                        &that->_image_tmp2 :
+                        &that->_image_tmp;
+
+                    _load->load(
+                        *image,
+                        Image_Io_Frame_Info(
+                            _info.seq.list.size() ? _info.seq.list[frame] : -1,
+                            _layer,
+                            _proxy));
+                }
+
                 if (_u8_conversion)
                 {
                     //DJV_DEBUG_PRINT("u8 conversion");
-                    //DJV_DEBUG_PRINT("image = " << _image_tmp2);
-                    
-                    Pixel_Data_Info info(_image_tmp2.info());
-                    info.pixel = Pixel::pixel(info.pixel, Pixel::U8);
-                    that->_image_tmp.set(info);
-                    that->_image_tmp.tag = _image_tmp2.tag;
-                    that->_image_tmp.color_profile = Color_Profile();
-                    
-                    Gl_Image_Options options;
-                    options.color_profile = _image_tmp2.color_profile;
-                    options.proxy_scale = false;
-                    
-                    Gl_Image::copy(_image_tmp2, that->_image_tmp, options);
+                    //DJV_DEBUG_PRINT("image = " << *image);
+
+                    u8_convert(*image, that->_image_tmp);
+
+                    image = &that->_image_tmp;
                 }
                 
-                that->_image = &_image_tmp;
+                that->_image = image;
                 
                 //DJV_DEBUG_PRINT("image = " << *_image);
             }
@@ -538,7 +588,12 @@ const djv::Image * File_Group::get(int64_t frame) const
 
         if (_image && _cache)
         {
+            // Frames from the read ahead queue are given to the cache without
+            // making a copy.
+
             that->_cache_ref = Cache::global()->create(
+                _image == _image_queue.get() ?
+                that->_image_queue.release() :
                 new djv::Image(*_image),
                 this,
                 frame);
@@ -553,6 +608,58 @@ const djv::Image * File_Group::get(int64_t frame) const
     return _image;
 }
 
+void File_Group::read_ahead(const List<int64_t> & in)
+{
+    // While playback is stopped the queue is used to fill the cache, so
+    // leave it alone to keep the frames it has already decoded.
+
+    if (! in.size() && _cache_fill_frames.size())
+    {
+        return;
+    }
+
+    // Frames that are already cached don't need to be decoded.
+
+    List<int64_t> frames;
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        if (! (_cache && Cache::global()->contains(this, in[i])))
+        {
+            frames += in[i];
+        }
+    }
+
+    _queue.frames(frames);
+
+    // Start reading the files so they are in the cache by the time the decode
+    // threads get to them.
+
+    if (_queue.running() && File::SEQ == _file.type())
+    {
+        const int64_t size = static_cast<int64_t>(_info.seq.list.size());
+
+        List<int64_t> seq;
+
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            if (frames[i] >= 0 && frames[i] < size)
+            {
+                seq += _info.seq.list[frames[i]];
+            }
+        }
+
+        File_Prefetch::global()->seq(_file, seq);
+    }
+}
+
+void File_Group::cache_fill_frames(const List<int64_t> & in)
+{
+    _cache_fill_frames = in;
+
+    cache_fill_update();
+}
+
 const File & File_Group::file() const
 {
     return _file;
@@ -784,6 +891,8 @@ void File_Group::layer(int in)
 
     //DJV_DEBUG_PRINT("layer = " << _layer);
 
+    read_ahead_update();
+
     image_signal.emit(true);
     update_signal.emit(true);
 }
@@ -825,6 +934,8 @@ void File_Group::proxy(Pixel_Data_Info::PROXY in)
 
     _proxy = in;
 
+    read_ahead_update();
+
     image_signal.emit(true);
     update_signal.emit(true);
 }
@@ -887,6 +998,8 @@ void File_Group::cache(bool in)
 
     _cache = in;
 
+    read_ahead_update();
+
     update_signal.emit(true);
 }
 
@@ -895,6 +1008,28 @@ bool File_Group::cache() const
     return _cache;
 }
 
+void File_Group::cache_fill(bool in)
+{
+    if (in == _cache_fill)
+    {
+        return;
+    }
+
+    //DJV_DEBUG("File_Group::cache_fill");
+    //DJV_DEBUG_PRINT("in = " << in);
+
+    _cache_fill = in;
+
+    read_ahead_update();
+
+    update_signal.emit(true);
+}
+
+bool File_Group::cache_fill() const
+{
+    return _cache_fill;
+}
+
 void File_Group::cache_del()
 {
     //DJV_DEBUG("File_Group::cache_del");
@@ -902,6 +1037,189 @@ void File_Group::cache_del()
     Cache::global()->del(this);
 }
 
+void File_Group::read_ahead_update()
+{
+    //DJV_DEBUG("File_Group::read_ahead_update");
+
+    Fl::remove_timeout(cache_fill_timeout_callback, this);
+
+    _queue.stop();
+
+    // Read ahead is only used for file sequences. Each decode thread needs
+    // its own loader.
+
+    const int size = File_Prefs::global()->read_ahead_threads();
+
+    if (
+        ! _load.get() ||
+        _file.type() != File::SEQ ||
+        ! (File_Prefs::global()->read_ahead() > 0 || (_cache && _cache_fill)) ||
+        size <= 0)
+    {
+        return;
+    }
+
+    //DJV_DEBUG_PRINT("threads = " << size);
+
+    List<Image_Load *> load;
+
+    try
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            Image_Io_Info info;
+
+            load += Image_Load_Factory::global()->get(_file, &info);
+        }
+    }
+    catch (Error error)
+    {
+        for (size_t i = 0; i < load.size(); ++i)
+        {
+            delete load[i];
+        }
+
+        DJV_APP->error(error);
+
+        return;
+    }
+
+    _queue.start(load, _info, _layer, _proxy);
+
+    cache_fill_update();
+}
+
+namespace
+{
+
+const double cache_fill_timeout = 0.05;
+
+} // namespace
+
+void File_Group::cache_fill_update()
+{
+    //DJV_DEBUG("File_Group::cache_fill_update");
+
+    if (! _cache_fill_frames.size())
+    {
+        // Playback has started, the read ahead frames take over the queue.
+
+        Fl::remove_timeout(cache_fill_timeout_callback, this);
+
+        return;
+    }
+
+    // Find the frames that are not cached and will fit in the cache, the
+    // current image is used to estimate the size of each frame.
+
+    List<int64_t> frames;
+
+    if (_cache && _cache_fill && _queue.running() && _image)
+    {
+        const uint64_t bytes = _image->bytes_data();
+
+        const uint64_t max =
+            static_cast<uint64_t>(Cache::global()->max()) * Memory::megabyte;
+        const uint64_t size =
+            static_cast<uint64_t>(Cache::global()->size()) * Memory::megabyte;
+
+        uint64_t available = max > size ? max - size : 0;
+
+        for (size_t i = 0; i < _cache_fill_frames.size(); ++i)
+        {
+            if (Cache::global()->contains(this, _cache_fill_frames[i]))
+            {
+                continue;
+            }
+
+            if (available < bytes)
+            {
+                break;
+            }
+
+            available -= bytes;
+
+            frames += _cache_fill_frames[i];
+        }
+    }
+
+    //DJV_DEBUG_PRINT("frames = " << static_cast<int>(frames.size()));
+
+    _queue.frames(frames);
+
+    Fl::remove_timeout(cache_fill_timeout_callback, this);
+
+    if (frames.size())
+    {
+        Fl::add_timeout(
+            cache_fill_timeout, cache_fill_timeout_callback, this);
+    }
+}
+
+void File_Group::cache_fill_timeout_callback()
+{
+    //DJV_DEBUG("File_Group::cache_fill_timeout_callback");
+
+    // Move the decoded frames into the cache.
+
+    int64_t frame = 0;
+
+    while (djv::Image * tmp = _queue.take_next(frame))
+    {
+        std::auto_ptr<djv::Image> image(tmp);
+
+        if (_u8_conversion)
+        {
+            std::auto_ptr<djv::Image> u8(new djv::Image);
+
+            try
+            {
+                u8_convert(*image, *u8);
+            }
+            catch (Error error)
+            {
+                DJV_APP->error(error);
+
+                continue;
+            }
+
+            image = u8;
+        }
+
+        // Stop when the cache is full.
+
+        const uint64_t max =
+            static_cast<uint64_t>(Cache::global()->max()) * Memory::megabyte;
+        const uint64_t size =
+            static_cast<uint64_t>(Cache::global()->size()) * Memory::megabyte;
+
+        if (size + image->bytes_data() > max)
+        {
+            //DJV_DEBUG_PRINT("cache full");
+
+            _queue.frames(List<int64_t>());
+
+            return;
+        }
+
+        if (! Cache::global()->contains(this, frame))
+        {
+            Cache::global()->create(image.release(), this, frame)->ref_del();
+        }
+    }
+
+    if (_queue.busy())
+    {
+        Fl::repeat_timeout(
+            cache_fill_timeout, cache_fill_timeout_callback, this);
+    }
+}
+
+void File_Group::read_ahead_callback(bool)
+{
+    read_ahead_update();
+}
+
 void File_Group::cache_callback(bool in)
 {
     cache(in);
@@ -917,6 +1235,16 @@ void File_Group::cache_clear_callback(bool)
     Cache::global()->del();
 }
 
+void File_Group::cache_fill_callback(bool in)
+{
+    cache_fill(in);
+}
+
+void File_Group::_cache_fill_callback()
+{
+    cache_fill(_menu->value());
+}
+
 void File_Group::_cache_clear_callback()
 {
     cache_clear_callback(true);
@@ -35,6 +35,7 @@
 #define DJV_VIEW_FILE_GROUP_H
 
 #include <djv_view_cache.h>
+#include <djv_view_frame_queue.h>
 
 #include <djv_row_layout.h>
 #include <djv_menu.h>
@@ -85,6 +86,16 @@ public:
 
     const djv::Image * get(int64_t frame) const;
 
+    //! Set the frames to decode in the background, in order of priority.
+    //! Frames that are already cached are skipped.
+
+    void read_ahead(const List<int64_t> &);
+
+    //! Set the frames to fill the cache with in the background, in order of
+    //! priority. An empty list stops filling the cache.
+
+    void cache_fill_frames(const List<int64_t> &);
+
     //! Get the file.
 
     const File & file() const;
@@ -133,6 +144,16 @@ public:
 
     bool cache() const;
 
+    //! Set whether the cache is filled in the background when playback is
+    //! stopped.
+
+    void cache_fill(bool);
+
+    //! Get whether the cache is filled in the background when playback is
+    //! stopped.
+
+    bool cache_fill() const;
+
     //! This signal is emitted when a file is opened.
 
     Signal<const File &> open_signal;
@@ -176,6 +197,8 @@ public:
 private:
 
     void cache_del();
+    void cache_fill_update();
+    void read_ahead_update();
 
     // Callbacks.
 
@@ -195,8 +218,10 @@ private:
     DJV_CALLBACK(File_Group, proxy_callback, Pixel_Data_Info::PROXY);
     DJV_CALLBACK(File_Group, u8_conversion_callback, bool);
     DJV_CALLBACK(File_Group, cache_callback, bool);
+    DJV_CALLBACK(File_Group, cache_fill_callback, bool);
     DJV_CALLBACK(File_Group, cache_clear_callback, bool);
     DJV_CALLBACK(File_Group, cache_update_callback, bool);
+    DJV_CALLBACK(File_Group, read_ahead_callback, bool);
 
     DJV_FL_WIDGET_CALLBACK(File_Group, _open_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _recent_callback);
@@ -211,20 +236,25 @@ private:
     DJV_FL_WIDGET_CALLBACK(File_Group, _proxy_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _u8_conversion_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _cache_callback);
+    DJV_FL_WIDGET_CALLBACK(File_Group, _cache_fill_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _cache_clear_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _messages_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _prefs_callback);
     DJV_FL_WIDGET_CALLBACK(File_Group, _exit_callback);
 
+    DJV_FL_CALLBACK(File_Group, cache_fill_timeout_callback);
+
     // Variables.
 
     File                      _file;
     File                      _file_save;
     Image_Io_Info             _info;
     std::auto_ptr<Image_Load> _load;
+    Frame_Queue               _queue;
     const djv::Image *        _image;
     djv::Image                _image_tmp;
     djv::Image                _image_tmp2;
+    std::auto_ptr<djv::Image> _image_queue;
     bool                      _seq_auto;
     int                       _layer;
     List<String>              _layers;
@@ -232,6 +262,8 @@ private:
     bool                      _u8_conversion;
     bool                      _cache;
     Cache_Ref *               _cache_ref;
+    bool                      _cache_fill;
+    List<int64_t>             _cache_fill_frames;
     Menu *                    _menu;
     List<int>                 _menu_recent;
     List<int>                 _menu_layer;
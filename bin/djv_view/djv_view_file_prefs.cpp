@@ -47,6 +47,8 @@
 #include <djv_row_layout.h>
 #include <djv_style.h>
 
+#include <djv_system.h>
+
 namespace djv_view
 {
 
@@ -60,6 +62,8 @@ File_Prefs::File_Prefs() :
     proxy_signal(this),
     u8_conversion_signal(this),
     cache_signal(this),
+    cache_fill_signal(this),
+    read_ahead_signal(this),
     _seq_auto(true),
     _command_line_combine(false),
     _proxy(Pixel_Data_Info::PROXY(0)),
@@ -67,7 +71,10 @@ File_Prefs::File_Prefs() :
     _cache(false),
     _cache_size(Cache::default_size()[4]),
     _cache_type(Cache::CACHE_LRU_PLAYBACK),
-    _cache_display(true)
+    _cache_display(true),
+    _cache_fill(false),
+    _read_ahead(16),
+    _read_ahead_threads(Math::min(System::cpu_count(), 4))
 {
     Prefs prefs(Prefs::prefs(), "file");
 
@@ -80,6 +87,9 @@ File_Prefs::File_Prefs() :
     Prefs::get_(&prefs, "cache_size", &_cache_size);
     Prefs::get_(&prefs, "cache_type", &_cache_type);
     Prefs::get_(&prefs, "cache_display", &_cache_display);
+    Prefs::get_(&prefs, "cache_fill", &_cache_fill);
+    Prefs::get_(&prefs, "read_ahead", &_read_ahead);
+    Prefs::get_(&prefs, "read_ahead_threads", &_read_ahead_threads);
 
     Cache::global()->max(_cache_size);
     Cache::global()->type(_cache_type);
@@ -98,6 +108,9 @@ File_Prefs::~File_Prefs()
     Prefs::set_(&prefs, "cache_size", _cache_size);
     Prefs::set_(&prefs, "cache_type", _cache_type);
     Prefs::set_(&prefs, "cache_display", _cache_display);
+    Prefs::set_(&prefs, "cache_fill", _cache_fill);
+    Prefs::set_(&prefs, "read_ahead", _read_ahead);
+    Prefs::set_(&prefs, "read_ahead_threads", _read_ahead_threads);
 }
 
 void File_Prefs::recent(const String & in)
@@ -255,6 +268,57 @@ bool File_Prefs::cache_display() const
     return _cache_display;
 }
 
+void File_Prefs::cache_fill(bool in)
+{
+    if (in == _cache_fill)
+    {
+        return;
+    }
+
+    _cache_fill = in;
+
+    cache_fill_signal.emit(_cache_fill);
+}
+
+bool File_Prefs::cache_fill() const
+{
+    return _cache_fill;
+}
+
+void File_Prefs::read_ahead(int in)
+{
+    if (in == _read_ahead)
+    {
+        return;
+    }
+
+    _read_ahead = in;
+
+    read_ahead_signal.emit(true);
+}
+
+int File_Prefs::read_ahead() const
+{
+    return _read_ahead;
+}
+
+void File_Prefs::read_ahead_threads(int in)
+{
+    if (in == _read_ahead_threads)
+    {
+        return;
+    }
+
+    _read_ahead_threads = in;
+
+    read_ahead_signal.emit(true);
+}
+
+int File_Prefs::read_ahead_threads() const
+{
+    return _read_ahead_threads;
+}
+
 //------------------------------------------------------------------------------
 // Cache_Size_Widget
 //------------------------------------------------------------------------------
@@ -338,7 +402,14 @@ const String
         "are streamed from disk.",
     label_cache_size = "Cache size (megabytes):",
     label_cache_type = "Cache type:",
-    label_cache_display = "Display cached frames in timeline";
+    label_cache_display = "Display cached frames in timeline",
+    label_cache_fill = "Fill the cache in the background when stopped",
+    label_read_ahead_group = "Read Ahead",
+    label_read_ahead_text =
+        "During playback frames are decoded by background threads ahead of "
+        "the current frame. A value of zero disables read ahead.",
+    label_read_ahead = "Frames:",
+    label_read_ahead_threads = "Threads:";
 
 } // namespace
 
@@ -388,6 +459,25 @@ File_Prefs_Widget::File_Prefs_Widget()
 
     Check_Button * cache_display = new Check_Button(label_cache_display);
 
+    Check_Button * cache_fill = new Check_Button(label_cache_fill);
+
+    // Create read ahead widgets.
+
+    Group_Box * read_ahead_group = new Group_Box(label_read_ahead_group);
+
+    Multiline_Label * read_ahead_text =
+        new Multiline_Label(label_read_ahead_text);
+
+    Int_Edit * read_ahead = new Int_Edit;
+    read_ahead->range(0, 1000);
+
+    Label * read_ahead_label = new Label(label_read_ahead);
+
+    Int_Edit * read_ahead_threads = new Int_Edit;
+    read_ahead_threads->range(1, 64);
+
+    Label * read_ahead_threads_label = new Label(label_read_ahead_threads);
+
     // Layout.
 
     Vertical_Layout * layout = new Vertical_Layout(this);
@@ -415,6 +505,17 @@ File_Prefs_Widget::File_Prefs_Widget()
     layout_h->add(cache_size);
     cache_group->layout()->add(cache_type);
     cache_group->layout()->add(cache_display);
+    cache_group->layout()->add(cache_fill);
+
+    layout->add(read_ahead_group);
+    read_ahead_group->layout()->add(read_ahead_text);
+    layout_h = new Horizontal_Layout(read_ahead_group->layout());
+    layout_h->margin(0);
+    layout_h->add(read_ahead_label);
+    layout_h->add(read_ahead);
+    layout_h->add(read_ahead_threads_label);
+    layout_h->add(read_ahead_threads);
+    layout_h->add_stretch();
 
     layout->add_stretch();
 
@@ -428,6 +529,9 @@ File_Prefs_Widget::File_Prefs_Widget()
     cache_size->set(File_Prefs::global()->cache_size());
     cache_type->set(File_Prefs::global()->cache_type());
     cache_display->set(File_Prefs::global()->cache_display());
+    cache_fill->set(File_Prefs::global()->cache_fill());
+    read_ahead->set(File_Prefs::global()->read_ahead());
+    read_ahead_threads->set(File_Prefs::global()->read_ahead_threads());
 
     // Callbacks.
 
@@ -439,6 +543,9 @@ File_Prefs_Widget::File_Prefs_Widget()
     cache_size->signal.set(this, cache_size_callback);
     cache_type->signal.set(this, cache_type_callback);
     cache_display->signal.set(this, cache_display_callback);
+    cache_fill->signal.set(this, cache_fill_callback);
+    read_ahead->signal.set(this, read_ahead_callback);
+    read_ahead_threads->signal.set(this, read_ahead_threads_callback);
 }
 
 void File_Prefs_Widget::seq_auto_callback(bool in)
@@ -481,5 +588,20 @@ void File_Prefs_Widget::cache_display_callback(bool in)
     File_Prefs::global()->cache_display(in);
 }
 
+void File_Prefs_Widget::cache_fill_callback(bool in)
+{
+    File_Prefs::global()->cache_fill(in);
+}
+
+void File_Prefs_Widget::read_ahead_callback(int in)
+{
+    File_Prefs::global()->read_ahead(in);
+}
+
+void File_Prefs_Widget::read_ahead_threads_callback(int in)
+{
+    File_Prefs::global()->read_ahead_threads(in);
+}
+
 } // djv_view
 
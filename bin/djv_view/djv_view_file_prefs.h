@@ -133,6 +133,11 @@ public:
 
     void cache_display(bool);
 
+    //! Set whether the cache is filled in the background when playback is
+    //! stopped.
+
+    void cache_fill(bool);
+
     //! Get whether the cache is enabled.
 
     bool cache() const;
@@ -149,10 +154,39 @@ public:
 
     bool cache_display() const;
 
+    //! Get whether the cache is filled in the background when playback is
+    //! stopped.
+
+    bool cache_fill() const;
+
     //! This signal is emitted when the cache is changed.
 
     Signal<bool> cache_signal;
 
+    //! This signal is emitted when the cache fill is changed.
+
+    Signal<bool> cache_fill_signal;
+
+    //! Set the number of frames to decode ahead of the playhead.
+
+    void read_ahead(int);
+
+    //! Get the number of frames to decode ahead of the playhead.
+
+    int read_ahead() const;
+
+    //! Set the number of decode threads.
+
+    void read_ahead_threads(int);
+
+    //! Get the number of decode threads.
+
+    int read_ahead_threads() const;
+
+    //! This signal is emitted when the read ahead is changed.
+
+    Signal<bool> read_ahead_signal;
+
     //! Get the global preferences.
 
     static File_Prefs * global();
@@ -168,6 +202,9 @@ private:
     int                    _cache_size;
     Cache::CACHE           _cache_type;
     bool                   _cache_display;
+    bool                   _cache_fill;
+    int                    _read_ahead;
+    int                    _read_ahead_threads;
 };
 
 //------------------------------------------------------------------------------
@@ -194,6 +231,9 @@ private:
     DJV_CALLBACK(File_Prefs_Widget, cache_size_callback, int);
     DJV_CALLBACK(File_Prefs_Widget, cache_type_callback, int);
     DJV_CALLBACK(File_Prefs_Widget, cache_display_callback, bool);
+    DJV_CALLBACK(File_Prefs_Widget, cache_fill_callback, bool);
+    DJV_CALLBACK(File_Prefs_Widget, read_ahead_callback, int);
+    DJV_CALLBACK(File_Prefs_Widget, read_ahead_threads_callback, int);
 };
 
 } // djv_view
@@ -0,0 +1,426 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_view_frame_queue.cpp
+
+#include <djv_view_frame_queue.h>
+
+#include <djv_assert.h>
+#include <djv_set.h>
+
+namespace djv_view
+{
+
+//------------------------------------------------------------------------------
+// Frame_Queue::Entry
+//------------------------------------------------------------------------------
+
+Frame_Queue::Entry::Entry() :
+    image  (0),
+    loading(false),
+    wanted (true),
+    failed (false)
+{}
+
+//------------------------------------------------------------------------------
+// Frame_Queue::Worker
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+const String
+    error = "Frame_Queue",
+    error_load = "Cannot load frame";
+
+} // namespace
+
+class Frame_Queue::Worker : public Thread
+{
+public:
+
+    Worker(Frame_Queue * queue, Image_Load * load) :
+        _queue(queue),
+        _load (load)
+    {}
+
+protected:
+
+    void run();
+
+private:
+
+    Frame_Queue *             _queue;
+    std::auto_ptr<Image_Load> _load;
+};
+
+void Frame_Queue::Worker::run()
+{
+    //DJV_DEBUG("Frame_Queue::Worker::run");
+
+    Mutex_Scope scope(_queue->_mutex);
+
+    while (! _queue->_stop)
+    {
+        // Find the next frame to decode.
+
+        int64_t frame = 0;
+
+        if (! _queue->next(frame))
+        {
+            _queue->_work.wait(_queue->_mutex);
+
+            continue;
+        }
+
+        _queue->_entries[frame].loading = true;
+
+        const Image_Io_Frame_Info frame_info(
+            _queue->_info.seq.list.size() ? _queue->_info.seq.list[frame] : -1,
+            _queue->_layer,
+            _queue->_proxy);
+
+        // Decode the frame without holding the lock.
+
+        _queue->_mutex.unlock();
+
+        //DJV_DEBUG_PRINT("frame = " << frame);
+
+        // Errors are caught here so the lock is always taken again below,
+        // and the worker carries on with the next frame.
+
+        std::auto_ptr<Image> image;
+        Error error;
+        bool failed = false;
+
+        try
+        {
+            image.reset(new Image);
+
+            _load->load(*image, frame_info);
+        }
+        catch (Error in)
+        {
+            image.reset();
+            error = in;
+            failed = true;
+        }
+        catch (...)
+        {
+            image.reset();
+            error = Error(djv_view::error, error_load);
+            failed = true;
+        }
+
+        _queue->_mutex.lock();
+
+        // Discard the frame if it is no longer needed.
+
+        Entry_Map::iterator i = _queue->_entries.find(frame);
+
+        DJV_ASSERT(i != _queue->_entries.end());
+
+        if (! i->second.wanted || _queue->_stop)
+        {
+            _queue->_entries.erase(i);
+        }
+        else
+        {
+            i->second.image   = image.release();
+            i->second.loading = false;
+            i->second.failed  = failed;
+            i->second.error   = error;
+        }
+
+        _queue->_ready.broadcast();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Frame_Queue
+//------------------------------------------------------------------------------
+
+Frame_Queue::Frame_Queue() :
+    _layer      (0),
+    _proxy      (Pixel_Data_Info::PROXY_NONE),
+    _frames_next(0),
+    _stop       (false)
+{}
+
+Frame_Queue::~Frame_Queue()
+{
+    stop();
+}
+
+void Frame_Queue::start(
+    const List<Image_Load *> & load,
+    const Image_Io_Info &      info,
+    int                        layer,
+    Pixel_Data_Info::PROXY     proxy)
+{
+    //DJV_DEBUG("Frame_Queue::start");
+    //DJV_DEBUG_PRINT("threads = " << load.size());
+
+    stop();
+
+    _info  = info;
+    _layer = layer;
+    _proxy = proxy;
+
+    for (size_t i = 0; i < load.size(); ++i)
+    {
+        Worker * worker = new Worker(this, load[i]);
+
+        try
+        {
+            worker->start();
+        }
+        catch (Error)
+        {
+            delete worker;
+
+            continue;
+        }
+
+        _workers += worker;
+    }
+}
+
+void Frame_Queue::stop()
+{
+    if (! _workers.size())
+        return;
+
+    //DJV_DEBUG("Frame_Queue::stop");
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        _stop = true;
+    }
+
+    _work.broadcast();
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        _workers[i]->wait();
+
+        delete _workers[i];
+    }
+
+    _workers.clear();
+
+    // Discard the decoded frames.
+
+    const Entry_Map::iterator end = _entries.end();
+
+    for (Entry_Map::iterator i = _entries.begin(); i != end; ++i)
+    {
+        delete i->second.image;
+    }
+
+    _entries.clear();
+    _frames.clear();
+    _frames_next = 0;
+    _stop = false;
+}
+
+bool Frame_Queue::running() const
+{
+    return _workers.size() > 0;
+}
+
+void Frame_Queue::frames(const List<int64_t> & in)
+{
+    if (! _workers.size())
+        return;
+
+    //DJV_DEBUG("Frame_Queue::frames");
+    //DJV_DEBUG_PRINT("in = " << in);
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        _frames = in;
+        _frames_next = 0;
+
+        // Discard frames that are no longer needed. Frames that are still
+        // being decoded are discarded by the worker when it finishes.
+
+        Set<int64_t> wanted;
+        wanted.add(_frames);
+
+        Entry_Map::iterator i = _entries.begin();
+
+        while (i != _entries.end())
+        {
+            i->second.wanted = wanted.find(i->first) != wanted.end();
+
+            if (! i->second.wanted && ! i->second.loading)
+            {
+                delete i->second.image;
+
+                _entries.erase(i++);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    _work.broadcast();
+}
+
+Image * Frame_Queue::take(int64_t frame) throw (Error)
+{
+    if (! _workers.size())
+        return 0;
+
+    //DJV_DEBUG("Frame_Queue::take");
+    //DJV_DEBUG_PRINT("frame = " << frame);
+
+    Entry entry;
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        // Don't start decoding the frame since the caller will load it.
+
+        const int index = List_Util::find(frame, _frames);
+
+        if (index != -1)
+        {
+            _frames.erase(_frames.begin() + index);
+
+            if (static_cast<size_t>(index) < _frames_next)
+            {
+                --_frames_next;
+            }
+        }
+
+        // Wait for the frame if it is being decoded.
+
+        Entry_Map::iterator i = _entries.find(frame);
+
+        while (i != _entries.end() && i->second.loading)
+        {
+            i->second.wanted = true;
+
+            _ready.wait(_mutex);
+
+            i = _entries.find(frame);
+        }
+
+        if (i == _entries.end())
+        {
+            return 0;
+        }
+
+        entry = i->second;
+
+        _entries.erase(i);
+    }
+
+    //DJV_DEBUG_PRINT("ready");
+
+    if (entry.failed)
+    {
+        throw entry.error;
+    }
+
+    return entry.image;
+}
+
+Image * Frame_Queue::take_next(int64_t & frame)
+{
+    if (! _workers.size())
+        return 0;
+
+    Mutex_Scope scope(_mutex);
+
+    Entry_Map::iterator i = _entries.begin();
+
+    while (i != _entries.end())
+    {
+        if (i->second.loading)
+        {
+            ++i;
+        }
+        else if (i->second.failed)
+        {
+            _entries.erase(i++);
+        }
+        else
+        {
+            frame = i->first;
+
+            Image * out = i->second.image;
+
+            _entries.erase(i);
+
+            return out;
+        }
+    }
+
+    return 0;
+}
+
+bool Frame_Queue::busy() const
+{
+    if (! _workers.size())
+        return false;
+
+    Mutex_Scope scope(_mutex);
+
+    return _frames_next < _frames.size() || _entries.size() > 0;
+}
+
+bool Frame_Queue::next(int64_t & out)
+{
+    // Frames before the cursor have already been started, so they don't need
+    // to be checked again.
+
+    for (; _frames_next < _frames.size(); ++_frames_next)
+    {
+        if (_entries.find(_frames[_frames_next]) == _entries.end())
+        {
+            out = _frames[_frames_next++];
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // djv_view
+
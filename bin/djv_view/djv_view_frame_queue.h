@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_view_frame_queue.h
+
+#ifndef DJV_VIEW_FRAME_QUEUE_H
+#define DJV_VIEW_FRAME_QUEUE_H
+
+#include <djv_image.h>
+#include <djv_image_io.h>
+#include <djv_thread.h>
+
+#include <map>
+
+namespace djv_view
+{
+using namespace djv;
+
+//------------------------------------------------------------------------------
+//! \class Frame_Queue
+//!
+//! This class provides a queue of frames that are decoded by background
+//! threads ahead of the playhead.
+//------------------------------------------------------------------------------
+
+class Frame_Queue
+{
+public:
+
+    //! Constructor.
+
+    Frame_Queue();
+
+    //! Destructor.
+
+    ~Frame_Queue();
+
+    //! Start the decode threads. One loader is needed for each thread; the
+    //! queue takes ownership of the loaders.
+
+    void start(
+        const List<Image_Load *> & load,
+        const Image_Io_Info &      info,
+        int                        layer,
+        Pixel_Data_Info::PROXY     proxy);
+
+    //! Stop the decode threads and discard any decoded frames.
+
+    void stop();
+
+    //! Get whether the decode threads are running.
+
+    bool running() const;
+
+    //! Set the frames to decode in order of priority. Decoded frames that are
+    //! not in the list are discarded.
+
+    void frames(const List<int64_t> &);
+
+    //! Take a decoded frame. If the frame is currently being decoded this
+    //! waits for it to finish. Zero is returned if the frame has not been
+    //! decoded and it is removed from the queue so the caller can load it.
+    //! The caller takes ownership of the image.
+
+    Image * take(int64_t frame) throw (Error);
+
+    //! Take any decoded frame. Zero is returned if no frames are ready;
+    //! frames that failed to decode are skipped. The caller takes ownership
+    //! of the image.
+
+    Image * take_next(int64_t & frame);
+
+    //! Get whether there are frames waiting to be decoded or taken.
+
+    bool busy() const;
+
+private:
+
+    class Worker;
+
+    struct Entry
+    {
+        Entry();
+
+        Image * image;
+        bool    loading;
+        bool    wanted;
+        bool    failed;
+        Error   error;
+    };
+
+    typedef std::map<int64_t, Entry> Entry_Map;
+
+    bool next(int64_t &);
+
+    Frame_Queue(const Frame_Queue &);
+    Frame_Queue & operator = (const Frame_Queue &);
+
+    List<Worker *>         _workers;
+    Image_Io_Info          _info;
+    int                    _layer;
+    Pixel_Data_Info::PROXY _proxy;
+    List<int64_t>          _frames;
+    size_t                 _frames_next;
+    Entry_Map              _entries;
+    bool                   _stop;
+    mutable Mutex          _mutex;
+    Condition              _work;
+    Condition              _ready;
+
+    friend class Worker;
+};
+
+} // djv_view
+
+#endif // DJV_VIEW_FRAME_QUEUE_H
+
@@ -61,6 +61,7 @@ const String
     label_pixel = "Pixel:",
     label_time = "Time:",
     label_tag = "Tags:",
+    label_memory = "Memory:",
     label_close = "Clos&e";
 
 } // namespace
@@ -74,6 +75,7 @@ Info_Dialog::Info_Dialog() :
     _pixel_widget     (0),
     _time_widget      (0),
     _tag_widget       (0),
+    _memory_widget    (0),
     _close_widget     (0)
 {
     // Create widgets.
@@ -90,6 +92,8 @@ Info_Dialog::Info_Dialog() :
 
     _tag_widget = new Multiline_Text_Display;
 
+    _memory_widget = new Multiline_Text_Display;
+
     _close_widget = new Push_Button(label_close);
 
     // Layout.
@@ -104,6 +108,7 @@ Info_Dialog::Info_Dialog() :
     form_widget->add_row(label_pixel, _pixel_widget);
     form_widget->add_row(label_time, _time_widget);
     form_widget->add_row(label_tag, _tag_widget);
+    form_widget->add_row(label_memory, _memory_widget);
 
     layout->add_spacer(-1, true);
 
@@ -219,6 +224,14 @@ void Info_Dialog::widget_update()
 
     _tag_widget->set(tmp);
 
+    tmp.clear();
+    const List<String> memory = Memory::label_stats();
+
+    for (size_t i = 0; i < memory.size(); ++i)
+        tmp += memory[i] + "\n";
+
+    _memory_widget->set(tmp);
+
     callbacks(true);
 }
 
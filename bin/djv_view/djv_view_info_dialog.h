@@ -117,6 +117,7 @@ private:
     Text_Display *           _pixel_widget;
     Text_Display *           _time_widget;
     Multiline_Text_Display * _tag_widget;
+    Multiline_Text_Display * _memory_widget;
     Push_Button *            _close_widget;
 };
 
@@ -76,6 +76,8 @@ Playback_Group::Playback_Group(
     _idle_init            (true),
     _idle_frame           (0),
     _speed_counter        (0),
+    _speed_ticks          (0),
+    _frame_step           (1),
     _layout               (Playback_Prefs::global()->layout()),
     _menu                 (0),
     _stop_widget          (0),
@@ -1293,6 +1295,8 @@ void Playback_Group::idle()
         _idle_frame         = 0;
         _speed_timer        = _idle_timer;
         _speed_counter      = 0;
+        _speed_ticks        = 0;
+        _frame_step         = 1;
         _dropped_frames     = false;
         _dropped_frames_tmp = false;
         _idle_init          = false;
@@ -1341,6 +1345,7 @@ void Playback_Group::idle()
     }
 
     _speed_counter += Math::abs(inc);
+    ++_speed_ticks;
 
     // Calculate real playback speed.
 
@@ -1351,6 +1356,14 @@ void Playback_Group::idle()
         _speed_real = _speed_counter / _speed_timer.seconds();
         _speed_timer.start();
 
+        // The average number of frames the playhead moves each update is
+        // used to skip the same frames when reading ahead.
+
+        _frame_step = Math::max(
+            Math::round(_speed_counter / static_cast<double>(_speed_ticks)),
+            1);
+        _speed_ticks = 0;
+
         _dropped_frames = _dropped_frames_tmp;
         _dropped_frames_tmp = false;
         _speed_counter = 0;
@@ -1368,6 +1381,82 @@ void Playback_Group::cached_frames(const List<int64_t> & in)
     _frame_slider->cached_frames(in);
 }
 
+List<int64_t> Playback_Group::frames_ahead(int size) const
+{
+    List<int64_t> out;
+
+    if (Playback::STOP == _playback)
+    {
+        return out;
+    }
+
+    const int64_t frame_in = _in_out ? frame_min() : 0;
+    const int64_t frame_out = _in_out ? frame_max() : seq_max(_seq);
+
+    size = static_cast<int>(Math::min(
+        static_cast<int64_t>(size),
+        frame_out - frame_in));
+
+    int64_t frame = _frame;
+    int inc = Playback::REVERSE == _playback ? -_frame_step : _frame_step;
+
+    for (int i = 0; i < size; ++i)
+    {
+        frame += inc;
+
+        if (frame < frame_in || frame > frame_out)
+        {
+            switch (_loop)
+            {
+                case Playback::LOOP_REPEAT:
+                    frame = Math::wrap(frame, frame_in, frame_out);
+                    break;
+
+                case Playback::LOOP_PING_PONG:
+                    inc = -inc;
+                    frame = Math::clamp(frame + inc * 2, frame_in, frame_out);
+                    break;
+
+                default:
+                    return out;
+            }
+        }
+
+        out += frame;
+    }
+
+    return out;
+}
+
+List<int64_t> Playback_Group::frames_fill() const
+{
+    List<int64_t> out;
+
+    if (_playback != Playback::STOP)
+    {
+        return out;
+    }
+
+    const int64_t frame_in = _in_out ? frame_min() : 0;
+    const int64_t frame_out = _in_out ? frame_max() : seq_max(_seq);
+
+    const int64_t frame = Math::clamp(_frame, frame_in, frame_out);
+
+    out.reserve(static_cast<size_t>(frame_out - frame_in + 1));
+
+    for (int64_t i = frame; i <= frame_out; ++i)
+    {
+        out += i;
+    }
+
+    for (int64_t i = frame_in; i < frame; ++i)
+    {
+        out += i;
+    }
+
+    return out;
+}
+
 void Playback_Group::layout(Playback::LAYOUT in)
 {
     if (in == _layout)
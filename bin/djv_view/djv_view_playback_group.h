@@ -136,6 +136,18 @@ public:
 
     void cached_frames(const List<int64_t> &);
 
+    //! Get the frames that will be played after the current frame, following
+    //! the playback direction and loop mode. When frames are being skipped to
+    //! keep up with the playback speed they are skipped here too. An empty
+    //! list is returned when playback is stopped.
+
+    List<int64_t> frames_ahead(int size) const;
+
+    //! Get the frames in the in/out range, starting with the current frame
+    //! and wrapping around. An empty list is returned during playback.
+
+    List<int64_t> frames_fill() const;
+
     //! This signal is emitted when an image update is needed.
 
     Signal<bool> image_signal;
@@ -265,6 +277,8 @@ private:
     Timer                    _speed_timer;
     uint64_t                 _idle_frame;
     uint64_t                 _speed_counter;
+    uint64_t                 _speed_ticks;
+    int                      _frame_step;
     Playback::LAYOUT         _layout;
     Menu *                   _menu;
     List<int>                _menu_loop;
@@ -1416,6 +1416,11 @@ void Window::image_update()
 
     _image_p = _file->get(_playback->frame());
 
+    _file->read_ahead(
+        _playback->frames_ahead(File_Prefs::global()->read_ahead()));
+
+    _file->cache_fill_frames(_playback->frames_fill());
+
     if (_image_p)
     {
         //DJV_DEBUG_PRINT("image = " << *_image_p);
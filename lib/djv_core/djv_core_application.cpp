@@ -34,12 +34,16 @@
 #include <djv_core_application.h>
 
 #include <djv_file.h>
+#include <djv_file_io.h>
+#include <djv_file_prefetch.h>
 #include <djv_gl_context.h>
 #include <djv_gl_image.h>
 #include <djv_image_io.h>
 #include <djv_math.h>
 #include <djv_memory.h>
+#include <djv_memory_pool.h>
 #include <djv_system.h>
+#include <djv_thread_pool.h>
 
 #include <FL/Fl.H>
 
@@ -172,9 +176,22 @@ Core_Application::Core_Application(
     //DJV_DEBUG_PRINT("path = " << _path);
     //DJV_DEBUG_PRINT("path doc = " << _path_doc);
 
-    // Create the default OpenGL context.
+    // Create the global thread pool before any other threads are started.
 
-    _context = Gl_Context_Factory::create();
+    Thread_Pool::global();
+
+    // Create the default OpenGL context. If a context cannot be created,
+    // for example on a machine without a display, images are processed with
+    // the CPU instead.
+
+    try
+    {
+        _context = Gl_Context_Factory::create();
+    }
+    catch (Error)
+    {
+        Gl_Image::default_backend = Gl_Image::BACKEND_CPU;
+    }
 
     //! Initialize the FLTK visual.
 
@@ -252,13 +269,18 @@ const String label_info =
 "     System:      %%\n"
 "     Information: %%\n"
 "     Endian:      %%\n"
+"     Threads:     %%\n"
+"     Frame Pool:  %%\n"
+"     Memory:      %%\n"
+"     Prefetch:    %%\n"
 "     Search Path: %%\n"
 "\n"
 " OpenGL\n"
 "\n"
-"     Vendor:   %%\n"
-"     Renderer: %%\n"
-"     Version:  %%\n"
+"     Vendor:        %%\n"
+"     Renderer:      %%\n"
+"     Version:       %%\n"
+"     Image Backend: %%\n"
 "\n"
 " Image I/O Plugins\n"
 "\n"
@@ -266,19 +288,55 @@ const String label_info =
 "     Load: %%\n"
 "     Save: %%\n";
 
+const String label_info_frame_pool =
+    "%% used, %% cached, %% hits, %% misses";
+
+const String label_info_memory =
+    "%% and larger, huge pages = %%, NUMA = %%, %% nodes";
+
+const String label_info_prefetch =
+    "%% files, %% read, %% of %% resident when opened";
+
+// There is no OpenGL context when images are processed with the CPU backend.
+
+const String label_info_none = "None";
+
 } // namespace
 
 String Core_Application::info() const
 {
+    const Memory_Pool::Stats stats = Memory_Pool::global()->stats();
+
+    const Memory::Policy policy = Memory::policy();
+
+    const File_Prefetch::Stats prefetch = File_Prefetch::global()->stats();
+
     return String_Format(label_info).
         arg(DJV_VERSION_NAME).
         arg(DJV_SYSTEM_NAME).
         arg(System::info()).
         arg(String_Util::label(Memory::endian())).
+        arg(Thread_Pool::global()->thread_count()).
+        arg(String_Format(label_info_frame_pool).
+            arg(File_Util::label_size(stats.used)).
+            arg(File_Util::label_size(stats.resident)).
+            arg(static_cast<int>(stats.hits)).
+            arg(static_cast<int>(stats.misses))).
+        arg(String_Format(label_info_memory).
+            arg(File_Util::label_size(policy.large_size)).
+            arg(String_Util::lower(String_Util::label(policy.huge_pages))).
+            arg(String_Util::lower(String_Util::label(policy.numa))).
+            arg(Memory::numa_nodes())).
+        arg(String_Format(label_info_prefetch).
+            arg(static_cast<int>(prefetch.files)).
+            arg(File_Util::label_size(prefetch.bytes)).
+            arg(File_Util::label_size(prefetch.resident)).
+            arg(File_Util::label_size(prefetch.total))).
         arg(System::search_path(), ", ").
-        arg(_context->vendor()).
-        arg(_context->renderer()).
-        arg(_context->version()).
+        arg(_context ? _context->vendor() : label_info_none).
+        arg(_context ? _context->renderer() : label_info_none).
+        arg(_context ? _context->version() : label_info_none).
+        arg(String_Util::label(Gl_Image::default_backend)).
         arg(Image_Io_Base_Factory::global()->names(), ", ").
         arg(Image_Load_Factory::global()->names(), ", ").
         arg(Image_Save_Factory::global()->names(), ", ");
@@ -446,6 +504,18 @@ void Core_Application::command_line(String & in) throw (Error)
                 in >> value;
                 Gl_Image_Filter::default_filter = value;
             }
+            else if ("-render_backend" == arg)
+            {
+                Gl_Image::BACKEND value = static_cast<Gl_Image::BACKEND>(0);
+                in >> value;
+
+                // The OpenGL backend needs a context.
+
+                if (_context)
+                {
+                    Gl_Image::default_backend = value;
+                }
+            }
 
             // Image I/O options.
 
@@ -560,6 +630,75 @@ void Core_Application::command_line(String & in) throw (Error)
                 in >> value;
                 Speed::default_fps = value;
             }
+            else if ("-threads" == arg)
+            {
+                int value = 0;
+                in >> value;
+                Thread_Pool::global()->thread_count(value);
+            }
+            else if ("-frame_pool" == arg)
+            {
+                int value = 0;
+                in >> value;
+                Memory_Pool::global()->max_bytes(
+                    Math::max(value, 0) * Memory::megabyte);
+            }
+            else if ("-prefetch_threads" == arg)
+            {
+                int value = 0;
+                in >> value;
+                File_Prefetch::global()->threads(value);
+            }
+            else if ("-read_stream" == arg)
+            {
+                bool value = false;
+                in >> value;
+                File_Io::default_stream = value;
+            }
+            else if ("-read_populate" == arg)
+            {
+                bool value = false;
+                in >> value;
+                File_Io::default_populate = value;
+            }
+            else if ("-read_recycle" == arg)
+            {
+                int value = 0;
+                in >> value;
+                File_Io::mmap_recycle(Math::max(value, 0));
+            }
+            else if ("-memory_large" == arg)
+            {
+                int value = 0;
+                in >> value;
+                Memory::Policy policy = Memory::policy();
+                policy.large_size = Math::max(value, 0) * Memory::megabyte;
+                Memory::policy(policy);
+            }
+            else if ("-memory_huge_pages" == arg)
+            {
+                bool value = false;
+                in >> value;
+                Memory::Policy policy = Memory::policy();
+                policy.huge_pages = value;
+                Memory::policy(policy);
+            }
+            else if ("-memory_numa" == arg)
+            {
+                Memory::NUMA value = Memory::NUMA(0);
+                in >> value;
+                Memory::Policy policy = Memory::policy();
+                policy.numa = value;
+                Memory::policy(policy);
+            }
+            else if ("-memory_numa_node" == arg)
+            {
+                int value = 0;
+                in >> value;
+                Memory::Policy policy = Memory::policy();
+                policy.numa_node = value;
+                Memory::policy(policy);
+            }
 
             else if ("-help" == arg || "-h" == arg)
             {
@@ -619,6 +758,9 @@ const String label_command_line_help =
 "     -render_filter (minify) (magnify)\n"
 "         Set the render filter. Options = %%. Default = %%, %%.\n"
 "\n"
+"     -render_backend (value)\n"
+"         Set the render backend. Options = %%. Default = %%.\n"
+"\n"
 " Image I/O Options\n"
 "\n"
 "     -base (plugin) (option) (default)\n"
@@ -640,6 +782,47 @@ const String label_command_line_help =
 "     -default_speed (value)\n"
 "         Set the default speed. Options = %%. Default = %%.\n"
 "\n"
+"     -threads (value)\n"
+"         Set the number of threads used for image processing. Default = %%.\n"
+"\n"
+"     -frame_pool (value)\n"
+"         Set the amount of memory in megabytes that is kept for re-use by\n"
+"         image frames. Default = %%.\n"
+"\n"
+"     -prefetch_threads (value)\n"
+"         Set the number of files that are read into the cache at the same\n"
+"         time ahead of loading. Default = %%.\n"
+"\n"
+"     -read_stream (value)\n"
+"         Set whether files are streamed instead of memory-mapped, so that\n"
+"         large frames do not fill the operating system cache. Options = %%.\n"
+"         Default = %%.\n"
+"\n"
+"     -read_populate (value)\n"
+"         Set whether memory-mapped files are made resident when they are\n"
+"         opened. Options = %%. Default = %%.\n"
+"\n"
+"     -read_recycle (value)\n"
+"         Set the number of memory-mapped files that are kept after they are\n"
+"         closed, so they can be re-used if opened again. Default = %%.\n"
+"\n"
+"     -memory_large (value)\n"
+"         Set the size in megabytes of large buffers such as image frames,\n"
+"         which are aligned for huge pages and placed on a NUMA node. Zero\n"
+"         disables. Default = %%.\n"
+"\n"
+"     -memory_huge_pages (value)\n"
+"         Set whether large buffers use huge pages. Options = %%.\n"
+"         Default = %%.\n"
+"\n"
+"     -memory_numa (value)\n"
+"         Set the NUMA placement of large buffers. Options = %%.\n"
+"         Default = %%.\n"
+"\n"
+"     -memory_numa_node (value)\n"
+"         Set the NUMA node used by the \"node\" placement. The default is the\n"
+"         node of the main thread.\n"
+"\n"
 "     -help, -h\n"
 "         Show the help message.\n"
 "\n"
@@ -660,10 +843,29 @@ String Core_Application::command_line_help() const
             String_Util::label(Gl_Image_Filter::default_filter.min))).
         arg(String_Util::lower(
             String_Util::label(Gl_Image_Filter::default_filter.mag))).
+        arg(String_Util::lower(Gl_Image::label_backend()), ", ").
+        arg(String_Util::lower(String_Util::label(Gl_Image::default_backend))).
         arg(String_Util::lower(Time::label_units()), ", ").
         arg(String_Util::lower(String_Util::label(Time::default_units))).
         arg(String_Util::lower(Speed::label_fps()), ", ").
-        arg(String_Util::lower(String_Util::label(Speed::default_fps)));
+        arg(String_Util::lower(String_Util::label(Speed::default_fps))).
+        arg(Thread_Pool::default_thread_count()).
+        arg(static_cast<int>(
+            Memory_Pool::default_max_bytes / Memory::megabyte)).
+        arg(File_Prefetch::default_threads).
+        arg(String_Util::lower(String_Util::label_bool()), ", ").
+        arg(String_Util::lower(String_Util::label(File_Io::default_stream))).
+        arg(String_Util::lower(String_Util::label_bool()), ", ").
+        arg(String_Util::lower(
+            String_Util::label(File_Io::default_populate))).
+        arg(static_cast<int>(File_Io::default_mmap_recycle)).
+        arg(static_cast<int>(
+            Memory::Policy().large_size / Memory::megabyte)).
+        arg(String_Util::lower(String_Util::label_bool()), ", ").
+        arg(String_Util::lower(
+            String_Util::label(Memory::Policy().huge_pages))).
+        arg(String_Util::lower(Memory::label_numa()), ", ").
+        arg(String_Util::lower(String_Util::label(Memory::Policy().numa)));
 }
 
 const String Core_Application::error_command_line =
@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_cpu_private.h
+
+#ifndef DJV_CPU_PRIVATE_H
+#define DJV_CPU_PRIVATE_H
+
+#include <djv_type.h>
+
+// The SIMD kernels are compiled with function target attributes and chosen at
+// run-time, so they don't require any special compiler flags. The intrinsics
+// can only be used in target functions with GCC 4.9 or later.
+
+#if (defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(_MSC_VER) || defined(__clang__) || __GNUC__ > 4 || \
+        (4 == __GNUC__ && __GNUC_MINOR__ >= 9))
+#define DJV_CPU_SIMD
+#endif
+
+#if defined(DJV_CPU_SIMD)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define DJV_CPU_TARGET(ISA) __attribute__((target(ISA)))
+#else
+#define DJV_CPU_TARGET(ISA)
+#endif
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \struct Cpu
+//!
+//! This struct provides the instruction sets supported by the current CPU.
+//------------------------------------------------------------------------------
+
+struct Cpu
+{
+    //! Constructor.
+
+    inline Cpu();
+
+    bool sse2;
+    bool ssse3;
+    bool avx2;
+    bool f16c;
+
+    //! Get the features of the current CPU.
+
+    static inline const Cpu & global();
+
+private:
+
+#if defined(DJV_CPU_SIMD)
+
+    static inline void cpuid(uint32_t leaf, uint32_t * out);
+
+    static inline uint64_t xgetbv();
+
+#endif // DJV_CPU_SIMD
+};
+
+//------------------------------------------------------------------------------
+
+inline Cpu::Cpu() :
+    sse2 (false),
+    ssse3(false),
+    avx2 (false),
+    f16c (false)
+{
+#if defined(DJV_CPU_SIMD)
+
+    uint32_t r [4] = { 0, 0, 0, 0 };
+
+    cpuid(0, r);
+
+    const uint32_t leaf_max = r[0];
+
+    cpuid(1, r);
+
+    sse2  = (r[3] & (1 << 26)) != 0;
+    ssse3 = (r[2] & (1 <<  9)) != 0;
+
+    // AVX registers also need operating system support.
+
+    const bool avx =
+        (r[2] & (1 << 27)) != 0 &&
+        (r[2] & (1 << 28)) != 0 &&
+        (xgetbv() & 6) == 6;
+
+    f16c = avx && (r[2] & (1 << 29)) != 0;
+
+    if (leaf_max >= 7)
+    {
+        cpuid(7, r);
+
+        avx2 = avx && (r[1] & (1 << 5)) != 0;
+    }
+
+#endif // DJV_CPU_SIMD
+}
+
+inline const Cpu & Cpu::global()
+{
+    static const Cpu data;
+
+    return data;
+}
+
+#if defined(DJV_CPU_SIMD)
+
+inline void Cpu::cpuid(uint32_t leaf, uint32_t * out)
+{
+#if defined(_MSC_VER)
+    int tmp [4];
+    __cpuidex(tmp, leaf, 0);
+    for (int i = 0; i < 4; ++i)
+        out[i] = tmp[i];
+#else
+    __cpuid_count(leaf, 0, out[0], out[1], out[2], out[3]);
+#endif
+}
+
+inline uint64_t Cpu::xgetbv()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t a = 0, d = 0;
+    __asm__ ("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+    return (static_cast<uint64_t>(d) << 32) | a;
+#endif
+}
+
+#endif // DJV_CPU_SIMD
+
+} // djv
+
+#endif // DJV_CPU_PRIVATE_H
@@ -0,0 +1,503 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_batch.cpp
+
+#include <djv_file_batch.h>
+
+#include <djv_math.h>
+
+#include <vector>
+
+#if defined(DJV_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#endif // DJV_IO_URING
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// File_Batch::Ring
+//------------------------------------------------------------------------------
+
+#if defined(DJV_IO_URING)
+
+struct File_Batch::Ring
+{
+    Ring() :
+        fd       (-1),
+        sq_ptr   (MAP_FAILED),
+        sq_size  (0),
+        cq_ptr   (MAP_FAILED),
+        cq_size  (0),
+        sqes     (0),
+        sqes_size(0)
+    {}
+
+    ~Ring()
+    {
+        if (sqes)
+        {
+            ::munmap(sqes, sqes_size);
+        }
+
+        if (cq_ptr != MAP_FAILED)
+        {
+            ::munmap(cq_ptr, cq_size);
+        }
+
+        if (sq_ptr != MAP_FAILED)
+        {
+            ::munmap(sq_ptr, sq_size);
+        }
+
+        if (fd != -1)
+        {
+            ::close(fd);
+        }
+    }
+
+    bool init();
+
+    // Run a list of operations and get their results. The operations are
+    // submitted as fast as the ring allows and then waited on together.
+
+    bool run(const std::vector<io_uring_sqe> &, std::vector<int> & results);
+
+    int             fd;
+    void *          sq_ptr;
+    size_t          sq_size;
+    void *          cq_ptr;
+    size_t          cq_size;
+    io_uring_sqe *  sqes;
+    size_t          sqes_size;
+    unsigned        sq_entries;
+    unsigned        cq_entries;
+    unsigned *      sq_head;
+    unsigned *      sq_tail;
+    unsigned *      sq_mask;
+    unsigned *      sq_array;
+    unsigned *      cq_head;
+    unsigned *      cq_tail;
+    unsigned *      cq_mask;
+    io_uring_cqe *  cqes;
+};
+
+bool File_Batch::Ring::init()
+{
+    //DJV_DEBUG("File_Batch::Ring::init");
+
+    static const unsigned entries = 256;
+
+    io_uring_params params;
+    ::memset(&params, 0, sizeof(io_uring_params));
+
+    fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+
+    if (-1 == fd)
+    {
+        return false;
+    }
+
+    sq_entries = params.sq_entries;
+    cq_entries = params.cq_entries;
+
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    sq_ptr = ::mmap(
+        0, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+        IORING_OFF_SQ_RING);
+    cq_ptr = ::mmap(
+        0, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+        IORING_OFF_CQ_RING);
+
+    void * p = ::mmap(
+        0, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+        IORING_OFF_SQES);
+
+    if (MAP_FAILED == sq_ptr || MAP_FAILED == cq_ptr || MAP_FAILED == p)
+    {
+        return false;
+    }
+
+    sqes = reinterpret_cast<io_uring_sqe *>(p);
+
+    uint8_t * sq = reinterpret_cast<uint8_t *>(sq_ptr);
+    uint8_t * cq = reinterpret_cast<uint8_t *>(cq_ptr);
+
+    sq_head  = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail  = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask  = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head  = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail  = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask  = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes     = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    return true;
+}
+
+bool File_Batch::Ring::run(
+    const std::vector<io_uring_sqe> & in,
+    std::vector<int> &                results)
+{
+    //DJV_DEBUG("File_Batch::Ring::run");
+    //DJV_DEBUG_PRINT("size = " << static_cast<int>(in.size()));
+
+    results.resize(in.size());
+
+    size_t submitted = 0;
+    size_t completed = 0;
+
+    while (completed < in.size())
+    {
+        // Queue as many operations as will fit without overflowing the
+        // completion queue.
+
+        unsigned tail = *sq_tail;
+
+        const unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+
+        while (
+            submitted < in.size() &&
+            tail - head < sq_entries &&
+            submitted - completed < cq_entries)
+        {
+            const unsigned index = tail & *sq_mask;
+
+            sqes[index] = in[submitted];
+            sqes[index].user_data = submitted;
+            sq_array[index] = index;
+
+            ++tail;
+            ++submitted;
+        }
+
+        __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+        const unsigned pending =
+            tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+
+        const long r = ::syscall(
+            __NR_io_uring_enter, fd, pending, 1, IORING_ENTER_GETEVENTS, 0, 0);
+
+        if (-1 == r && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            return false;
+        }
+
+        // Collect the results.
+
+        unsigned cq = *cq_head;
+
+        const unsigned end = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+        for (; cq != end; ++cq)
+        {
+            const io_uring_cqe & cqe = cqes[cq & *cq_mask];
+
+            results[static_cast<size_t>(cqe.user_data)] = cqe.res;
+
+            ++completed;
+        }
+
+        __atomic_store_n(cq_head, cq, __ATOMIC_RELEASE);
+    }
+
+    return true;
+}
+
+#else // DJV_IO_URING
+
+struct File_Batch::Ring
+{
+    bool init() { return false; }
+};
+
+#endif // DJV_IO_URING
+
+//------------------------------------------------------------------------------
+// File_Batch
+//------------------------------------------------------------------------------
+
+File_Batch * File_Batch::_global = 0;
+
+File_Batch::File_Batch() :
+    _ring(0),
+    _init(false)
+{}
+
+File_Batch::~File_Batch()
+{
+    delete _ring;
+}
+
+bool File_Batch::read(const List<String> & in)
+{
+    //DJV_DEBUG("File_Batch::read");
+    //DJV_DEBUG_PRINT("in = " << in);
+
+    clear();
+
+    Mutex_Scope scope(_ring_mutex);
+
+    if (! init())
+    {
+        return false;
+    }
+
+#if defined(DJV_IO_URING)
+
+    const size_t size = in.size();
+
+    std::vector<io_uring_sqe> ops;
+    std::vector<int> results;
+
+    // Open the files and get their sizes.
+
+    std::vector<struct statx> stats(size);
+
+    ops.resize(size * 2);
+    ::memset(&ops[0], 0, ops.size() * sizeof(io_uring_sqe));
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        io_uring_sqe & open = ops[i * 2];
+        open.opcode = IORING_OP_OPENAT;
+        open.fd = AT_FDCWD;
+        open.addr = reinterpret_cast<uint64_t>(in[i].c_str());
+        open.open_flags = O_RDONLY;
+
+        io_uring_sqe & stat = ops[i * 2 + 1];
+        stat.opcode = IORING_OP_STATX;
+        stat.fd = AT_FDCWD;
+        stat.addr = reinterpret_cast<uint64_t>(in[i].c_str());
+        stat.len = STATX_SIZE;
+        stat.off = reinterpret_cast<uint64_t>(&stats[i]);
+    }
+
+    if (! _ring->run(ops, results))
+    {
+        return false;
+    }
+
+    std::vector<int> fds(size, -1);
+
+    File_Map files;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        fds[i] = results[i * 2];
+
+        if (fds[i] >= 0 && 0 == results[i * 2 + 1] && stats[i].stx_size > 0)
+        {
+            Memory_Buffer<uint8_t> & buffer = files[in[i]];
+            buffer.tag(Memory::TAG_FILE);
+            buffer.size(static_cast<size_t>(stats[i].stx_size));
+        }
+    }
+
+    // Read the files. Large files are split into several reads.
+
+    static const size_t chunk = 64 * 1024 * 1024;
+
+    ops.clear();
+
+    std::vector<size_t> ops_file;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const File_Map::iterator file = files.find(in[i]);
+
+        if (file == files.end())
+            continue;
+
+        Memory_Buffer<uint8_t> & buffer = file->second;
+
+        for (size_t j = 0; j < buffer.size(); j += chunk)
+        {
+            io_uring_sqe read;
+            ::memset(&read, 0, sizeof(io_uring_sqe));
+            read.opcode = IORING_OP_READ;
+            read.fd = fds[i];
+            read.addr = reinterpret_cast<uint64_t>(buffer() + j);
+            read.len = static_cast<uint32_t>(
+                Math::min(chunk, buffer.size() - j));
+            read.off = j;
+
+            ops.push_back(read);
+            ops_file.push_back(i);
+        }
+    }
+
+    const bool ok = _ring->run(ops, results);
+
+    // Discard the files that were not read completely.
+
+    for (size_t i = 0; i < ops.size(); ++i)
+    {
+        if (! ok || results[i] != static_cast<int>(ops[i].len))
+        {
+            files.erase(in[ops_file[i]]);
+        }
+    }
+
+    // Close the files.
+
+    ops.clear();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (fds[i] >= 0)
+        {
+            io_uring_sqe close;
+            ::memset(&close, 0, sizeof(io_uring_sqe));
+            close.opcode = IORING_OP_CLOSE;
+            close.fd = fds[i];
+
+            ops.push_back(close);
+        }
+    }
+
+    if (! _ring->run(ops, results))
+    {
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            ::close(ops[i].fd);
+        }
+    }
+
+    // Add the files to the batch.
+
+    Mutex_Scope files_scope(_mutex);
+
+    for (File_Map::iterator i = files.begin(); i != files.end(); ++i)
+    {
+        _files[i->first].swap(i->second);
+    }
+
+    //DJV_DEBUG_PRINT("files = " << static_cast<int>(_files.size()));
+
+    return true;
+
+#else // DJV_IO_URING
+
+    return false;
+
+#endif // DJV_IO_URING
+}
+
+void File_Batch::clear()
+{
+    Mutex_Scope scope(_mutex);
+
+    _files.clear();
+}
+
+bool File_Batch::available()
+{
+    Mutex_Scope scope(_ring_mutex);
+
+    return init();
+}
+
+bool File_Batch::init()
+{
+    if (! _init)
+    {
+        _init = true;
+
+        _ring = new Ring;
+
+        if (! _ring->init())
+        {
+            delete _ring;
+
+            _ring = 0;
+        }
+    }
+
+    return _ring != 0;
+}
+
+size_t File_Batch::size() const
+{
+    Mutex_Scope scope(_mutex);
+
+    return _files.size();
+}
+
+bool File_Batch::take(const String & file_name, Memory_Buffer<uint8_t> & out)
+{
+    File_Batch * batch = _global;
+
+    if (! batch)
+    {
+        return false;
+    }
+
+    Mutex_Scope scope(batch->_mutex);
+
+    const File_Map::iterator i = batch->_files.find(file_name);
+
+    if (i == batch->_files.end())
+    {
+        return false;
+    }
+
+    out.swap(i->second);
+
+    batch->_files.erase(i);
+
+    return true;
+}
+
+File_Batch * File_Batch::global()
+{
+    if (! _global)
+    {
+        _global = new File_Batch;
+    }
+
+    return _global;
+}
+
+} // djv
+
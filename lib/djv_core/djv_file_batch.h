@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_batch.h
+
+#ifndef DJV_FILE_BATCH_H
+#define DJV_FILE_BATCH_H
+
+#include <djv_memory_buffer.h>
+#include <djv_string.h>
+#include <djv_thread.h>
+
+#include <map>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \class File_Batch
+//!
+//! This class reads a batch of files into memory with a few system calls,
+//! instead of opening, memory-mapping, and closing each file in turn. The
+//! opens, reads, and closes for the whole batch are submitted together with
+//! the Linux io_uring interface.
+//!
+//! When File_Io opens a file that is in the batch it uses the contents from
+//! memory instead of reading the file again. Batch reads are not available
+//! on other platforms or when the kernel does not support io_uring; in that
+//! case read() returns false and files are opened as usual.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT File_Batch
+{
+public:
+
+    //! Constructor.
+
+    File_Batch();
+
+    //! Destructor.
+
+    ~File_Batch();
+
+    //! Read a batch of files. Files from the previous batch that were not
+    //! opened are discarded, and files that cannot be read are skipped.
+    //! Returns false if batch reads are not available.
+
+    bool read(const List<String> &);
+
+    //! Discard the batch.
+
+    void clear();
+
+    //! Get whether batch reads are available.
+
+    bool available();
+
+    //! Get the number of files in the batch.
+
+    size_t size() const;
+
+    //! Take the contents of a file from the batch. Returns false if the file
+    //! is not in the batch. This is called by File_Io when opening a file.
+
+    static bool take(const String & file_name, Memory_Buffer<uint8_t> &);
+
+    //! Get the global batch.
+
+    static File_Batch * global();
+
+private:
+
+    struct Ring;
+
+    typedef std::map<String, Memory_Buffer<uint8_t> > File_Map;
+
+    bool init();
+
+    File_Batch(const File_Batch &);
+    File_Batch & operator = (const File_Batch &);
+
+    Ring *        _ring;
+    bool          _init;
+    Mutex         _ring_mutex;
+    File_Map      _files;
+    mutable Mutex _mutex;
+
+    static File_Batch * _global;
+};
+
+} // djv
+
+#endif // DJV_FILE_BATCH_H
+
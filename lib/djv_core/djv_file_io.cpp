@@ -37,8 +37,13 @@
 
 #include <djv_assert.h>
 #include <djv_file.h>
+#include <djv_file_batch.h>
+#include <djv_file_prefetch.h>
+#include <djv_file_scanner.h>
+#include <djv_math.h>
 #include <djv_memory.h>
 #include <djv_memory_buffer.h>
+#include <djv_thread.h>
 
 #if defined(DJV_MMAP)
 #if ! defined(DJV_WINDOWS)
@@ -50,6 +55,7 @@
 #else // DJV_WINDOWS
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 #endif // DJV_WINDOWS
@@ -57,6 +63,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <list>
+
 namespace djv
 {
 
@@ -75,6 +83,171 @@ const String
     error_write = "Error writing file: %%",
     error_position = "Cannot set file position: %%";
 
+#if defined(DJV_MMAP) && (defined(DJV_WINDOWS) || ! defined(MAP_POPULATE))
+
+// Touch each page of a memory-map so that it is resident.
+
+void populate_pages(const uint8_t * in, size_t size)
+{
+    static const size_t page = 4096;
+
+    const volatile uint8_t * p = in;
+
+    for (size_t i = 0; i < size; i += page)
+    {
+        p[i];
+    }
+}
+
+#endif
+
+#if defined(DJV_MMAP) && ! defined(DJV_WINDOWS)
+
+// Get the file times in nanoseconds, since a file can be written more than
+// once a second.
+
+int64_t stat_time(const struct timespec & in)
+{
+    return static_cast<int64_t>(in.tv_sec) * 1000000000 + in.tv_nsec;
+}
+
+#if defined(DJV_OSX)
+#define _STAT_MTIME(in) stat_time((in).st_mtimespec)
+#define _STAT_CTIME(in) stat_time((in).st_ctimespec)
+#else
+#define _STAT_MTIME(in) stat_time((in).st_mtim)
+#define _STAT_CTIME(in) stat_time((in).st_ctim)
+#endif
+
+// This class keeps the memory-maps of closed files. A memory-map is re-used
+// when the same file is opened again, as long as the file has not been
+// replaced or modified in the meantime.
+
+class Mmap_Pool
+{
+public:
+
+    struct Mmap
+    {
+        String   file_name;
+        uint64_t dev;
+        uint64_t ino;
+        int64_t  time;
+        int64_t  ctime;
+        size_t   size;
+        void *   p;
+    };
+
+    Mmap_Pool() :
+        _max(File_Io::default_mmap_recycle)
+    {}
+
+    void * take(const Mmap & in)
+    {
+        Mutex_Scope scope(_mutex);
+
+        for (std::list<Mmap>::iterator i = _list.begin(); i != _list.end(); ++i)
+        {
+            if (i->file_name == in.file_name)
+            {
+                void * out = 0;
+
+                if (i->dev == in.dev &&
+                    i->ino == in.ino &&
+                    i->time == in.time &&
+                    i->ctime == in.ctime &&
+                    i->size == in.size)
+                {
+                    out = i->p;
+                }
+                else
+                {
+                    ::munmap((char *)i->p, i->size);
+
+                    Memory::stats_add(
+                        Memory::TAG_MMAP,
+                        -static_cast<int64_t>(i->size));
+                }
+
+                _list.erase(i);
+
+                return out;
+            }
+        }
+
+        return 0;
+    }
+
+    bool add(const Mmap & in)
+    {
+        Mutex_Scope scope(_mutex);
+
+        if (! _max)
+        {
+            return false;
+        }
+
+        for (std::list<Mmap>::iterator i = _list.begin(); i != _list.end(); ++i)
+        {
+            if (i->file_name == in.file_name)
+            {
+                return false;
+            }
+        }
+
+        _list.push_front(in);
+
+        trim();
+
+        return true;
+    }
+
+    void max(size_t in)
+    {
+        Mutex_Scope scope(_mutex);
+
+        _max = in;
+
+        trim();
+    }
+
+    size_t max() const
+    {
+        Mutex_Scope scope(_mutex);
+
+        return _max;
+    }
+
+private:
+
+    void trim()
+    {
+        while (_list.size() > _max)
+        {
+            ::munmap((char *)_list.back().p, _list.back().size);
+
+            Memory::stats_add(
+                Memory::TAG_MMAP,
+                -static_cast<int64_t>(_list.back().size));
+
+            _list.pop_back();
+        }
+    }
+
+    std::list<Mmap> _list;
+    size_t          _max;
+    mutable Mutex   _mutex;
+};
+
+Mmap_Pool * mmap_pool()
+{
+    static Mmap_Pool * data = new Mmap_Pool;
+
+    return data;
+}
+
+#endif // DJV_MMAP && ! DJV_WINDOWS
+
 } // namespace
 
 File_Io::File_Io() :
@@ -85,7 +258,15 @@ File_Io::File_Io() :
     _mode(MODE(0)),
     _size(0),
     _endian(false),
-    _mmap(0), _mmap_start(0), _mmap_end(0), _mmap_p(0)
+    _mmap(0), _mmap_start(0), _mmap_end(0), _mmap_p(0),
+    _write_size(0),
+    _stream(default_stream),
+    _populate(default_populate),
+    _mmap_recycle(false),
+    _mmap_dev(0),
+    _mmap_ino(0),
+    _mmap_time(0),
+    _mmap_ctime(0)
 
 #else // DJV_WINDOWS
 
@@ -93,11 +274,21 @@ File_Io::File_Io() :
     _mode(MODE(0)),
     _size(0),
     _endian(false),
-    _mmap((void *) - 1), _mmap_start(0), _mmap_end(0), _mmap_p(0)
+    _mmap((void *) - 1), _mmap_start(0), _mmap_end(0), _mmap_p(0),
+    _write_size(0),
+    _stream(default_stream),
+    _populate(default_populate),
+    _mmap_recycle(false),
+    _mmap_dev(0),
+    _mmap_ino(0),
+    _mmap_time(0),
+    _mmap_ctime(0)
 
 #endif // DJV_WINDOWS
 
-{}
+{
+    _stream_buffer.tag(Memory::TAG_FILE);
+}
 
 File_Io::~File_Io()
 {
@@ -112,6 +303,62 @@ void File_Io::open(const String & file_name, MODE mode) throw (Error)
 
     close();
 
+#if defined(DJV_MMAP) && ! defined(DJV_WINDOWS)
+
+    // Use the contents of the file if it was read as part of a batch.
+
+    if (READ == mode && File_Batch::take(file_name, _stream_buffer))
+    {
+        _file_name = file_name;
+        _size = _stream_buffer.size();
+        _mode = mode;
+
+        _mmap_start = _stream_buffer();
+        _mmap_end = _mmap_start + _size;
+        _mmap_p = _mmap_start;
+
+        return;
+    }
+
+    // Re-use the memory-map of a recently closed file.
+
+    _mmap_recycle = false;
+
+    struct stat info;
+
+    if (READ == mode && ! _stream && 0 == ::stat(file_name.c_str(), &info))
+    {
+        _mmap_recycle = true;
+        _mmap_dev = info.st_dev;
+        _mmap_ino = info.st_ino;
+        _mmap_time = _STAT_MTIME(info);
+        _mmap_ctime = _STAT_CTIME(info);
+
+        Mmap_Pool::Mmap mmap;
+        mmap.file_name = file_name;
+        mmap.dev = _mmap_dev;
+        mmap.ino = _mmap_ino;
+        mmap.time = _mmap_time;
+        mmap.ctime = _mmap_ctime;
+        mmap.size = static_cast<size_t>(info.st_size);
+
+        if (void * p = mmap_pool()->take(mmap))
+        {
+            _file_name = file_name;
+            _size = mmap.size;
+            _mode = mode;
+
+            _mmap = p;
+            _mmap_start = reinterpret_cast<const uint8_t *>(_mmap);
+            _mmap_end = _mmap_start + _size;
+            _mmap_p = _mmap_start;
+
+            return;
+        }
+    }
+
+#endif
+
     // Open file.
 
 #if defined(DJV_WINDOWS)
@@ -135,8 +382,11 @@ void File_Io::open(const String & file_name, MODE mode) throw (Error)
 #else // DJV_WINDOWS
 
     int read_flag = 0;
-#if defined(DJV_LINUX)
-    //read_flag = O_DIRECT;
+#if defined(DJV_LINUX) && defined(DJV_MMAP)
+    if (_stream)
+    {
+        read_flag = O_DIRECT;
+    }
 #endif
 
     _f = ::open(
@@ -146,6 +396,15 @@ void File_Io::open(const String & file_name, MODE mode) throw (Error)
              (WRITE == mode) ?
              (S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) : (0));
 
+    // Not all file systems support direct I/O.
+
+    if (-1 == _f && READ == mode && read_flag)
+    {
+        read_flag = 0;
+
+        _f = ::open(file_name.c_str(), O_RDONLY);
+    }
+
     if (-1 == _f)
     {
         throw Error(error, String_Format(error_open).arg(file_name));
@@ -172,6 +431,17 @@ void File_Io::open(const String & file_name, MODE mode) throw (Error)
 
 #if defined(DJV_MMAP)
 
+#if defined(DJV_LINUX)
+
+    if (READ == _mode && _stream)
+    {
+        stream_read(read_flag != 0);
+
+        return;
+    }
+
+#endif // DJV_LINUX
+
     if (READ == _mode)
     {
         //DJV_DEBUG_PRINT("mmap");
@@ -193,22 +463,51 @@ void File_Io::open(const String & file_name, MODE mode) throw (Error)
             throw Error(error, String_Format(error_mmap).arg(_file_name));
         }
 
+        Memory::stats_add(Memory::TAG_MMAP, _size);
+
         _mmap_end = _mmap_start + _size;
         _mmap_p = _mmap_start;
 
+        if (_populate)
+        {
+            populate_pages(_mmap_start, _size);
+        }
+
 #else // DJV_WINDOWS
 
-        _mmap = ::mmap(0, _size, PROT_READ, MAP_SHARED, _f, 0);
+        int flags = MAP_SHARED;
+
+#if defined(MAP_POPULATE)
+        if (_populate)
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+
+        _mmap = ::mmap(0, _size, PROT_READ, flags, _f, 0);
 
         if (_mmap == (void *) - 1)
         {
             throw Error(error, String_Format(error_mmap).arg(_file_name));
         }
 
+        Memory::stats_add(Memory::TAG_MMAP, _size);
+
         _mmap_start = reinterpret_cast<const uint8_t *>(_mmap);
         _mmap_end = _mmap_start + _size;
         _mmap_p = _mmap_start;
 
+        if (_populate)
+        {
+#if ! defined(MAP_POPULATE)
+            populate_pages(_mmap_start, _size);
+#endif
+        }
+        else
+        {
+            File_Prefetch::opened(_file_name, _mmap_start, _size);
+        }
+
 #endif // DJV_WINDOWS
     }
 
@@ -219,15 +518,32 @@ void File_Io::close()
 {
     //DJV_DEBUG("File_Io::close");
 
+    if (WRITE == _mode)
+    {
+        try
+        {
+            flush();
+        }
+        catch (Error)
+        {}
+    }
+
+    _write_size = 0;
+
 #if defined(DJV_MMAP)
 #if defined(DJV_WINDOWS)
 
-    if (_mmap_start != 0)
+    // The start is not a view of the file when streaming.
+
+    if (_mmap_start != 0 && _mmap != 0)
     {
         ::UnmapViewOfFile((void *)_mmap_start);
-        _mmap_start = 0;
+
+        Memory::stats_add(Memory::TAG_MMAP, -static_cast<int64_t>(_size));
     }
 
+    _mmap_start = 0;
+
     if (_mmap != 0)
     {
         ::CloseHandle(_mmap);
@@ -240,16 +556,30 @@ void File_Io::close()
 
     if (_mmap != (void *) - 1)
     {
-        //DJV_DEBUG_PRINT("munmap");
+        Mmap_Pool::Mmap mmap;
+        mmap.file_name = _file_name;
+        mmap.dev = _mmap_dev;
+        mmap.ino = _mmap_ino;
+        mmap.time = _mmap_time;
+        mmap.ctime = _mmap_ctime;
+        mmap.size = _size;
+        mmap.p = _mmap;
+
+        if (! _mmap_recycle || ! mmap_pool()->add(mmap))
+        {
+            //DJV_DEBUG_PRINT("munmap");
 
-        //! \todo Solaris wants (char *)?
+            //! \todo Solaris wants (char *)?
 
-        int r = ::munmap((char *)_mmap, _size);
+            int r = ::munmap((char *)_mmap, _size);
 
-        if (-1 == r)
-        {
-            const String err(::strerror(errno));
-            //DJV_DEBUG_PRINT("errno = " << err);
+            if (-1 == r)
+            {
+                const String err(::strerror(errno));
+                //DJV_DEBUG_PRINT("errno = " << err);
+            }
+
+            Memory::stats_add(Memory::TAG_MMAP, -static_cast<int64_t>(_size));
         }
 
         _mmap = (void *) - 1;
@@ -257,6 +587,8 @@ void File_Io::close()
 
 #endif // DJV_WINDOWS
 
+    _stream_buffer.size(0);
+
     _mmap_end = 0;
     _mmap_p = 0;
 
@@ -295,6 +627,48 @@ void File_Io::close()
     _mode = MODE(0);
 }
 
+void File_Io::stream(bool in)
+{
+    _stream = in;
+}
+
+bool File_Io::stream() const
+{
+    return _stream;
+}
+
+bool File_Io::default_stream = false;
+
+void File_Io::populate(bool in)
+{
+    _populate = in;
+}
+
+bool File_Io::populate() const
+{
+    return _populate;
+}
+
+bool File_Io::default_populate = false;
+
+void File_Io::mmap_recycle(size_t in)
+{
+#if defined(DJV_MMAP) && ! defined(DJV_WINDOWS)
+    mmap_pool()->max(in);
+#endif
+}
+
+size_t File_Io::mmap_recycle()
+{
+#if defined(DJV_MMAP) && ! defined(DJV_WINDOWS)
+    return mmap_pool()->max();
+#else
+    return 0;
+#endif
+}
+
+const size_t File_Io::default_mmap_recycle = 8;
+
 const String & File_Io::file_name() const
 {
     return _file_name;
@@ -302,13 +676,22 @@ const String & File_Io::file_name() const
 
 bool File_Io::is_valid() const
 {
-    return
 #if defined(DJV_WINDOWS)
-        _f != INVALID_HANDLE_VALUE &&
+    bool open = _f != INVALID_HANDLE_VALUE;
 #else
-        _f != -1 &&
+    bool open = _f != -1;
+#endif
+
+#if defined(DJV_MMAP)
+
+    // Files that were read as part of a batch, or that re-use a memory-map,
+    // don't have a file descriptor.
+
+    open |= READ == _mode && _mmap_start != 0;
+
 #endif
-        position() < _size;
+
+    return open && position() < _size;
 }
 
 void File_Io::set(const void * in, size_t size, size_t word_size) throw (Error)
@@ -318,35 +701,78 @@ void File_Io::set(const void * in, size_t size, size_t word_size) throw (Error)
     //DJV_DEBUG_PRINT("word size = " << word_size);
     //DJV_DEBUG_PRINT("endian = " << _endian);
 
-    uint8_t * p = (uint8_t *)in;
+    const bool endian = _endian && word_size > 1;
 
-    Memory_Buffer<uint8_t> tmp;
+    // Large writes that don't need endian conversion are written together
+    // with the buffer in a single call.
 
-    if (_endian && word_size > 1)
+    if (! endian && size * word_size >= write_buffer_size)
     {
-        tmp.size(size * word_size);
-        p = tmp();
-        Memory::endian(in, p, size, word_size);
-    }
+        const size_t write_size = _write_size;
 
-#if defined(DJV_WINDOWS)
-    DWORD n;
+        _write_size = 0;
+
+        write(_write_buffer(), write_size, in, size * word_size);
 
-    if (! ::WriteFile(_f, p, static_cast<DWORD>(size * word_size), &n, 0))
+        return;
+    }
+
+    if (! _write_buffer.size())
     {
-        throw Error(error, String_Format(error_write).arg(_file_name));
+        _write_buffer.size(write_buffer_size);
     }
 
-#else
+    // Copy the data into the buffer, converting the endian in place.
 
-    if (::write(_f, p, size * word_size) == -1)
+    const uint8_t * p = reinterpret_cast<const uint8_t *>(in);
+
+    while (size)
     {
-        throw Error(error, String_Format(error_write).arg(_file_name));
+        if (_write_size + word_size > write_buffer_size)
+        {
+            flush();
+        }
+
+        const size_t count = Math::min(
+            size,
+            (write_buffer_size - _write_size) / word_size);
+
+        const size_t bytes = count * word_size;
+
+        if (endian)
+        {
+            Memory::endian(p, _write_buffer() + _write_size, count, word_size);
+        }
+        else
+        {
+            Memory::copy(p, _write_buffer() + _write_size, bytes);
+        }
+
+        _write_size += bytes;
+
+        p += bytes;
+
+        size -= count;
     }
+}
 
-#endif
+void File_Io::flush() throw (Error)
+{
+    if (! _write_size)
+        return;
+
+    //DJV_DEBUG("File_Io::flush");
+    //DJV_DEBUG_PRINT("size = " << _write_size);
+
+    const size_t write_size = _write_size;
+
+    _write_size = 0;
+
+    write(_write_buffer(), write_size, 0, 0);
 }
 
+const size_t File_Io::write_buffer_size = 1024 * 1024;
+
 void File_Io::set_8(const int8_t * in, size_t size) throw (Error)
 {
     return set(in, size, 1);
@@ -499,6 +925,49 @@ void File_Io::read_ahead()
 #endif // DJV_MMAP
 }
 
+void File_Io::read_ahead(size_t position, size_t size)
+{
+    if (position >= _size)
+        return;
+
+    size = Math::min(size, _size - position);
+
+#if defined(DJV_MMAP)
+
+#if defined(DJV_LINUX)
+
+    // The address must be aligned to a page.
+
+    static const size_t page = ::sysconf(_SC_PAGESIZE);
+
+    const size_t start = position / page * page;
+
+    ::madvise(
+        (void *)(_mmap_start + start),
+        size + position - start,
+        MADV_WILLNEED);
+
+#else
+
+    const uint8_t * p   = _mmap_start + position;
+    const uint8_t * end = p + size;
+
+    for (; p < end; p += Memory::align)
+    {
+        _mmap_read_ahead = *p;
+    }
+
+#endif
+
+#else // DJV_MMAP
+
+#if defined(DJV_LINUX)
+    ::posix_fadvise(_f, position, size, POSIX_FADV_WILLNEED);
+#endif
+
+#endif // DJV_MMAP
+}
+
 void File_Io::position(size_t in) throw (Error)
 {
     position(in, false);
@@ -542,6 +1011,8 @@ void File_Io::position(size_t in, bool seek) throw (Error)
 
         case WRITE:
         {
+            flush();
+
 #if defined(DJV_WINDOWS)
 
             if (! ::SetFilePointer(
@@ -570,6 +1041,165 @@ void File_Io::position(size_t in, bool seek) throw (Error)
     }
 }
 
+void File_Io::write(
+    const void * a,
+    size_t       a_size,
+    const void * b,
+    size_t       b_size) throw (Error)
+{
+    //DJV_DEBUG("File_Io::write");
+    //DJV_DEBUG_PRINT("a = " << a_size);
+    //DJV_DEBUG_PRINT("b = " << b_size);
+
+#if defined(DJV_WINDOWS)
+
+    const void * data [] = { a, b };
+    const size_t size [] = { a_size, b_size };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        DWORD n;
+
+        if (size[i] && ! ::WriteFile(
+            _f,
+            data[i],
+            static_cast<DWORD>(size[i]),
+            &n,
+            0))
+        {
+            throw Error(error, String_Format(error_write).arg(_file_name));
+        }
+    }
+
+#else // DJV_WINDOWS
+
+    // Write both pieces of data with one call, continuing after partial
+    // writes.
+
+    struct iovec iov [2];
+    iov[0].iov_base = const_cast<void *>(a);
+    iov[0].iov_len  = a_size;
+    iov[1].iov_base = const_cast<void *>(b);
+    iov[1].iov_len  = b_size;
+
+    struct iovec * p = iov;
+    int count = 2;
+
+    while (count)
+    {
+        if (! p->iov_len)
+        {
+            ++p;
+            --count;
+
+            continue;
+        }
+
+        const ssize_t r = ::writev(_f, p, count);
+
+        if (-1 == r)
+        {
+            if (EINTR == errno)
+                continue;
+
+            throw Error(error, String_Format(error_write).arg(_file_name));
+        }
+
+        size_t n = static_cast<size_t>(r);
+
+        for (; count && n >= p->iov_len; ++p, --count)
+        {
+            n -= p->iov_len;
+        }
+
+        if (count)
+        {
+            p->iov_base = reinterpret_cast<uint8_t *>(p->iov_base) + n;
+            p->iov_len -= n;
+        }
+    }
+
+#endif // DJV_WINDOWS
+}
+
+void File_Io::stream_read(bool direct) throw (Error)
+{
+    //DJV_DEBUG("File_Io::stream_read");
+    //DJV_DEBUG_PRINT("direct = " << direct);
+
+#if defined(DJV_LINUX)
+
+    // Direct I/O needs the buffer, the file position, and the size of each
+    // read aligned to the block size.
+
+    static const size_t align = 4096;
+    static const size_t chunk = 8 * 1024 * 1024;
+
+    const size_t size = (_size + align - 1) / align * align;
+
+    _stream_buffer.size(size + align);
+
+    uint8_t * p = _stream_buffer() +
+        (align - reinterpret_cast<size_t>(_stream_buffer()) % align) % align;
+
+    size_t position = 0;
+
+    while (position < _size)
+    {
+        const ssize_t r = ::pread(
+            _f,
+            p + position,
+            Math::min(chunk, (direct ? size : _size) - position),
+            position);
+
+        if (-1 == r)
+        {
+            if (EINTR == errno)
+                continue;
+
+            throw Error(error, String_Format(error_read).arg(_file_name));
+        }
+
+        if (0 == r)
+            break;
+
+        // Without direct I/O drop the pages from the cache as we go.
+
+        if (! direct)
+        {
+            ::posix_fadvise(_f, position, r, POSIX_FADV_DONTNEED);
+        }
+
+        position += r;
+
+        // A short direct read leaves the file position unaligned, so the rest
+        // of the file is read without direct I/O.
+
+        if (direct && position < _size && position % align)
+        {
+            const int flags = ::fcntl(_f, F_GETFL);
+
+            if (-1 == flags || -1 == ::fcntl(_f, F_SETFL, flags & ~O_DIRECT))
+            {
+                throw Error(error, String_Format(error_read).arg(_file_name));
+            }
+
+            direct = false;
+        }
+    }
+
+    if (position < _size)
+    {
+        throw Error(error, String_Format(error_read).arg(_file_name));
+    }
+
+    _mmap_start = p;
+    _mmap_end = _mmap_start + _size;
+    _mmap_p = _mmap_start;
+
+#endif // DJV_LINUX
+}
+
 size_t File_Io::position() const
 {
     size_t out = 0;
@@ -591,6 +1221,7 @@ size_t File_Io::position() const
 #else
             out = ::lseek(_f, 0, SEEK_CUR);
 #endif
+            out += _write_size;
             break;
     }
 
@@ -713,11 +1344,14 @@ List<String> File_Io::lines(const String & file_name) throw (Error)
     File_Io io;
     io.open(file_name, File_Io::READ);
 
-    while (io.is_valid())
+    File_Scanner scanner(io);
+
+    const char * p = 0;
+    size_t size = 0;
+
+    while (scanner.line(p, size))
     {
-        char buf [cstring_size] = "";
-        line(io, buf, cstring_size);
-        out += buf;
+        out += String(p, size);
     }
 
     return out;
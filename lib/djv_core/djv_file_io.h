@@ -35,6 +35,7 @@
 #define DJV_FILE_IO_H
 
 #include <djv_error.h>
+#include <djv_memory_buffer.h>
 #include <djv_string.h>
 
 namespace djv
@@ -44,6 +45,21 @@ namespace djv
 //! \class File_Io
 //!
 //! This class provides file I/O.
+//!
+//! Data written to the file is collected in a buffer so that small writes are
+//! merged into larger ones. The buffer is written when it is full, when the
+//! file position is changed, or when flush() or close() is called.
+//!
+//! Files are read with a memory-map by default. Streaming reads the whole
+//! file into a buffer instead, with direct I/O when the file system supports
+//! it, so that reading long sequences once does not push everything else out
+//! of the operating system cache. Streaming is only available on Linux.
+//!
+//! Memory-maps can be populated when the file is opened, so that the pages
+//! are resident before the data is used. This moves the page faults to the
+//! thread that opens the file, instead of the thread that displays the image.
+//! Memory-maps are also kept for a small number of closed files, so that
+//! opening the same file again re-uses the mapping and its resident pages.
 //------------------------------------------------------------------------------
 
 class DJV_CORE_EXPORT File_Io
@@ -70,7 +86,49 @@ public:
 
     void open(const String & file_name, MODE) throw (Error);
 
-    //! Close the file.
+    //! Set whether files are streamed instead of memory-mapped when they are
+    //! opened for reading.
+
+    void stream(bool);
+
+    //! Get whether files are streamed instead of memory-mapped when they are
+    //! opened for reading.
+
+    bool stream() const;
+
+    //! The default for whether files are streamed.
+
+    static bool default_stream;
+
+    //! Set whether memory-maps are populated when files are opened.
+
+    void populate(bool);
+
+    //! Get whether memory-maps are populated when files are opened.
+
+    bool populate() const;
+
+    //! The default for whether memory-maps are populated.
+
+    static bool default_populate;
+
+    //! Set the number of memory-maps that are kept after their files are
+    //! closed.
+
+    static void mmap_recycle(size_t);
+
+    //! Get the number of memory-maps that are kept after their files are
+    //! closed.
+
+    static size_t mmap_recycle();
+
+    //! The default number of memory-maps that are kept after their files are
+    //! closed.
+
+    static const size_t default_mmap_recycle;
+
+    //! Close the file. Errors writing the buffered data are ignored, call
+    //! flush() first to catch them.
 
     void close();
 
@@ -106,6 +164,14 @@ public:
     inline void set_u32(const uint32_t & in) throw (Error);
     inline void set_f32(const float & in) throw (Error);
 
+    //! Write the buffered data to the file.
+
+    void flush() throw (Error);
+
+    //! The size of the write buffer.
+
+    static const size_t write_buffer_size;
+
     //! Get data.
 
     void get(void *, size_t, size_t word_size = 1) throw (Error);
@@ -123,6 +189,10 @@ public:
 
     void read_ahead();
 
+    //! Start an asynchronous read-ahead of part of the file.
+
+    void read_ahead(size_t position, size_t size);
+
     //! Get the current memory-map position.
 
     inline const uint8_t * mmap_p() const;
@@ -153,14 +223,16 @@ public:
 
     inline bool endian() const;
 
-    //! Read a word from a file.
+    //! Read a word from a file. This reads a character at a time; use
+    //! File_Scanner for larger amounts of text.
 
     static void word(
         File_Io &,
         char *,
         int max_len = cstring_size) throw (Error);
 
-    //! Read a line from a file.
+    //! Read a line from a file. This reads a character at a time; use
+    //! File_Scanner for larger amounts of text.
 
     static void line(
         File_Io &,
@@ -175,6 +247,10 @@ private:
 
     void position(size_t, bool seek) throw (Error);
 
+    void write(const void *, size_t, const void *, size_t) throw (Error);
+
+    void stream_read(bool direct) throw (Error);
+
 #   if defined(DJV_WINDOWS)
     HANDLE          _f;
 #   else
@@ -189,6 +265,17 @@ private:
     const uint8_t * _mmap_end;
     const uint8_t * _mmap_p;
     int             _mmap_read_ahead;
+
+    Memory_Buffer<uint8_t> _write_buffer;
+    size_t                 _write_size;
+    bool                   _stream;
+    Memory_Buffer<uint8_t> _stream_buffer;
+    bool                   _populate;
+    bool                   _mmap_recycle;
+    uint64_t               _mmap_dev;
+    uint64_t               _mmap_ino;
+    int64_t                _mmap_time;
+    int64_t                _mmap_ctime;
 };
 
 } // djv
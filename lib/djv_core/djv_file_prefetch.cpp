@@ -0,0 +1,478 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_prefetch.cpp
+
+#include <djv_file_prefetch.h>
+
+#include <djv_math.h>
+#include <djv_memory_buffer.h>
+
+#if defined(DJV_LINUX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DJV_LINUX
+#include <stdio.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// File_Prefetch::Stats
+//------------------------------------------------------------------------------
+
+File_Prefetch::Stats::Stats() :
+    files   (0),
+    bytes   (0),
+    opened  (0),
+    total   (0),
+    resident(0)
+{}
+
+//------------------------------------------------------------------------------
+// File_Prefetch::Worker
+//------------------------------------------------------------------------------
+
+class File_Prefetch::Worker : public Thread
+{
+public:
+
+    Worker(File_Prefetch * prefetch) :
+        _prefetch(prefetch)
+    {}
+
+protected:
+
+    void run();
+
+private:
+
+    File_Prefetch * _prefetch;
+};
+
+namespace
+{
+
+// The number of prefetched file names that are remembered.
+
+const size_t done_max = 1024;
+
+// The number of seconds a prefetched file is not read again. This stops the
+// same frames being read on every playback update, while files that have
+// been dropped from the operating system cache since, like the frames of a
+// looping sequence that doesn't fit in memory, are read again on the next
+// pass.
+
+const double done_timeout = 1.0;
+
+uint64_t prefetch(const String & file_name)
+{
+    //DJV_DEBUG("prefetch");
+    //DJV_DEBUG_PRINT("file name = " << file_name);
+
+    uint64_t out = 0;
+
+#if defined(DJV_LINUX)
+
+    const int f = ::open(file_name.c_str(), O_RDONLY);
+
+    if (-1 == f)
+    {
+        return 0;
+    }
+
+    struct stat info;
+
+    if (0 == ::fstat(f, &info))
+    {
+        out = info.st_size;
+
+        // This blocks until the file is in the cache.
+
+        ::readahead(f, 0, out);
+    }
+
+    ::close(f);
+
+#else // DJV_LINUX
+
+    FILE * f = ::fopen(file_name.c_str(), "rb");
+
+    if (! f)
+    {
+        return 0;
+    }
+
+    Memory_Buffer<uint8_t> tmp(1024 * 1024);
+
+    size_t size = 0;
+
+    while ((size = ::fread(tmp(), 1, tmp.size(), f)) > 0)
+    {
+        out += size;
+    }
+
+    ::fclose(f);
+
+#endif // DJV_LINUX
+
+    return out;
+}
+
+} // namespace
+
+void File_Prefetch::Worker::run()
+{
+    //DJV_DEBUG("File_Prefetch::Worker::run");
+
+    Mutex_Scope scope(_prefetch->_mutex);
+
+    while (! _prefetch->_stop)
+    {
+        String file_name;
+
+        if (! _prefetch->next(file_name))
+        {
+            _prefetch->_work.wait(_prefetch->_mutex);
+
+            continue;
+        }
+
+        _prefetch->_busy.add(file_name);
+
+        // Read the file without holding the lock.
+
+        _prefetch->_mutex.unlock();
+
+        const uint64_t bytes = prefetch(file_name);
+
+        _prefetch->_mutex.lock();
+
+        _prefetch->_busy.erase(file_name);
+
+        ++_prefetch->_stats.files;
+        _prefetch->_stats.bytes += bytes;
+
+        _prefetch->done(file_name);
+    }
+}
+
+//------------------------------------------------------------------------------
+// File_Prefetch
+//------------------------------------------------------------------------------
+
+const int File_Prefetch::default_threads = 2;
+
+File_Prefetch * File_Prefetch::_global = 0;
+
+namespace
+{
+
+// The global prefetch service is used by File_Io from any thread.
+
+Mutex _global_mutex;
+
+} // namespace
+
+File_Prefetch::File_Prefetch() :
+    _threads(default_threads),
+    _stop   (false)
+{
+    _timer.start();
+}
+
+File_Prefetch::~File_Prefetch()
+{
+    stop();
+}
+
+void File_Prefetch::files(const List<String> & in)
+{
+    //DJV_DEBUG("File_Prefetch::files");
+    //DJV_DEBUG_PRINT("in = " << in);
+
+    if (! _workers.size())
+    {
+        start();
+    }
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        _queue.assign(in.begin(), in.end());
+    }
+
+    _work.broadcast();
+}
+
+void File_Prefetch::seq(const File & file, const List<int64_t> & frames)
+{
+    List<String> tmp;
+
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        tmp += file.get(frames[i]);
+    }
+
+    files(tmp);
+}
+
+void File_Prefetch::clear()
+{
+    Mutex_Scope scope(_mutex);
+
+    _queue.clear();
+}
+
+void File_Prefetch::threads(int in)
+{
+    const int threads = Math::max(in, 1);
+
+    if (threads == _threads)
+        return;
+
+    const bool running = _workers.size() > 0;
+
+    stop();
+
+    _threads = threads;
+
+    if (running)
+    {
+        start();
+    }
+}
+
+int File_Prefetch::threads() const
+{
+    return _threads;
+}
+
+File_Prefetch::Stats File_Prefetch::stats() const
+{
+    Mutex_Scope scope(_mutex);
+
+    return _stats;
+}
+
+void File_Prefetch::stats_reset()
+{
+    Mutex_Scope scope(_mutex);
+
+    _stats = Stats();
+}
+
+void File_Prefetch::opened(
+    const String & file_name,
+    const void *   p,
+    size_t         size)
+{
+    File_Prefetch * prefetch = 0;
+
+    {
+        Mutex_Scope scope(_global_mutex);
+
+        prefetch = _global;
+    }
+
+    if (! prefetch || ! size)
+        return;
+
+    {
+        Mutex_Scope scope(prefetch->_mutex);
+
+        if (prefetch->_done.find(file_name) == prefetch->_done.end())
+            return;
+    }
+
+    //DJV_DEBUG("File_Prefetch::opened");
+    //DJV_DEBUG_PRINT("file name = " << file_name);
+
+    uint64_t resident = 0;
+
+#if defined(DJV_LINUX)
+
+    // Count the pages of the memory-map that are in the cache.
+
+    static const size_t page = ::sysconf(_SC_PAGESIZE);
+
+    Memory_Buffer<unsigned char> pages((size + page - 1) / page);
+
+    if (0 == ::mincore(const_cast<void *>(p), size, pages()))
+    {
+        for (size_t i = 0; i < pages.size(); ++i)
+        {
+            if (pages()[i] & 1)
+            {
+                resident += page;
+            }
+        }
+    }
+
+    resident = Math::min(resident, static_cast<uint64_t>(size));
+
+#endif // DJV_LINUX
+
+    //DJV_DEBUG_PRINT("resident = " << static_cast<int>(resident));
+
+    Mutex_Scope scope(prefetch->_mutex);
+
+    ++prefetch->_stats.opened;
+    prefetch->_stats.total += size;
+    prefetch->_stats.resident += resident;
+}
+
+File_Prefetch * File_Prefetch::global()
+{
+    Mutex_Scope scope(_global_mutex);
+
+    if (! _global)
+    {
+        _global = new File_Prefetch;
+    }
+
+    return _global;
+}
+
+void File_Prefetch::start()
+{
+    //DJV_DEBUG("File_Prefetch::start");
+    //DJV_DEBUG_PRINT("threads = " << _threads);
+
+    _stop = false;
+
+    for (int i = 0; i < _threads; ++i)
+    {
+        Worker * worker = new Worker(this);
+
+        try
+        {
+            worker->start();
+        }
+        catch (const Error &)
+        {
+            delete worker;
+
+            continue;
+        }
+
+        _workers += worker;
+    }
+}
+
+void File_Prefetch::stop()
+{
+    if (! _workers.size())
+        return;
+
+    //DJV_DEBUG("File_Prefetch::stop");
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        _stop = true;
+    }
+
+    _work.broadcast();
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        _workers[i]->wait();
+
+        delete _workers[i];
+    }
+
+    _workers.clear();
+    _stop = false;
+}
+
+bool File_Prefetch::next(String & out)
+{
+    const double now = time();
+
+    while (_queue.size())
+    {
+        out = _queue.front();
+
+        _queue.pop_front();
+
+        if (_busy.find(out) != _busy.end())
+        {
+            continue;
+        }
+
+        const Done_Map::const_iterator i = _done.find(out);
+
+        if (i == _done.end() || now - i->second >= done_timeout)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void File_Prefetch::done(const String & file_name)
+{
+    const double now = time();
+
+    _done[file_name] = now;
+    _done_list.push_back(Done(file_name, now));
+
+    // A file that has been prefetched again has a newer entry, so only the
+    // name of the oldest entry is forgotten.
+
+    if (_done_list.size() > done_max)
+    {
+        const Done & oldest = _done_list.front();
+
+        const Done_Map::iterator i = _done.find(oldest.first);
+
+        if (i != _done.end() && i->second == oldest.second)
+        {
+            _done.erase(i);
+        }
+
+        _done_list.pop_front();
+    }
+}
+
+double File_Prefetch::time()
+{
+    _timer.check();
+
+    return _timer.seconds();
+}
+
+} // djv
+
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_prefetch.h
+
+#ifndef DJV_FILE_PREFETCH_H
+#define DJV_FILE_PREFETCH_H
+
+#include <djv_file.h>
+#include <djv_set.h>
+#include <djv_thread.h>
+#include <djv_timer.h>
+
+#include <deque>
+#include <map>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \class File_Prefetch
+//!
+//! This class provides a service that reads files into the operating system
+//! cache in the background, so that they are ready by the time they are
+//! loaded. This hides the latency of network storage when the files are
+//! known in advance, like the frames of a sequence ahead of the playhead.
+//!
+//! The files are read by a small number of threads so that the storage is
+//! not flooded with requests. A file that was just prefetched is not read
+//! again when it is asked for again shortly after. After that it is read
+//! again, in case the operating system has dropped it from the cache. When a
+//! prefetched file is opened by File_Io the number of bytes that were
+//! already resident is recorded in the statistics.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT File_Prefetch
+{
+public:
+
+    //! Constructor.
+
+    File_Prefetch();
+
+    //! Destructor.
+
+    ~File_Prefetch();
+
+    //! Set the files to prefetch in order of priority. Waiting files that are
+    //! not in the list are dropped.
+
+    void files(const List<String> &);
+
+    //! Set the frames of a file sequence to prefetch in order of priority.
+
+    void seq(const File &, const List<int64_t> & frames);
+
+    //! Drop the waiting files.
+
+    void clear();
+
+    //! Set the number of files that are read at the same time.
+
+    void threads(int);
+
+    //! Get the number of files that are read at the same time.
+
+    int threads() const;
+
+    //! Statistics.
+
+    struct DJV_CORE_EXPORT Stats
+    {
+        Stats();
+
+        uint64_t files;    //!< Files that were prefetched.
+        uint64_t bytes;    //!< Bytes that were prefetched.
+        uint64_t opened;   //!< Prefetched files that were opened.
+        uint64_t total;    //!< Bytes in the prefetched files that were opened.
+        uint64_t resident; //!< Bytes that were resident when opened.
+    };
+
+    //! Get the statistics.
+
+    Stats stats() const;
+
+    //! Reset the statistics.
+
+    void stats_reset();
+
+    //! Record how much of a file was resident when it was opened, if it was
+    //! prefetched. This is called by File_Io with the file's memory-map.
+
+    static void opened(const String & file_name, const void *, size_t);
+
+    //! The default number of files that are read at the same time.
+
+    static const int default_threads;
+
+    //! Get the global prefetch service.
+
+    static File_Prefetch * global();
+
+private:
+
+    class Worker;
+
+    void start();
+    void stop();
+    bool next(String &);
+    void done(const String &);
+    double time();
+
+    File_Prefetch(const File_Prefetch &);
+    File_Prefetch & operator = (const File_Prefetch &);
+
+    typedef std::map<String, double>  Done_Map;
+    typedef std::pair<String, double> Done;
+
+    List<Worker *>     _workers;
+    int                _threads;
+    std::deque<String> _queue;
+    Set<String>        _busy;
+    Done_Map           _done;
+    std::deque<Done>   _done_list;
+    Timer              _timer;
+    Stats              _stats;
+    bool               _stop;
+    mutable Mutex      _mutex;
+    Condition          _work;
+
+    static File_Prefetch * _global;
+
+    friend class Worker;
+};
+
+} // djv
+
+#endif // DJV_FILE_PREFETCH_H
+
@@ -0,0 +1,426 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_scanner.cpp
+
+#include <djv_file_scanner.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// File_Scanner
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+const String
+    error = "I/O",
+    error_end = "Unexpected end of file: %%",
+    error_number = "Cannot read number from file: %%";
+
+inline bool is_space(char in)
+{
+    return ' ' == in || '\t' == in || '\n' == in || '\r' == in || '\0' == in;
+}
+
+inline bool is_digit(char in)
+{
+    return in >= '0' && in <= '9';
+}
+
+// Powers of ten that can be represented exactly as a double.
+
+const double pow10_table [] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int pow10_max = 22;
+
+bool to_float_slow(const char * in, size_t size, double & out)
+{
+    // Fall back to the C library for numbers that cannot be converted exactly
+    // with the fast path.
+
+    const String tmp(in, size);
+    char * end = 0;
+    out = ::strtod(tmp.c_str(), &end);
+
+    return size > 0 && end == tmp.c_str() + size;
+}
+
+} // namespace
+
+File_Scanner::File_Scanner(File_Io & io) throw (Error) :
+    _io      (io),
+    _position(io.position()),
+    _start   (0),
+    _end     (0),
+    _p       (0)
+{
+    //DJV_DEBUG("File_Scanner::File_Scanner");
+
+    if (io.mmap_p())
+    {
+        _start = reinterpret_cast<const char *>(io.mmap_p());
+        _end   = reinterpret_cast<const char *>(io.mmap_end());
+    }
+    else
+    {
+        // The file is not memory-mapped, so read the rest of it.
+
+        const size_t size = io.size() > _position ? io.size() - _position : 0;
+
+        _buffer.size(size);
+
+        if (size)
+        {
+            io.get(_buffer(), size);
+        }
+
+        _start = reinterpret_cast<const char *>(_buffer());
+        _end   = _start + size;
+    }
+
+    _p = _start;
+}
+
+File_Scanner::~File_Scanner()
+{
+    try
+    {
+        _io.position(_position + (_p - _start));
+    }
+    catch (Error)
+    {}
+}
+
+void File_Scanner::skip()
+{
+    while (_p < _end)
+    {
+        if (is_space(*_p))
+        {
+            ++_p;
+        }
+        else if ('#' == *_p)
+        {
+            while (_p < _end && *_p != '\n' && *_p != '\r')
+            {
+                ++_p;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+bool File_Scanner::word(const char *& out, size_t & size)
+{
+    skip();
+
+    if (_p == _end)
+    {
+        return false;
+    }
+
+    const char * p = _p;
+
+    while (_p < _end && ! is_space(*_p) && *_p != '#')
+    {
+        ++_p;
+    }
+
+    out  = p;
+    size = _p - p;
+
+    // Consume the character that ends the word like File_Io::word() does,
+    // so binary data that follows a header starts at the right position.
+
+    if (_p < _end && is_space(*_p))
+    {
+        ++_p;
+    }
+
+    return true;
+}
+
+String File_Scanner::word() throw (Error)
+{
+    const char * p = 0;
+    size_t size = 0;
+
+    if (! word(p, size))
+    {
+        throw Error(error, String_Format(error_end).arg(_io.file_name()));
+    }
+
+    return String(p, size);
+}
+
+int64_t File_Scanner::word_int() throw (Error)
+{
+    const char * p = 0;
+    size_t size = 0;
+
+    if (! word(p, size))
+    {
+        throw Error(error, String_Format(error_end).arg(_io.file_name()));
+    }
+
+    int64_t out = 0;
+
+    if (! to_int(p, size, out))
+    {
+        throw Error(error, String_Format(error_number).arg(_io.file_name()));
+    }
+
+    return out;
+}
+
+double File_Scanner::word_float() throw (Error)
+{
+    const char * p = 0;
+    size_t size = 0;
+
+    if (! word(p, size))
+    {
+        throw Error(error, String_Format(error_end).arg(_io.file_name()));
+    }
+
+    double out = 0.0;
+
+    if (! to_float(p, size, out))
+    {
+        throw Error(error, String_Format(error_number).arg(_io.file_name()));
+    }
+
+    return out;
+}
+
+bool File_Scanner::line(const char *& out, size_t & size)
+{
+    if (_p == _end)
+    {
+        return false;
+    }
+
+    const char * p = _p;
+
+    while (_p < _end && *_p != '\n' && *_p != '\r')
+    {
+        ++_p;
+    }
+
+    out  = p;
+    size = _p - p;
+
+    // Consume the line ending, treating "\r\n" as a single ending.
+
+    if (_p < _end)
+    {
+        if ('\r' == *_p++ && _p < _end && '\n' == *_p)
+        {
+            ++_p;
+        }
+    }
+
+    return true;
+}
+
+String File_Scanner::line() throw (Error)
+{
+    const char * p = 0;
+    size_t size = 0;
+
+    if (! line(p, size))
+    {
+        throw Error(error, String_Format(error_end).arg(_io.file_name()));
+    }
+
+    return String(p, size);
+}
+
+bool File_Scanner::to_int(const char * in, size_t size, int64_t & out)
+{
+    const char * const end = in + size;
+
+    bool negative = false;
+
+    if (in < end && ('-' == *in || '+' == *in))
+    {
+        negative = '-' == *in++;
+    }
+
+    // Up to 18 digits always fit in a 64-bit integer.
+
+    if (in == end || end - in > 18)
+    {
+        return false;
+    }
+
+    int64_t tmp = 0;
+
+    for (; in < end; ++in)
+    {
+        if (! is_digit(*in))
+        {
+            return false;
+        }
+
+        tmp = tmp * 10 + (*in - '0');
+    }
+
+    out = negative ? -tmp : tmp;
+
+    return true;
+}
+
+bool File_Scanner::to_float(const char * in, size_t size, double & out)
+{
+    const char * const start = in;
+    const char * const end = in + size;
+
+    bool negative = false;
+
+    if (in < end && ('-' == *in || '+' == *in))
+    {
+        negative = '-' == *in++;
+    }
+
+    // Accumulate the significant digits and the decimal exponent.
+
+    uint64_t mantissa = 0;
+    int      digits   = 0;
+    int      exponent = 0;
+    bool     any      = false;
+
+    for (; in < end && is_digit(*in); ++in, any = true)
+    {
+        if (mantissa || *in != '0')
+        {
+            mantissa = mantissa * 10 + (*in - '0');
+            ++digits;
+        }
+    }
+
+    if (in < end && '.' == *in)
+    {
+        for (++in; in < end && is_digit(*in); ++in, any = true)
+        {
+            if (mantissa || *in != '0')
+            {
+                mantissa = mantissa * 10 + (*in - '0');
+                ++digits;
+            }
+
+            --exponent;
+        }
+    }
+
+    if (! any)
+    {
+        // Handle special values such as "inf" and "nan".
+
+        return to_float_slow(start, size, out);
+    }
+
+    if (in < end && ('e' == *in || 'E' == *in))
+    {
+        ++in;
+
+        bool exponent_negative = false;
+
+        if (in < end && ('-' == *in || '+' == *in))
+        {
+            exponent_negative = '-' == *in++;
+        }
+
+        if (in == end)
+        {
+            return false;
+        }
+
+        int tmp = 0;
+
+        for (; in < end && is_digit(*in); ++in)
+        {
+            if (tmp < 100000)
+            {
+                tmp = tmp * 10 + (*in - '0');
+            }
+        }
+
+        exponent += exponent_negative ? -tmp : tmp;
+    }
+
+    if (in != end)
+    {
+        return false;
+    }
+
+    // When the mantissa and the power of ten are both exact the result is
+    // correctly rounded with a single multiply or divide.
+
+    if (
+        digits <= 15 &&
+        exponent >= -pow10_max &&
+        exponent <=  pow10_max)
+    {
+        double tmp = static_cast<double>(mantissa);
+
+        if (exponent < 0)
+        {
+            tmp /= pow10_table[-exponent];
+        }
+        else
+        {
+            tmp *= pow10_table[exponent];
+        }
+
+        out = negative ? -tmp : tmp;
+
+        return true;
+    }
+
+    return to_float_slow(start, size, out);
+}
+
+} // djv
+
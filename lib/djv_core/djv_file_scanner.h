@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_scanner.h
+
+#ifndef DJV_FILE_SCANNER_H
+#define DJV_FILE_SCANNER_H
+
+#include <djv_file_io.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \class File_Scanner
+//!
+//! This class provides a tokenizer for reading text from a file. Words and
+//! lines are returned as pointers into the file's memory-map instead of
+//! being copied one character at a time, which makes it much faster than
+//! File_Io::word() and File_Io::line() for large text files.
+//!
+//! Words are separated by whitespace, and comments start with a '#' and run
+//! to the end of the line. Files that are not memory-mapped are read into
+//! memory from the current position when the scanner is created.
+//!
+//! The file position is updated when the scanner is destroyed so that
+//! binary data following the text can be read with File_Io.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT File_Scanner
+{
+public:
+
+    //! Constructor. Scanning starts at the current file position.
+
+    File_Scanner(File_Io &) throw (Error);
+
+    //! Destructor.
+
+    ~File_Scanner();
+
+    //! Get whether there is more data.
+
+    inline bool is_valid() const;
+
+    //! Get the next word. The word is not null-terminated and is only valid
+    //! while the file is open. Returns false if there are no more words.
+
+    bool word(const char *&, size_t &);
+
+    //! Get the next word.
+
+    String word() throw (Error);
+
+    //! Get the next word as an integer.
+
+    int64_t word_int() throw (Error);
+
+    //! Get the next word as a floating-point number.
+
+    double word_float() throw (Error);
+
+    //! Get the next line, not including the line ending. The line is not
+    //! null-terminated and is only valid while the file is open. Returns
+    //! false if there are no more lines.
+
+    bool line(const char *&, size_t &);
+
+    //! Get the next line.
+
+    String line() throw (Error);
+
+    //! Parse an integer. Returns false if the text is not an integer.
+
+    static bool to_int(const char *, size_t, int64_t &);
+
+    //! Parse a floating-point number. Returns false if the text is not a
+    //! number.
+
+    static bool to_float(const char *, size_t, double &);
+
+private:
+
+    void skip();
+
+    File_Scanner(const File_Scanner &);
+    File_Scanner & operator = (const File_Scanner &);
+
+    File_Io &              _io;
+    size_t                 _position;
+    Memory_Buffer<uint8_t> _buffer;
+    const char *           _start;
+    const char *           _end;
+    const char *           _p;
+};
+
+} // djv
+
+#include <djv_file_scanner_inline.h>
+
+#endif // DJV_FILE_SCANNER_H
+
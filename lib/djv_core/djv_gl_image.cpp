@@ -34,6 +34,7 @@
 #include <djv_gl_image.h>
 
 #include <djv_gl_offscreen_buffer.h>
+#include <djv_thread_pool.h>
 
 namespace djv
 {
@@ -133,7 +134,9 @@ Pixel_Data Gl_Image_Levels::color_lut(
     const Gl_Image_Levels & in,
     double soft_clip)
 {
-    Pixel_Data out(Pixel_Data_Info(V2i(1024, 1), Pixel::L_F32));
+    Pixel_Data out;
+    out.memory_tag(Memory::TAG_LUT);
+    out.set(Pixel_Data_Info(V2i(1024, 1), Pixel::L_F32));
 
     const double in_tmp = in.in_high - in.in_low;
     const double gamma = 1.0 / in.gamma;
@@ -285,13 +288,27 @@ void Gl_Image::read(Pixel_Data & output, const Box2i & area)
             break;
     }
 
-    state_pack(info, area.position);
+    if (state_pack(info, area.position))
+    {
+        DJV_DEBUG_GL(glReadPixels(
+            0, 0, area.w, area.h,
+            Gl_Util::format(info.pixel, info.bgr),
+            Gl_Util::type(info.pixel),
+            output.data()));
+    }
+    else
+    {
+        state_pack(info);
 
-    DJV_DEBUG_GL(glReadPixels(
-        0, 0, area.w, area.h,
-        Gl_Util::format(info.pixel, info.bgr),
-        Gl_Util::type(info.pixel),
-        output.data()));
+        for (int y = 0; y < area.h; ++y)
+        {
+            DJV_DEBUG_GL(glReadPixels(
+                0, y, area.w, 1,
+                Gl_Util::format(info.pixel, info.bgr),
+                Gl_Util::type(info.pixel),
+                output.data(area.x, area.y + y)));
+        }
+    }
 
     //stateReset();
 
@@ -310,6 +327,13 @@ void Gl_Image::copy(
     //DJV_DEBUG_PRINT("output = " << output);
     //DJV_DEBUG_PRINT("scale = " << options.xform.scale);
 
+    if (BACKEND_CPU == default_backend)
+    {
+        copy_cpu(input, output, options);
+
+        return;
+    }
+
     const V2i & size = output.info().size;
 
     std::auto_ptr<Gl_Offscreen_Buffer> _buffer;
@@ -368,22 +392,77 @@ void Gl_Image::copy(
     }
 }
 
-void Gl_Image::state_unpack(const Pixel_Data_Info & in, const V2i & offset)
+namespace
+{
+
+// OpenGL only supports alignments of up to eight bytes, so a wider scanline
+// alignment is described with a row length instead. A row length of zero
+// means the scanlines are the width of the image.
+
+bool row_layout(const Pixel_Data_Info & in, GLint & alignment, GLint & row)
+{
+    alignment = Math::max(in.align, 1);
+    row       = 0;
+
+    if (alignment <= 8)
+    {
+        return true;
+    }
+
+    const size_t bytes_pixel    = Pixel::bytes(in.pixel);
+    const size_t bytes_scanline = Pixel_Data::bytes_scanline(in);
+    const size_t padding        = bytes_scanline % bytes_pixel;
+
+    // The scanline is a multiple of the alignment, so when it isn't a whole
+    // number of pixels an alignment of eight covers the remainder as long
+    // as it is less than eight bytes.
+
+    alignment = padding ? 8 : 1;
+    row       = static_cast<GLint>(bytes_scanline / bytes_pixel);
+
+    if (padding >= static_cast<size_t>(alignment))
+    {
+        alignment = 1;
+        row       = 0;
+
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool Gl_Image::state_unpack(const Pixel_Data_Info & in, const V2i & offset)
 {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, in.align);
+    GLint alignment = 1;
+    GLint row       = 0;
+
+    const bool out = row_layout(in, alignment, row);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
     glPixelStorei(GL_UNPACK_SWAP_BYTES, in.endian != Memory::endian());
-    //glPixelStorei(GL_UNPACK_ROW_LENGTH, in.data_window.w);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, row);
     glPixelStorei(GL_UNPACK_SKIP_ROWS, offset.y);
     glPixelStorei(GL_UNPACK_SKIP_PIXELS, offset.x);
+
+    return out;
 }
 
-void Gl_Image::state_pack(const Pixel_Data_Info & in, const V2i & offset)
+bool Gl_Image::state_pack(const Pixel_Data_Info & in, const V2i & offset)
 {
-    glPixelStorei(GL_PACK_ALIGNMENT, in.align);
+    GLint alignment = 1;
+    GLint row       = 0;
+
+    const bool out = row_layout(in, alignment, row);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, alignment);
     glPixelStorei(GL_PACK_SWAP_BYTES, in.endian != Memory::endian());
-    glPixelStorei(GL_PACK_ROW_LENGTH, in.size.x);
+    glPixelStorei(GL_PACK_ROW_LENGTH, row ? row : in.size.x);
     glPixelStorei(GL_PACK_SKIP_ROWS, offset.y);
     glPixelStorei(GL_PACK_SKIP_PIXELS, offset.x);
+
+    return out;
 }
 
 void Gl_Image::state_reset()
@@ -399,6 +478,102 @@ void Gl_Image::state_reset()
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 }
 
+namespace
+{
+
+// The average is calculated in parallel; each range of scanlines is
+// accumulated separately and then added to the total.
+
+template<typename T>
+class Average : public Thread_Range
+{
+public:
+
+    Average(const Pixel_Data & in, double * accum) :
+        _in      (in),
+        _w       (in.w()),
+        _area    (static_cast<double>(in.w()) * in.h()),
+        _channels(in.channels()),
+        _accum   (accum)
+    {
+        for (int c = 0; c < _channels; ++c)
+        {
+            _accum[c] = 0.0;
+        }
+    }
+
+    void run(int begin, int end)
+    {
+        double accum [Pixel::channels_max];
+
+        for (int c = 0; c < _channels; ++c)
+        {
+            accum[c] = 0.0;
+        }
+
+        for (int y = begin; y < end; ++y)
+        {
+            const T * p = reinterpret_cast<const T *>(_in.data(0, y));
+
+            for (int x = 0; x < _w; ++x, p += _channels)
+                for (int c = 0; c < _channels; ++c)
+                    accum[c] += p[c] / _area;
+        }
+
+        Mutex_Scope scope(_mutex);
+
+        for (int c = 0; c < _channels; ++c)
+        {
+            _accum[c] += accum[c];
+        }
+    }
+
+private:
+
+    const Pixel_Data & _in;
+    int                _w;
+    double             _area;
+    int                _channels;
+    double *           _accum;
+    Mutex              _mutex;
+};
+
+template<>
+void Average<Pixel::U10_S>::run(int begin, int end)
+{
+    double accum [3] = { 0.0, 0.0, 0.0 };
+
+    for (int y = begin; y < end; ++y)
+    {
+        const Pixel::U10_S * p =
+            reinterpret_cast<const Pixel::U10_S *>(_in.data(0, y));
+
+        for (int x = 0; x < _w; ++x, ++p)
+        {
+            accum[0] += p->r / _area;
+            accum[1] += p->g / _area;
+            accum[2] += p->b / _area;
+        }
+    }
+
+    Mutex_Scope scope(_mutex);
+
+    for (int c = 0; c < 3; ++c)
+    {
+        _accum[c] += accum[c];
+    }
+}
+
+template<typename T>
+inline void average(const Pixel_Data & in, double * accum)
+{
+    Average<T> fnc(in, accum);
+
+    Thread_Pool::global()->parallel_for(0, in.h(), fnc, 16);
+}
+
+} // namespace
+
 void Gl_Image::average(
     const Pixel_Data & in,
     Color *            out) throw (Error)
@@ -414,6 +589,7 @@ void Gl_Image::average(
     const Pixel_Data * data = &in;
     Pixel_Data tmp;
     Pixel_Data_Info info(in.size(), in.pixel());
+    info.align = in.info().align;
 
     if (in.info() != info)
     {
@@ -422,29 +598,15 @@ void Gl_Image::average(
         data = &tmp;
     }
 
-    const int w = info.size.x, h = info.size.y;
-    const double area = w * h;
     const int channels = Pixel::channels(info.pixel);
 
+    double accum [Pixel::channels_max];
+
     switch (Pixel::type(info.pixel))
     {
-
-#define _AVERAGE(TYPE) \
-    \
-    const Pixel::TYPE * p = reinterpret_cast< \
-        const Pixel::TYPE *>(data->data()); \
-    \
-    double accum [Pixel::channels_max]; \
-    \
-    for (int c = 0; c < channels; ++c) accum[c] = 0.0; \
-        for (int y = 0; y < h; ++y) \
-            for (int x = 0; x < w; ++x, p += channels) \
-                for (int c = 0; c < channels; ++c) \
-                    accum[c] += p[c] / area;
-
         case Pixel::U8:
         {
-            _AVERAGE(U8_T)
+            djv::average<Pixel::U8_T>(*data, accum);
 
             for (int c = 0; c < channels; ++c)
             {
@@ -455,7 +617,7 @@ void Gl_Image::average(
 
         case Pixel::U16:
         {
-            _AVERAGE(U16_T)
+            djv::average<Pixel::U16_T>(*data, accum);
 
             for (int c = 0; c < channels; ++c)
             {
@@ -466,7 +628,7 @@ void Gl_Image::average(
 
         case Pixel::F16:
         {
-            _AVERAGE(F16_T)
+            djv::average<Pixel::F16_T>(*data, accum);
 
             for (int c = 0; c < channels; ++c)
             {
@@ -477,7 +639,7 @@ void Gl_Image::average(
 
         case Pixel::F32:
         {
-            _AVERAGE(F32_T)
+            djv::average<Pixel::F32_T>(*data, accum);
 
             for (int c = 0; c < channels; ++c)
             {
@@ -488,21 +650,8 @@ void Gl_Image::average(
 
         case Pixel::U10:
         {
-            const Pixel::U10_S * p =
-                reinterpret_cast <const Pixel::U10_S * > (data->data());
-            
-            double accum [3] = { 0.0, 0.0, 0.0 };
+            djv::average<Pixel::U10_S>(*data, accum);
 
-            for (int y = 0; y < h; ++y)
-            {
-                for (int x = 0; x < w; ++x, ++p)
-                {
-                    accum[0] += p->r / area;
-                    accum[1] += p->g / area;
-                    accum[2] += p->b / area;
-                }
-            }
-            
             for (int c = 0; c < 3; ++c)
             {
                 out->set_u10(static_cast<int>(accum[c]), c);
@@ -554,6 +703,235 @@ int shift_16(Gl_Image::HISTOGRAM in)
     return 0;
 }
 
+inline Pixel::U16_T to_u16(Pixel::U8_T in)
+{
+    return PIXEL_U8_TO_U16(in);
+}
+
+inline Pixel::U16_T to_u16(Pixel::U16_T in)
+{
+    return PIXEL_U16_TO_U16(in);
+}
+
+inline Pixel::U16_T to_u16(Pixel::F16_T in)
+{
+    return PIXEL_F16_TO_U16(in);
+}
+
+inline Pixel::U16_T to_u16(Pixel::F32_T in)
+{
+    return PIXEL_F32_TO_U16(in);
+}
+
+// The histogram is calculated in parallel; each range of scanlines is
+// counted separately and then added to the output.
+
+template<typename T>
+class Histogram : public Thread_Range
+{
+public:
+
+    Histogram(
+        const Pixel_Data & in,
+        Pixel_Data *       out,
+        int                shift,
+        Color *            min,
+        Color *            max) :
+        _in      (in),
+        _w       (in.w()),
+        _channels(in.channels()),
+        _size    (out->w()),
+        _shift   (shift),
+        _out_p   (reinterpret_cast<Pixel::U16_T *>(out->data())),
+        _min_p   (reinterpret_cast<T *>(min->data())),
+        _max_p   (reinterpret_cast<T *>(max->data()))
+    {
+        if (_w && in.h())
+        {
+            const T * in_p = reinterpret_cast<const T *>(in.data());
+
+            for (int c = 0; c < _channels; ++c)
+            {
+                _min_p[c] = _max_p[c] = in_p[c];
+            }
+        }
+    }
+
+    void run(int begin, int end)
+    {
+        if (! _w)
+            return;
+
+        List<uint32_t> count(0, _size * 3);
+
+        T min [Pixel::channels_max];
+        T max [Pixel::channels_max];
+
+        const T * in_p = reinterpret_cast<const T *>(_in.data(0, begin));
+
+        for (int c = 0; c < _channels; ++c)
+        {
+            min[c] = max[c] = in_p[c];
+        }
+
+        for (int y = begin; y < end; ++y)
+        {
+            in_p = reinterpret_cast<const T *>(_in.data(0, y));
+
+            const T * const in_end = in_p + _w * _channels;
+
+            for (; in_p < in_end; in_p += _channels)
+                switch (_channels)
+                {
+                    case 4:
+                        min[3] = Math::min(in_p[3], min[3]);
+                        max[3] = Math::max(in_p[3], max[3]);
+                    case 3:
+                        count[(to_u16(in_p[2]) >> _shift) * 3 + 2]++;
+                        min[2] = Math::min(in_p[2], min[2]);
+                        max[2] = Math::max(in_p[2], max[2]);
+                    case 2:
+                        count[(to_u16(in_p[1]) >> _shift) * 3 + 1]++;
+                        min[1] = Math::min(in_p[1], min[1]);
+                        max[1] = Math::max(in_p[1], max[1]);
+                    case 1:
+                        count[(to_u16(in_p[0]) >> _shift) * 3 + 0]++;
+                        min[0] = Math::min(in_p[0], min[0]);
+                        max[0] = Math::max(in_p[0], max[0]);
+                        break;
+                }
+        }
+
+        Mutex_Scope scope(_mutex);
+
+        for (int i = 0; i < _size * 3; ++i)
+        {
+            _out_p[i] += count[i];
+        }
+
+        for (int c = 0; c < _channels; ++c)
+        {
+            _min_p[c] = Math::min(min[c], _min_p[c]);
+            _max_p[c] = Math::max(max[c], _max_p[c]);
+        }
+    }
+
+private:
+
+    const Pixel_Data & _in;
+    int                _w;
+    int                _channels;
+    int                _size;
+    int                _shift;
+    Pixel::U16_T *     _out_p;
+    T *                _min_p;
+    T *                _max_p;
+    Mutex              _mutex;
+};
+
+class Histogram_U10 : public Thread_Range
+{
+public:
+
+    Histogram_U10(
+        const Pixel_Data & in,
+        Pixel_Data *       out,
+        int                shift,
+        Color *            min,
+        Color *            max) :
+        _in   (in),
+        _w    (in.w()),
+        _size (out->w()),
+        _shift(shift),
+        _out_p(reinterpret_cast<Pixel::U16_T *>(out->data())),
+        _min_p(reinterpret_cast<Pixel::U10_S *>(min->data())),
+        _max_p(reinterpret_cast<Pixel::U10_S *>(max->data()))
+    {
+        if (_w && in.h())
+        {
+            const Pixel::U10_S * in_p =
+                reinterpret_cast<const Pixel::U10_S *>(in.data());
+
+            _min_p->r = _max_p->r = in_p->r;
+            _min_p->g = _max_p->g = in_p->g;
+            _min_p->b = _max_p->b = in_p->b;
+        }
+    }
+
+    void run(int begin, int end)
+    {
+        if (! _w)
+            return;
+
+        List<uint32_t> count(0, _size * 3);
+
+        const Pixel::U10_S * in_p =
+            reinterpret_cast<const Pixel::U10_S *>(_in.data(0, begin));
+
+        Pixel::U10_S min = *in_p;
+        Pixel::U10_S max = *in_p;
+
+        for (int y = begin; y < end; ++y)
+        {
+            in_p = reinterpret_cast<const Pixel::U10_S *>(_in.data(0, y));
+
+            const Pixel::U10_S * const in_end = in_p + _w;
+
+            for (; in_p < in_end; ++in_p)
+            {
+                count[(in_p->r >> _shift) * 3 + 0]++;
+                count[(in_p->g >> _shift) * 3 + 1]++;
+                count[(in_p->b >> _shift) * 3 + 2]++;
+
+                min.r = Math::min(in_p->r, min.r);
+                min.g = Math::min(in_p->g, min.g);
+                min.b = Math::min(in_p->b, min.b);
+                max.r = Math::max(in_p->r, max.r);
+                max.g = Math::max(in_p->g, max.g);
+                max.b = Math::max(in_p->b, max.b);
+            }
+        }
+
+        Mutex_Scope scope(_mutex);
+
+        for (int i = 0; i < _size * 3; ++i)
+        {
+            _out_p[i] += count[i];
+        }
+
+        _min_p->r = Math::min(min.r, _min_p->r);
+        _min_p->g = Math::min(min.g, _min_p->g);
+        _min_p->b = Math::min(min.b, _min_p->b);
+        _max_p->r = Math::max(max.r, _max_p->r);
+        _max_p->g = Math::max(max.g, _max_p->g);
+        _max_p->b = Math::max(max.b, _max_p->b);
+    }
+
+private:
+
+    const Pixel_Data & _in;
+    int                _w;
+    int                _size;
+    int                _shift;
+    Pixel::U16_T *     _out_p;
+    Pixel::U10_S *     _min_p;
+    Pixel::U10_S *     _max_p;
+    Mutex              _mutex;
+};
+
+template<typename T>
+inline void histogram(
+    const Pixel_Data & in,
+    Pixel_Data *       out,
+    int                shift,
+    Color *            min,
+    Color *            max)
+{
+    T fnc(in, out, shift, min, max);
+
+    Thread_Pool::global()->parallel_for(0, in.h(), fnc, 16);
+}
+
 } // namespace
 
 void Gl_Image::histogram(
@@ -578,6 +956,7 @@ void Gl_Image::histogram(
     const Pixel_Data * data = &in;
     Pixel_Data tmp;
     Pixel_Data_Info info(in.size(), in.pixel());
+    info.align = in.info().align;
 
     if (in.info() != info)
     {
@@ -588,127 +967,54 @@ void Gl_Image::histogram(
     *min = Color(info.pixel);
     *max = Color(info.pixel);
 
-    const int w = info.size.x, h = info.size.y;
-    const int channels = Pixel::channels(info.pixel);
-
     switch (info.pixel)
     {
         case Pixel::RGB_U10:
-        {
-            const Pixel::U10_S * in_p =
-                reinterpret_cast<const Pixel::U10_S *>(data->data());
-            const Pixel::U10_S * const end = in_p + w * h;
-            Pixel::U16_T * const out_p =
-                reinterpret_cast<Pixel::U16_T *>(out->data());
-            Pixel::U10_S * const min_p =
-                reinterpret_cast<Pixel::U10_S *>(min->data());
-            Pixel::U10_S * const max_p =
-                reinterpret_cast<Pixel::U10_S *>(max->data());
-
-            if (w && h)
-            {
-                min_p->r = max_p->r = in_p->r;
-                min_p->g = max_p->g = in_p->g;
-                min_p->b = max_p->b = in_p->b;
-            }
-
-            const int shift = shift_10(histogram);
-
-            for (; in_p < end; ++in_p)
-            {
-                out_p[(in_p->r >> shift) * 3 + 0]++;
-                out_p[(in_p->g >> shift) * 3 + 1]++;
-                out_p[(in_p->b >> shift) * 3 + 2]++;
-
-                min_p->r = Math::min(in_p->r, min_p->r);
-                min_p->g = Math::min(in_p->g, min_p->g);
-                min_p->b = Math::min(in_p->b, min_p->b);
-                max_p->r = Math::max(in_p->r, max_p->r);
-                max_p->g = Math::max(in_p->g, max_p->g);
-                max_p->b = Math::max(in_p->b, max_p->b);
-            }
 
-        }
-        break;
+            djv::histogram<Histogram_U10>(
+                *data, out, shift_10(histogram), min, max);
 
-#define _HISTOGRAM(TYPE) \
-    \
-    const Pixel::TYPE##_T * in_p = \
-        reinterpret_cast<const Pixel::TYPE##_T *>(data->data()); \
-    \
-    const Pixel::TYPE##_T * const end = in_p + w * h * channels; \
-    \
-    Pixel::U16_T * const out_p = \
-        reinterpret_cast<Pixel::U16_T *>(out->data()); \
-    \
-    Pixel::TYPE##_T * const min_p = \
-        reinterpret_cast<Pixel::TYPE##_T *>(min->data()); \
-    \
-    Pixel::TYPE##_T * const max_p = \
-        reinterpret_cast<Pixel::TYPE##_T *>(max->data()); \
-    \
-    if (w && h) \
-        for (int c = 0; c < channels; ++c) \
-            min_p[c] = max_p[c] = in_p[c]; \
-    \
-    const int shift = shift_16(histogram); \
-    \
-    for (; in_p < end; in_p += channels) \
-        switch (channels) \
-        { \
-            case 4: \
-                min_p[3] = Math::min(in_p[3], min_p[3]); \
-                max_p[3] = Math::max(in_p[3], max_p[3]); \
-            case 3: \
-                out_p[(PIXEL_##TYPE##_TO_U16(in_p[2]) >> shift) * 3 + 2]++; \
-                min_p[2] = Math::min(in_p[2], min_p[2]); \
-                max_p[2] = Math::max(in_p[2], max_p[2]); \
-            case 2: \
-                out_p[(PIXEL_##TYPE##_TO_U16(in_p[1]) >> shift) * 3 + 1]++; \
-                min_p[1] = Math::min(in_p[1], min_p[1]); \
-                max_p[1] = Math::max(in_p[1], max_p[1]); \
-            case 0: \
-                out_p[(PIXEL_##TYPE##_TO_U16(in_p[0]) >> shift) * 3 + 0]++; \
-                min_p[0] = Math::min(in_p[0], min_p[0]); \
-                max_p[0] = Math::max(in_p[0], max_p[0]); \
-                break; \
-        }
+            break;
 
         case Pixel::L_U8:
         case Pixel::LA_U8:
         case Pixel::RGB_U8:
         case Pixel::RGBA_U8:
-        {
-            _HISTOGRAM(U8);
-        }
-        break;
+
+            djv::histogram<Histogram<Pixel::U8_T> >(
+                *data, out, shift_16(histogram), min, max);
+
+            break;
 
         case Pixel::L_U16:
         case Pixel::LA_U16:
         case Pixel::RGB_U16:
         case Pixel::RGBA_U16:
-        {
-            _HISTOGRAM(U16);
-        }
-        break;
+
+            djv::histogram<Histogram<Pixel::U16_T> >(
+                *data, out, shift_16(histogram), min, max);
+
+            break;
 
         case Pixel::L_F16:
         case Pixel::LA_F16:
         case Pixel::RGB_F16:
         case Pixel::RGBA_F16:
-        {
-            _HISTOGRAM(F16);
-        }
-        break;
+
+            djv::histogram<Histogram<Pixel::F16_T> >(
+                *data, out, shift_16(histogram), min, max);
+
+            break;
 
         case Pixel::L_F32:
         case Pixel::LA_F32:
         case Pixel::RGB_F32:
         case Pixel::RGBA_F32:
-        {
-            _HISTOGRAM(F32);
-        }
-        break;
+
+            djv::histogram<Histogram<Pixel::F32_T> >(
+                *data, out, shift_16(histogram), min, max);
+
+            break;
 
         default:
             break;
@@ -742,6 +1048,19 @@ const List<String> & Gl_Image::label_histogram()
     return data;
 }
 
+const List<String> & Gl_Image::label_backend()
+{
+    static const List<String> data = List<String>() <<
+        "OpenGL" <<
+        "CPU";
+
+    DJV_ASSERT(data.size() == _BACKEND_SIZE);
+
+    return data;
+}
+
+Gl_Image::BACKEND Gl_Image::default_backend = Gl_Image::BACKEND_OPENGL;
+
 //------------------------------------------------------------------------------
 
 bool operator == (const Gl_Image_Xform & a, const Gl_Image_Xform & b)
@@ -909,6 +1228,9 @@ _DJV_STRING_OPERATOR_LABEL(
 _DJV_STRING_OPERATOR_LABEL(
     Gl_Image::HISTOGRAM,
     Gl_Image::label_histogram())
+_DJV_STRING_OPERATOR_LABEL(
+    Gl_Image::BACKEND,
+    Gl_Image::label_backend())
 
 Debug & operator << (Debug & debug, const Gl_Image_Xform & in)
 {
@@ -945,5 +1267,10 @@ Debug & operator << (Debug & debug, Gl_Image::HISTOGRAM in)
     return debug << String_Util::label(in);
 }
 
+Debug & operator << (Debug & debug, Gl_Image::BACKEND in)
+{
+    return debug << String_Util::label(in);
+}
+
 } // djv
 
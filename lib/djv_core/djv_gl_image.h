@@ -292,7 +292,8 @@ public:
 
     static void read(Pixel_Data &, const Box2i &);
 
-    //! Copy image data.
+    //! Copy image data using the default backend. The state and buffer are
+    //! only used by the OpenGL backend.
 
     static void copy(
         const Pixel_Data &       input,
@@ -301,15 +302,45 @@ public:
         Gl_Image_State *         state   = 0,
         Gl_Offscreen_Buffer *    buffer  = 0) throw (Error);
 
-    //! Setup OpenGL state for image drawing.
+    //! Copy image data with the CPU. This does not require an OpenGL
+    //! context.
 
-    static void state_unpack(
+    static void copy_cpu(
+        const Pixel_Data &       input,
+        Pixel_Data &             output,
+        const Gl_Image_Options & options = Gl_Image_Options()) throw (Error);
+
+    //! Image copy backends.
+
+    enum BACKEND
+    {
+        BACKEND_OPENGL,
+        BACKEND_CPU,
+
+        _BACKEND_SIZE
+    };
+
+    //! Get the image copy backend labels.
+
+    static const List<String> & label_backend();
+
+    //! The default image copy backend.
+
+    static BACKEND default_backend;
+
+    //! Setup OpenGL state for image drawing. Returns false if the scanline
+    //! alignment can't be described to OpenGL, in which case the scanlines
+    //! need to be transferred one at a time.
+
+    static bool state_unpack(
         const Pixel_Data_Info &,
         const V2i & offset = V2i());
 
-    //! Setup OpenGL state for image reading.
+    //! Setup OpenGL state for image reading. Returns false if the scanline
+    //! alignment can't be described to OpenGL, in which case the scanlines
+    //! need to be transferred one at a time.
 
-    static void state_pack(
+    static bool state_pack(
         const Pixel_Data_Info &,
         const V2i & offset = V2i());
 
@@ -391,6 +422,8 @@ DJV_CORE_EXPORT String & operator >> (String &, Gl_Image_Options::CHANNEL &)
     throw (String);
 DJV_CORE_EXPORT String & operator >> (String &, Gl_Image::HISTOGRAM &)
     throw (String);
+DJV_CORE_EXPORT String & operator >> (String &, Gl_Image::BACKEND &)
+    throw (String);
 
 DJV_CORE_EXPORT String & operator << (String &, const Gl_Image_Xform &);
 DJV_CORE_EXPORT String & operator << (String &, const Gl_Image_Color &);
@@ -399,6 +432,7 @@ DJV_CORE_EXPORT String & operator << (String &, const Gl_Image_Filter &);
 DJV_CORE_EXPORT String & operator << (String &, Gl_Image_Filter::FILTER);
 DJV_CORE_EXPORT String & operator << (String &, Gl_Image_Options::CHANNEL);
 DJV_CORE_EXPORT String & operator << (String &, Gl_Image::HISTOGRAM);
+DJV_CORE_EXPORT String & operator << (String &, Gl_Image::BACKEND);
 
 DJV_CORE_EXPORT Debug & operator << (Debug &, const Gl_Image_Xform &);
 DJV_CORE_EXPORT Debug & operator << (Debug &, const Gl_Image_Color &);
@@ -407,6 +441,7 @@ DJV_CORE_EXPORT Debug & operator << (Debug &, const Gl_Image_Filter &);
 DJV_CORE_EXPORT Debug & operator << (Debug &, Gl_Image_Filter::FILTER);
 DJV_CORE_EXPORT Debug & operator << (Debug &, Gl_Image_Options::CHANNEL);
 DJV_CORE_EXPORT Debug & operator << (Debug &, Gl_Image::HISTOGRAM);
+DJV_CORE_EXPORT Debug & operator << (Debug &, Gl_Image::BACKEND);
 
 } // djv
 
@@ -0,0 +1,932 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_gl_image_cpu.cpp
+
+#include <djv_gl_image.h>
+
+#include <djv_gl_image_private.h>
+#include <djv_memory_buffer.h>
+#include <djv_thread_pool.h>
+
+#include <djv_debug.h>
+
+#if defined(__SSE__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DJV_GL_IMAGE_CPU_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// Gl_Image::copy_cpu
+//
+// The CPU backend follows Gl_Image::draw() and the shader generated by
+// source_fragment(). Pixels are converted to RGBA floating point, sampled with
+// the same transform and filter contributions, and run through the same color
+// and display profile operations.
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// This class provides a RGBA accumulator for the filter taps.
+
+class Accum
+{
+public:
+
+    inline Accum()
+    {
+#if defined(DJV_GL_IMAGE_CPU_SSE)
+        _v = _mm_setzero_ps();
+#else
+        _v[0] = _v[1] = _v[2] = _v[3] = 0.0f;
+#endif
+    }
+
+    inline void add(const float * in, float w)
+    {
+#if defined(DJV_GL_IMAGE_CPU_SSE)
+        _v = _mm_add_ps(_v, _mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(w)));
+#else
+        _v[0] += in[0] * w;
+        _v[1] += in[1] * w;
+        _v[2] += in[2] * w;
+        _v[3] += in[3] * w;
+#endif
+    }
+
+    inline void store(float * out) const
+    {
+#if defined(DJV_GL_IMAGE_CPU_SSE)
+        _mm_storeu_ps(out, _v);
+#else
+        out[0] = _v[0];
+        out[1] = _v[1];
+        out[2] = _v[2];
+        out[3] = _v[3];
+#endif
+    }
+
+private:
+
+#if defined(DJV_GL_IMAGE_CPU_SSE)
+    __m128 _v;
+#else
+    float  _v [4];
+#endif
+};
+
+// Swap the bytes of a scanline while copying it. The input and output may be
+// the same.
+
+void endian(const void * in, void * out, const Pixel_Data_Info & info)
+{
+    if (Pixel::RGB_U10 == info.pixel)
+    {
+        Memory::endian(in, out, info.size.x, 4);
+    }
+    else
+    {
+        Memory::endian(
+            in,
+            out,
+            info.size.x * Pixel::channels(info.pixel),
+            Pixel::channel_bytes(info.pixel));
+    }
+}
+
+// This class provides a RGBA floating point image.
+
+class Rgba
+{
+public:
+
+    void size(int w, int h)
+    {
+        _w = w;
+        _h = h;
+        _data.size(static_cast<size_t>(w) * h * 4);
+    }
+
+    inline int w() const { return _w; }
+    inline int h() const { return _h; }
+
+    inline float * data(int x, int y)
+    {
+        return _data() + (static_cast<size_t>(y) * _w + x) * 4;
+    }
+
+    inline const float * data(int x, int y) const
+    {
+        return _data() + (static_cast<size_t>(y) * _w + x) * 4;
+    }
+
+private:
+
+    int                  _w;
+    int                  _h;
+    Memory_Buffer<float> _data;
+};
+
+// This class provides a lookup table. Like the OpenGL texture the table is
+// sized to a power of two and sampled with the nearest value.
+
+class Lut
+{
+public:
+
+    Lut() :
+        _size     (0),
+        _size_pow2(0)
+    {}
+
+    void init(const Pixel_Data & in)
+    {
+        _size      = in.w();
+        _size_pow2 = Math::to_pow2(_size);
+
+        _data.size(_size * 4);
+
+        Memory_Buffer<uint8_t> tmp(in.bytes_scanline());
+
+        if (in.info().endian != Memory::endian())
+        {
+            endian(in.data(), tmp(), in.info());
+        }
+        else
+        {
+            Memory::copy(in.data(), tmp(), in.bytes_scanline());
+        }
+
+        Pixel::convert(
+            tmp(), in.pixel(),
+            _data(), Pixel::RGBA_F32,
+            _size, 1, in.info().bgr);
+    }
+
+    inline bool is_valid() const
+    {
+        return _size > 0;
+    }
+
+    inline void operator () (float * in) const
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            const int i = Math::clamp(
+                static_cast<int>(Math::floor(in[c] * _size_pow2)),
+                0,
+                _size - 1);
+
+            in[c] = _data()[i * 4 + c];
+        }
+    }
+
+private:
+
+    int                  _size;
+    int                  _size_pow2;
+    Memory_Buffer<float> _data;
+};
+
+// This class provides the color profile operation.
+
+class Color_Profile_Op
+{
+public:
+
+    Color_Profile_Op(const Color_Profile & in) :
+        _type    (in.type),
+        _gamma   (1.0 / in.gamma),
+        _exposure(in.exposure)
+    {
+        if (Color_Profile::LUT == _type)
+        {
+            _lut.init(in.lut);
+        }
+    }
+
+    inline void operator () (float * in) const
+    {
+        switch (_type)
+        {
+            case Color_Profile::LUT:
+
+                _lut(in);
+
+                break;
+
+            case Color_Profile::GAMMA:
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    in[c] = static_cast<float>(Math::pow(in[c], _gamma));
+                }
+
+                break;
+
+            case Color_Profile::EXPOSURE:
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    double tmp =
+                        Math::max(0.0, in[c] - _exposure.d) * _exposure.v;
+
+                    if (tmp > _exposure.k)
+                    {
+                        tmp = _exposure.k +
+                            Math::log((tmp - _exposure.k) * _exposure.f + 1.0) /
+                            _exposure.f;
+                    }
+
+                    in[c] = static_cast<float>(tmp * 0.332);
+                }
+
+                break;
+
+            default: break;
+        }
+    }
+
+private:
+
+    Color_Profile::PROFILE _type;
+    double                 _gamma;
+    Lut                    _lut;
+    Gl_Image_Exposure      _exposure;
+};
+
+// This class provides the display profile and channel operations.
+
+class Display_Profile_Op
+{
+public:
+
+    Display_Profile_Op(
+        const Gl_Image_Display_Profile & in,
+        Gl_Image_Options::CHANNEL        channel) :
+        _color          (in.color != Gl_Image_Display_Profile().color),
+        _color_matrix   (Gl_Image_Color::color_matrix(in.color)),
+        _levels         (in.levels != Gl_Image_Display_Profile().levels),
+        _in0            (in.levels.in_low),
+        _in1            (in.levels.in_high - in.levels.in_low),
+        _gamma          (1.0 / in.levels.gamma),
+        _out0           (in.levels.out_low),
+        _out1           (in.levels.out_high - in.levels.out_low),
+        _soft_clip      (in.soft_clip != Gl_Image_Display_Profile().soft_clip),
+        _soft_clip_value(in.soft_clip),
+        _channel        (channel)
+    {
+        if (Vector_Util::is_size_valid(in.lut.size()))
+        {
+            _lut.init(in.lut);
+        }
+    }
+
+    inline void operator () (float * in) const
+    {
+        if (_lut.is_valid())
+        {
+            _lut(in);
+        }
+
+        if (_color)
+        {
+            const V3f tmp = _color_matrix * V3f(in[0], in[1], in[2]);
+
+            in[0] = static_cast<float>(tmp.x);
+            in[1] = static_cast<float>(tmp.y);
+            in[2] = static_cast<float>(tmp.z);
+        }
+
+        if (_levels)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                in[c] = static_cast<float>(
+                    Math::pow(Math::max(in[c] - _in0, 0.0) / _in1, _gamma) *
+                    _out1 + _out0);
+            }
+        }
+
+        if (_soft_clip)
+        {
+            const double tmp = 1.0 - _soft_clip_value;
+
+            for (int c = 0; c < 3; ++c)
+            {
+                if (in[c] > tmp)
+                {
+                    in[c] = static_cast<float>(
+                        tmp +
+                        (1.0 - Math::exp(-(in[c] - tmp) / _soft_clip_value)) *
+                        _soft_clip_value);
+                }
+            }
+        }
+
+        if (_channel)
+        {
+            in[0] = in[1] = in[2] = in[3] = in[_channel - 1];
+        }
+    }
+
+private:
+
+    Lut    _lut;
+    bool   _color;
+    M4f    _color_matrix;
+    bool   _levels;
+    double _in0, _in1, _gamma, _out0, _out1;
+    bool   _soft_clip;
+    double _soft_clip_value;
+    int    _channel;
+};
+
+// This class provides the inverse of the image transform, mapping output
+// pixels back onto the image quad.
+
+class Xform_Inverse
+{
+public:
+
+    Xform_Inverse(const M3f & in)
+    {
+        const double det = in.e[0] * in.e[4] - in.e[3] * in.e[1];
+
+        _valid = det != 0.0;
+
+        if (_valid)
+        {
+            _a = in.e[4] / det;
+            _b = -in.e[3] / det;
+            _c = -in.e[1] / det;
+            _d = in.e[0] / det;
+        }
+        else
+        {
+            _a = _b = _c = _d = 0.0;
+        }
+
+        _tx = in.e[6];
+        _ty = in.e[7];
+    }
+
+    inline bool is_valid() const
+    {
+        return _valid;
+    }
+
+    // Get the quad position of the first pixel center in a scanline, and the
+    // step between pixels.
+
+    inline void scanline(int y, V2f & position, V2f & step) const
+    {
+        const double x = 0.5 - _tx;
+        const double y_ = y + 0.5 - _ty;
+
+        position = V2f(_a * x + _b * y_, _c * x + _d * y_);
+        step     = V2f(_a, _c);
+    }
+
+private:
+
+    bool   _valid;
+    double _a, _b, _c, _d;
+    double _tx, _ty;
+};
+
+// Convert the input to RGBA floating point.
+
+class Unpack : public Thread_Range
+{
+public:
+
+    Unpack(
+        const Pixel_Data &       in,
+        Rgba &                   out,
+        const Color_Profile_Op * color_profile) :
+        _in           (in),
+        _out          (out),
+        _color_profile(color_profile)
+    {}
+
+    void run(int begin, int end)
+    {
+        const Pixel_Data_Info & info = _in.info();
+
+        const bool endian_swap = info.endian != Memory::endian();
+
+        Pixel::Convert_Fnc * convert =
+            Pixel::convert_fnc(info.pixel, Pixel::RGBA_F32, 1, info.bgr);
+
+        Memory_Buffer<uint8_t> tmp;
+
+        if (endian_swap)
+        {
+            tmp.size(_in.bytes_scanline());
+        }
+
+        for (int y = begin; y < end; ++y)
+        {
+            const uint8_t * p = _in.data(0, y);
+
+            if (endian_swap)
+            {
+                endian(p, tmp(), info);
+
+                p = tmp();
+            }
+
+            float * out = _out.data(0, y);
+
+            convert(p, out, info.size.x, 1);
+
+            if (_color_profile)
+            {
+                for (int x = 0; x < info.size.x; ++x, out += 4)
+                {
+                    (*_color_profile)(out);
+                }
+            }
+        }
+    }
+
+private:
+
+    const Pixel_Data &       _in;
+    Rgba &                   _out;
+    const Color_Profile_Op * _color_profile;
+};
+
+// The horizontal pass of the two pass filters. Like the OpenGL backend this
+// also applies the mirroring.
+
+class Scale_X : public Thread_Range
+{
+public:
+
+    Scale_X(
+        const Rgba &                   in,
+        Rgba &                         out,
+        const Gl_Image_Scale_Contrib & contrib,
+        const V2b &                    mirror,
+        bool                           clamp) :
+        _in     (in),
+        _out    (out),
+        _contrib(contrib),
+        _mirror (mirror),
+        _clamp  (clamp)
+    {}
+
+    void run(int begin, int end)
+    {
+        const int w     = _out.w();
+        const int h     = _out.h();
+        const int width = _contrib.width;
+
+        for (int y = begin; y < end; ++y)
+        {
+            const float * in  = _in.data(0, _mirror.y ? (h - 1 - y) : y);
+            float *       out = _out.data(0, y);
+
+            for (int x = 0; x < w; ++x, out += 4)
+            {
+                const int i = _mirror.x ? (w - 1 - x) : x;
+
+                Accum accum;
+
+                for (int j = 0; j < width; ++j)
+                {
+                    accum.add(
+                        in + _contrib.pixel(i, j) * 4,
+                        _contrib.weight(i, j));
+                }
+
+                accum.store(out);
+
+                // Integer pixel types are rendered to a fixed point buffer.
+
+                if (_clamp)
+                {
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        out[c] = Math::clamp(out[c], 0.0f, 1.0f);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+
+    const Rgba &                   _in;
+    Rgba &                         _out;
+    const Gl_Image_Scale_Contrib & _contrib;
+    V2b                            _mirror;
+    bool                           _clamp;
+};
+
+// Render the output.
+
+class Render : public Thread_Range
+{
+public:
+
+    enum MODE
+    {
+        NEAREST,
+        LINEAR,
+        SCALE_Y
+    };
+
+    Render(
+        MODE                           mode,
+        const Rgba &                   in,
+        Pixel_Data &                   out,
+        const V2f &                    quad,
+        const Xform_Inverse &          xform,
+        const V2b &                    mirror,
+        const Gl_Image_Scale_Contrib * contrib,
+        const Color_Profile_Op *       color_profile,
+        const Display_Profile_Op &     display_profile,
+        const float *                  background) :
+        _mode           (mode),
+        _in             (in),
+        _out            (out),
+        _quad           (quad),
+        _xform          (xform),
+        _mirror         (mirror),
+        _contrib        (contrib),
+        _color_profile  (color_profile),
+        _display_profile(display_profile),
+        _background     (background)
+    {}
+
+    void run(int begin, int end)
+    {
+        const Pixel_Data_Info & info = _out.info();
+
+        const bool endian_swap = info.endian != Memory::endian();
+
+        Pixel::Convert_Fnc * convert =
+            Pixel::convert_fnc(Pixel::RGBA_F32, info.pixel, 1, info.bgr);
+
+        Memory_Buffer<float> tmp(info.size.x * 4);
+
+        for (int y = begin; y < end; ++y)
+        {
+            float * p = tmp();
+
+            V2f position, step;
+
+            _xform.scanline(y, position, step);
+
+            for (int x = 0; x < info.size.x; ++x, p += 4, position += step)
+            {
+                // Pixels outside of the quad are the background color.
+
+                if (! _xform.is_valid() ||
+                    position.x < 0.0 || position.x >= _quad.x ||
+                    position.y < 0.0 || position.y >= _quad.y)
+                {
+                    p[0] = _background[0];
+                    p[1] = _background[1];
+                    p[2] = _background[2];
+                    p[3] = _background[3];
+
+                    continue;
+                }
+
+                switch (_mode)
+                {
+                    case NEAREST: nearest(position, p); break;
+                    case LINEAR:  linear (position, p); break;
+                    case SCALE_Y: scale_y(position, p); break;
+                }
+
+                if (_color_profile)
+                {
+                    (*_color_profile)(p);
+                }
+
+                _display_profile(p);
+            }
+
+            uint8_t * out = _out.data(0, y);
+
+            convert(tmp(), out, info.size.x, 1);
+
+            if (endian_swap)
+            {
+                endian(out, out, info);
+            }
+        }
+    }
+
+private:
+
+    // Get the texture coordinate of a quad position.
+
+    inline V2f texture(const V2f & in) const
+    {
+        V2f out = in / _quad;
+
+        if (_mirror.x)
+        {
+            out.x = 1.0 - out.x;
+        }
+
+        if (_mirror.y)
+        {
+            out.y = 1.0 - out.y;
+        }
+
+        return out;
+    }
+
+    inline void nearest(const V2f & in, float * out) const
+    {
+        const V2f t = texture(in);
+
+        const int x = Math::clamp(
+            static_cast<int>(Math::floor(t.x * _in.w())), 0, _in.w() - 1);
+        const int y = Math::clamp(
+            static_cast<int>(Math::floor(t.y * _in.h())), 0, _in.h() - 1);
+
+        const float * p = _in.data(x, y);
+
+        out[0] = p[0];
+        out[1] = p[1];
+        out[2] = p[2];
+        out[3] = p[3];
+    }
+
+    inline void linear(const V2f & in, float * out) const
+    {
+        const V2f t = texture(in);
+
+        const double tx = t.x * _in.w() - 0.5;
+        const double ty = t.y * _in.h() - 0.5;
+        const int    x  = Math::floor(tx);
+        const int    y  = Math::floor(ty);
+        const float  fx = static_cast<float>(tx - x);
+        const float  fy = static_cast<float>(ty - y);
+        const int    x0 = Math::clamp(x,     0, _in.w() - 1);
+        const int    x1 = Math::clamp(x + 1, 0, _in.w() - 1);
+        const int    y0 = Math::clamp(y,     0, _in.h() - 1);
+        const int    y1 = Math::clamp(y + 1, 0, _in.h() - 1);
+
+        Accum accum;
+
+        accum.add(_in.data(x0, y0), (1.0f - fx) * (1.0f - fy));
+        accum.add(_in.data(x1, y0), fx * (1.0f - fy));
+        accum.add(_in.data(x0, y1), (1.0f - fx) * fy);
+        accum.add(_in.data(x1, y1), fx * fy);
+
+        accum.store(out);
+    }
+
+    // The vertical pass of the two pass filters.
+
+    inline void scale_y(const V2f & in, float * out) const
+    {
+        const int x = Math::clamp(
+            static_cast<int>(Math::floor(in.x)), 0, _in.w() - 1);
+        const int i = Math::clamp(
+            static_cast<int>(Math::floor(in.y)), 0, _contrib->output - 1);
+
+        Accum accum;
+
+        for (int j = 0; j < _contrib->width; ++j)
+        {
+            accum.add(
+                _in.data(x, _contrib->pixel(i, j)),
+                _contrib->weight(i, j));
+        }
+
+        accum.store(out);
+    }
+
+    MODE                           _mode;
+    const Rgba &                   _in;
+    Pixel_Data &                   _out;
+    V2f                            _quad;
+    const Xform_Inverse &          _xform;
+    V2b                            _mirror;
+    const Gl_Image_Scale_Contrib * _contrib;
+    const Color_Profile_Op *       _color_profile;
+    const Display_Profile_Op &     _display_profile;
+    const float *                  _background;
+};
+
+const int grain = 16;
+
+} // namespace
+
+void Gl_Image::copy_cpu(
+    const Pixel_Data &       input,
+    Pixel_Data &             output,
+    const Gl_Image_Options & options) throw (Error)
+{
+    //DJV_DEBUG("Gl_Image::copy_cpu");
+    //DJV_DEBUG_PRINT("input = " << input);
+    //DJV_DEBUG_PRINT("output = " << output);
+    //DJV_DEBUG_PRINT("scale = " << options.xform.scale);
+
+    const Pixel_Data_Info & info = input.info();
+
+    if (! input.is_valid() || ! output.is_valid())
+    {
+        return;
+    }
+
+    // The output is written by multiple threads, so make sure it is not
+    // shared first.
+
+    output.data();
+
+    // Initialize.
+
+    const int proxy_scale =
+        options.proxy_scale ?
+        Pixel_Data::proxy_scale(info.proxy) :
+        1;
+
+    const V2i scale = Vector_Util::ceil<double, int>(
+        options.xform.scale * V2f(info.size * proxy_scale));
+
+    //DJV_DEBUG_PRINT("scale = " << scale);
+
+    const Gl_Image_Filter::FILTER filter =
+        info.size == scale ? Gl_Image_Filter::NEAREST :
+        (Vector_Util::area(scale) < Vector_Util::area(info.size) ?
+         options.filter.min : options.filter.mag);
+
+    //DJV_DEBUG_PRINT("filter = " << filter);
+
+    const V2b mirror(
+        info.mirror.x != options.xform.mirror.x ?
+            ! output.info().mirror.x : output.info().mirror.x,
+        info.mirror.y != options.xform.mirror.y ?
+            ! output.info().mirror.y : output.info().mirror.y);
+
+    //DJV_DEBUG_PRINT("mirror = " << mirror);
+
+    Color background(Pixel::RGB_F32);
+
+    Color::convert(options.background, background);
+
+    const float background_rgba [] =
+    {
+        background.get_f32(0),
+        background.get_f32(1),
+        background.get_f32(2),
+        0.0f
+    };
+
+    const Color_Profile_Op color_profile(options.color_profile);
+
+    const Display_Profile_Op display_profile(
+        options.display_profile,
+        options.channel);
+
+    // Convert the input. The color profile is applied to the input pixels
+    // unless it needs to be applied after linear filtering.
+
+    Rgba rgba;
+
+    rgba.size(info.size.x, info.size.y);
+
+    {
+        Unpack fnc(
+            input,
+            rgba,
+            Gl_Image_Filter::LINEAR == filter ? 0 : &color_profile);
+
+        Thread_Pool::global()->parallel_for(0, info.size.y, fnc, grain);
+    }
+
+    // Render.
+
+    switch (filter)
+    {
+        case Gl_Image_Filter::NEAREST:
+        case Gl_Image_Filter::LINEAR:
+        {
+            const Xform_Inverse xform(
+                Gl_Image_Xform::xform_matrix(options.xform));
+
+            Render fnc(
+                Gl_Image_Filter::NEAREST == filter ?
+                    Render::NEAREST :
+                    Render::LINEAR,
+                rgba,
+                output,
+                V2f(info.size * proxy_scale),
+                xform,
+                mirror,
+                0,
+                Gl_Image_Filter::LINEAR == filter ? &color_profile : 0,
+                display_profile,
+                background_rgba);
+
+            Thread_Pool::global()->parallel_for(0, output.h(), fnc, grain);
+        }
+        break;
+
+        case Gl_Image_Filter::BOX:
+        case Gl_Image_Filter::TRIANGLE:
+        case Gl_Image_Filter::BELL:
+        case Gl_Image_Filter::BSPLINE:
+        case Gl_Image_Filter::LANCZOS3:
+        case Gl_Image_Filter::CUBIC:
+        case Gl_Image_Filter::MITCHELL:
+        {
+            // Horizontal pass.
+
+            Gl_Image_Scale_Contrib contrib;
+
+            contrib.init(info.size.x, scale.x, filter);
+
+            Rgba tmp;
+
+            tmp.size(scale.x, info.size.y);
+
+            {
+                Scale_X fnc(
+                    rgba,
+                    tmp,
+                    contrib,
+                    mirror,
+                    Pixel::type(info.pixel) != Pixel::F16 &&
+                    Pixel::type(info.pixel) != Pixel::F32);
+
+                Thread_Pool::global()->parallel_for(
+                    0, info.size.y, fnc, grain);
+            }
+
+            // Vertical pass.
+
+            contrib.init(info.size.y, scale.y, filter);
+
+            Gl_Image_Xform xform = options.xform;
+            xform.scale = V2f(1.0);
+
+            const Xform_Inverse xform_inverse(
+                Gl_Image_Xform::xform_matrix(xform));
+
+            Render fnc(
+                Render::SCALE_Y,
+                tmp,
+                output,
+                V2f(scale),
+                xform_inverse,
+                V2b(),
+                &contrib,
+                0,
+                display_profile,
+                background_rgba);
+
+            Thread_Pool::global()->parallel_for(0, output.h(), fnc, grain);
+        }
+        break;
+
+        default:
+            break;
+    }
+}
+
+} // djv
@@ -33,6 +33,7 @@
 
 #include <djv_gl_image.h>
 
+#include <djv_gl_image_private.h>
 #include <djv_gl_offscreen_buffer.h>
 
 #include <djv_matrix.h>
@@ -83,6 +84,8 @@ public:
 
 private:
 
+    int64_t bytes() const;
+
     void del();
 
     Pixel_Data_Info _info;
@@ -124,6 +127,8 @@ void Gl_Image_Lut::init(const Pixel_Data_Info & info) throw (Error)
         throw _ERROR("Cannot create texture");
     }
 
+    Memory::stats_add(Memory::TAG_LUT, bytes());
+
     DJV_DEBUG_GL(glBindTexture(GL_TEXTURE_1D, _id));
     DJV_DEBUG_GL(
         glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
@@ -201,12 +206,19 @@ GLuint Gl_Image_Lut::id() const
     return _id;
 }
 
+int64_t Gl_Image_Lut::bytes() const
+{
+    return _size * Pixel::bytes(_info.pixel);
+}
+
 void Gl_Image_Lut::del()
 {
     if (_id)
     {
         glDeleteTextures(1, &_id);
 
+        Memory::stats_add(Memory::TAG_LUT, -bytes());
+
         _id = 0;
     }
 }
@@ -247,6 +259,8 @@ public:
 
 private:
 
+    int64_t bytes() const;
+
     void del();
 
     Pixel_Data_Info _info;
@@ -294,6 +308,8 @@ void Gl_Image_Texture::init(
         throw _ERROR("Cannot create texture");
     }
 
+    Memory::stats_add(Memory::TAG_GL, bytes());
+
     DJV_DEBUG_GL(glBindTexture(GL_TEXTURE_2D, _id));
     DJV_DEBUG_GL(
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
@@ -349,19 +365,37 @@ void Gl_Image_Texture::copy(const Pixel_Data & in)
 
     const Pixel_Data_Info & info = in.info();
 
-    Gl_Image::state_unpack(in.info());
-
-    DJV_DEBUG_GL(
-        glTexSubImage2D(
-            GL_TEXTURE_2D,
-            0,
-            0,
-            0,
-            info.size.x,
-            info.size.y,
-            Gl_Util::format(info.pixel, info.bgr),
-            Gl_Util::type(info.pixel),
-            in.data()));
+    if (Gl_Image::state_unpack(in.info()))
+    {
+        DJV_DEBUG_GL(
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                0,
+                0,
+                info.size.x,
+                info.size.y,
+                Gl_Util::format(info.pixel, info.bgr),
+                Gl_Util::type(info.pixel),
+                in.data()));
+    }
+    else
+    {
+        for (int y = 0; y < info.size.y; ++y)
+        {
+            DJV_DEBUG_GL(
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    0,
+                    y,
+                    info.size.x,
+                    1,
+                    Gl_Util::format(info.pixel, info.bgr),
+                    Gl_Util::type(info.pixel),
+                    in.data(0, y)));
+        }
+    }
 }
 
 void Gl_Image_Texture::copy(const V2i & in)
@@ -410,12 +444,19 @@ GLuint Gl_Image_Texture::id() const
     return _id;
 }
 
+int64_t Gl_Image_Texture::bytes() const
+{
+    return Pixel_Data::bytes_data(_info);
+}
+
 void Gl_Image_Texture::del()
 {
     if (_id)
     {
         glDeleteTextures(1, &_id);
 
+        Memory::stats_add(Memory::TAG_GL, -bytes());
+
         _id = 0;
     }
 }
@@ -867,9 +908,76 @@ void scale_contrib(
     Pixel_Data &            data)
 {
     //DJV_DEBUG("scale_contrib");
+
+    Gl_Image_Scale_Contrib contrib;
+
+    contrib.init(input, output, filter);
+
+    data.set(Pixel_Data_Info(V2i(output, contrib.width), Pixel::LA_F32));
+
+    for (int i = 0; i < output; ++i)
+    {
+        for (int j = 0; j < contrib.width; ++j)
+        {
+            Pixel::F32_T * p =
+                reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
+
+            p[0] = static_cast<Pixel::F32_T>(
+                contrib.pixel(i, j) / double(input));
+            p[1] = contrib.weight(i, j);
+        }
+    }
+}
+
+void quad(
+    const V2i & size,
+    const V2b & mirror      = V2b(),
+    int         proxy_scale = 1)
+{
+    //DJV_DEBUG("quad");
+
+    double u [] = { 0, 0 };
+    double v [] = { 0, 0 };
+
+    u[! mirror.x] = 1.0;
+    v[! mirror.y] = 1.0;
+
+    //DJV_DEBUG_PRINT("u = " << u[0] << " " << u[1]);
+    //DJV_DEBUG_PRINT("v = " << v[0] << " " << v[1]);
+
+    const V2f uv [] =
+    {
+        V2f(u[0], v[0]),
+        V2f(u[0], v[1]),
+        V2f(u[1], v[1]),
+        V2f(u[1], v[0])
+    };
+
+    glBegin(GL_QUADS);
+
+    Gl_Util::draw_box(size * proxy_scale, uv);
+
+    glEnd();
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Gl_Image_Scale_Contrib
+//------------------------------------------------------------------------------
+
+void Gl_Image_Scale_Contrib::init(
+    int                     input,
+    int                     output,
+    Gl_Image_Filter::FILTER filter)
+{
+    //DJV_DEBUG("Gl_Image_Scale_Contrib::init");
     //DJV_DEBUG_PRINT("scale = " << input << " " << output);
     //DJV_DEBUG_PRINT("filter = " << filter);
 
+    this->input  = input;
+    this->output = output;
+
     // Filter function.
 
     Filter_Fnc * fnc = filter_fnc(filter);
@@ -890,11 +998,12 @@ void scale_contrib(
 
     // Initialize.
 
-    const int width = Math::ceil(radius * 2 + 1);
+    width = Math::ceil(radius * 2 + 1);
 
     //DJV_DEBUG_PRINT("width = " << width);
 
-    data.set(Pixel_Data_Info(V2i(output, width), Pixel::LA_F32));
+    _pixel.resize(output * width);
+    _weight.resize(output * width);
 
     // Work.
 
@@ -906,92 +1015,46 @@ void scale_contrib(
 
         //DJV_DEBUG_PRINT(i << " = " << left << " " << center << " " << right);
 
-        double sum   = 0.0;
-        int    pixel = 0;
+        int *   p     = &_pixel[i * width];
+        float * w     = &_weight[i * width];
+        double  sum   = 0.0;
+        int     pixel = 0;
 
         int j = 0;
 
         for (int k = left; j < width && k <= right; ++j, ++k)
         {
-            Pixel::F32_T * p =
-                reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-
             pixel = edge(k, input);
 
             const double x = (center - k) * (scale < 1.0 ? scale : 1.0);
-            const double w = (scale < 1.0) ? ((*fnc)(x) * scale) : (*fnc)(x);
+            const double tmp =
+                (scale < 1.0) ? ((*fnc)(x) * scale) : (*fnc)(x);
 
-            //DJV_DEBUG_PRINT("w = " << w);
+            //DJV_DEBUG_PRINT("w = " << tmp);
 
-            p[0] = static_cast<Pixel::F32_T>(pixel / double(input));
-            p[1] = static_cast<Pixel::F32_T>(w);
+            p[j] = pixel;
+            w[j] = static_cast<float>(tmp);
 
-            sum += w;
+            sum += tmp;
         }
 
         for (; j < width; ++j)
         {
-            Pixel::F32_T * p =
-                reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-
-            p[0] = static_cast<Pixel::F32_T>(pixel / double(input));
-            p[1] = 0.0f;
+            p[j] = pixel;
+            w[j] = 0.0f;
         }
 
-        /*for (j = 0; j < width; ++j)
-        {
-          Pixel::F32_T * p =
-            reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-
-          //DJV_DEBUG_PRINT(p[0] << " = " << p[1]);
-        }
-        //DJV_DEBUG_PRINT("sum = " << sum);*/
+        //DJV_DEBUG_PRINT("sum = " << sum);
 
         //! \todo Why do we have to average these?
 
         for (j = 0; j < width; ++j)
         {
-            Pixel::F32_T * p =
-                reinterpret_cast<Pixel::F32_T *>(data.data(i, j));
-
-            p[1] /= static_cast<Pixel::F32_T>(sum);
+            w[j] /= static_cast<float>(sum);
         }
     }
 }
 
-void quad(
-    const V2i & size,
-    const V2b & mirror      = V2b(),
-    int         proxy_scale = 1)
-{
-    //DJV_DEBUG("quad");
-
-    double u [] = { 0, 0 };
-    double v [] = { 0, 0 };
-
-    u[! mirror.x] = 1.0;
-    v[! mirror.y] = 1.0;
-
-    //DJV_DEBUG_PRINT("u = " << u[0] << " " << u[1]);
-    //DJV_DEBUG_PRINT("v = " << v[0] << " " << v[1]);
-
-    const V2f uv [] =
-    {
-        V2f(u[0], v[0]),
-        V2f(u[0], v[1]),
-        V2f(u[1], v[1]),
-        V2f(u[1], v[0])
-    };
-
-    glBegin(GL_QUADS);
-
-    Gl_Util::draw_box(size * proxy_scale, uv);
-
-    glEnd();
-}
-
-} // namespace
-
 //------------------------------------------------------------------------------
 // Shader Source
 //------------------------------------------------------------------------------
@@ -1379,6 +1442,18 @@ double knee2(double x, double y)
     return (f0 + f1) / 2.0;
 }
 
+} // namespace
+
+Gl_Image_Exposure::Gl_Image_Exposure(const Color_Profile::Exposure & in) :
+    v(Math::pow(2.0, in.value + 2.47393)),
+    d(in.defog),
+    k(Math::pow(2.0, in.knee_low)),
+    f(knee2(Math::pow(2.0, in.knee_high) - k, Math::pow(2.0, 3.5) - k))
+{}
+
+namespace
+{
+
 void color_profile_init(
     const Gl_Image_Options & options,
     GLuint                   program,
@@ -1409,23 +1484,8 @@ void color_profile_init(
 
         case Color_Profile::EXPOSURE:
         {
-            struct Exposure
-            {
-                double v, d, k, f;
-            }
-            exposure;
-
-            exposure.v = Math::pow(
-                2.0,
-                options.color_profile.exposure.value + 2.47393);
-            exposure.d = options.color_profile.exposure.defog;
-            exposure.k = Math::pow(
-                2.0,
-                options.color_profile.exposure.knee_low);
-            exposure.f = knee2(
-                Math::pow(2.0, options.color_profile.exposure.knee_high) -
-                exposure.k,
-                Math::pow(2.0, 3.5) - exposure.k);
+            const Gl_Image_Exposure exposure(
+                options.color_profile.exposure);
 
             //DJV_DEBUG_PRINT("exposure");
             //DJV_DEBUG_PRINT("  v = " << exposure.v);
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_gl_image_private.h
+
+#ifndef DJV_GL_IMAGE_PRIVATE_H
+#define DJV_GL_IMAGE_PRIVATE_H
+
+#include <djv_gl_image.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \struct Gl_Image_Scale_Contrib
+//!
+//! This struct provides the filter contributions for scaling an image in one
+//! dimension. It is shared by the OpenGL and CPU backends so that both use
+//! the same weights.
+//------------------------------------------------------------------------------
+
+struct Gl_Image_Scale_Contrib
+{
+    //! Calculate the contributions.
+
+    void init(int input, int output, Gl_Image_Filter::FILTER);
+
+    //! Get the input pixel of a contribution.
+
+    inline int pixel(int output, int i) const
+    {
+        return _pixel[output * width + i];
+    }
+
+    //! Get the weight of a contribution.
+
+    inline float weight(int output, int i) const
+    {
+        return _weight[output * width + i];
+    }
+
+    int input;
+    int output;
+    int width;
+
+private:
+
+    List<int>   _pixel;
+    List<float> _weight;
+};
+
+//------------------------------------------------------------------------------
+//! \struct Gl_Image_Exposure
+//!
+//! This struct provides the exposure color profile values.
+//------------------------------------------------------------------------------
+
+struct Gl_Image_Exposure
+{
+    //! Constructor.
+
+    Gl_Image_Exposure(const Color_Profile::Exposure &);
+
+    double v, d, k, f;
+};
+
+} // djv
+
+#endif // DJV_GL_IMAGE_PRIVATE_H
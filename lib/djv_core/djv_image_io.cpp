@@ -90,12 +90,33 @@ const Pixel_Data_Info & Image_Io_Info::operator [] (size_t in) const
 Image_Io_Frame_Info::Image_Io_Frame_Info(
     int64_t                frame,
     int                    layer,
-    Pixel_Data_Info::PROXY proxy) :
+    Pixel_Data_Info::PROXY proxy,
+    const Box2i &          roi) :
     frame     (frame),
     layer     (layer),
-    proxy     (proxy)
+    proxy     (proxy),
+    roi       (roi)
 {}
 
+Box2i Image_Io_Frame_Info::roi_clip(const V2i & size) const
+{
+    if (! Vector_Util::is_size_valid(roi.size))
+    {
+        return Box2i(size);
+    }
+
+    // Keep at least one pixel so the result is always a valid image.
+
+    const V2i a(
+        Math::clamp(roi.x, 0, Math::max(size.x - 1, 0)),
+        Math::clamp(roi.y, 0, Math::max(size.y - 1, 0)));
+    const V2i b(
+        Math::clamp(roi.x + roi.w, a.x + 1, Math::max(size.x, a.x + 1)),
+        Math::clamp(roi.y + roi.h, a.y + 1, Math::max(size.y, a.y + 1)));
+
+    return Box2i(a, b - a);
+}
+
 //------------------------------------------------------------------------------
 // Image_Io_Base
 //------------------------------------------------------------------------------
@@ -607,7 +628,8 @@ bool operator == (const Image_Io_Frame_Info & a, const Image_Io_Frame_Info & b)
     return
         a.frame == b.frame &&
         a.layer == b.layer &&
-        a.proxy == b.proxy;
+        a.proxy == b.proxy &&
+        a.roi   == b.roi;
 }
 
 bool operator != (const Image_Io_Frame_Info & a, const Image_Io_Frame_Info & b)
@@ -92,6 +92,11 @@ private:
 //! \struct Image_Io_Frame_Info
 //!
 //! This struct provides image I/O frame information.
+//!
+//! The region of interest is given in pixels of the full resolution image,
+//! with the same orientation as the loaded pixel data. Plugins that can read
+//! part of a file return only that region; other plugins return the whole
+//! image. An empty region loads the whole image.
 //------------------------------------------------------------------------------
 
 struct DJV_CORE_EXPORT Image_Io_Frame_Info
@@ -101,11 +106,18 @@ struct DJV_CORE_EXPORT Image_Io_Frame_Info
     Image_Io_Frame_Info(
         int64_t                frame = -1,
         int                    layer = 0,
-        Pixel_Data_Info::PROXY proxy = Pixel_Data_Info::PROXY_NONE);
+        Pixel_Data_Info::PROXY proxy = Pixel_Data_Info::PROXY_NONE,
+        const Box2i &          roi   = Box2i());
+
+    //! Get the region of interest clipped to an image of the given size. The
+    //! whole image is returned if there is no region of interest.
+
+    Box2i roi_clip(const V2i &) const;
 
     int64_t                frame;
     int                    layer;
     Pixel_Data_Info::PROXY proxy;
+    Box2i                  roi;
 };
 
 //------------------------------------------------------------------------------
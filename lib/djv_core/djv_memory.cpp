@@ -33,15 +33,538 @@
 
 #include <djv_memory.h>
 
+#include <djv_assert.h>
+#include <djv_cpu_private.h>
+#include <djv_math.h>
+#include <djv_memory_pool.h>
+#include <djv_thread.h>
+#include <djv_thread_pool.h>
+
+#include <map>
 #include <string.h>
 #if ! (defined(DJV_FREEBSD) || defined(DJV_OSX))
 #include <malloc.h>
 #include <stdlib.h>
 #endif
+#if defined(DJV_LINUX)
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace djv
 {
 
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Endian conversion kernels
+//------------------------------------------------------------------------------
+
+inline uint16_t endian_word(uint16_t in)
+{
+    return (in >> 8) | (in << 8);
+}
+
+inline uint32_t endian_word(uint32_t in)
+{
+    return
+        (in >> 24) |
+        ((in >> 8) & 0x0000ff00) |
+        ((in << 8) & 0x00ff0000) |
+        (in << 24);
+}
+
+inline uint64_t endian_word(uint64_t in)
+{
+    return
+        (static_cast<uint64_t>(endian_word(static_cast<uint32_t>(in))) << 32) |
+        endian_word(static_cast<uint32_t>(in >> 32));
+}
+
+// Each word is loaded before it is stored so the input and output may be the
+// same.
+
+template<typename T>
+inline void endian_scalar(const uint8_t * in, uint8_t * out, size_t size)
+{
+    T tmp;
+
+    for (; size > 0; --size, in += sizeof(T), out += sizeof(T))
+    {
+        ::memcpy(&tmp, in, sizeof(T));
+
+        tmp = endian_word(tmp);
+
+        ::memcpy(out, &tmp, sizeof(T));
+    }
+}
+
+void endian_scalar(
+    const uint8_t * in,
+    uint8_t *       out,
+    size_t          size,
+    size_t          word_size)
+{
+    switch (word_size)
+    {
+        case 2: endian_scalar<uint16_t>(in, out, size); break;
+        case 4: endian_scalar<uint32_t>(in, out, size); break;
+        case 8: endian_scalar<uint64_t>(in, out, size); break;
+    }
+}
+
+#if defined(DJV_CPU_SIMD)
+
+// Byte shuffles for 2, 4, and 8 byte words. The masks are repeated for both
+// 128-bit lanes of an AVX2 register.
+
+const uint8_t endian_mask [][32] =
+{
+    {
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+    },
+    {
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+    },
+    {
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+    }
+};
+
+// The SIMD kernels return the number of bytes converted; the remainder is
+// left for the scalar kernel.
+
+DJV_CPU_TARGET("ssse3")
+size_t endian_ssse3(
+    const uint8_t * in,
+    uint8_t *       out,
+    size_t          size,
+    const uint8_t * mask)
+{
+    const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask));
+
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i tmp =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(out + i),
+            _mm_shuffle_epi8(tmp, m));
+    }
+
+    return i;
+}
+
+DJV_CPU_TARGET("avx2")
+size_t endian_avx2(
+    const uint8_t * in,
+    uint8_t *       out,
+    size_t          size,
+    const uint8_t * mask)
+{
+    const __m256i m =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask));
+
+    size_t i = 0;
+
+    for (; i + 64 <= size; i += 64)
+    {
+        const __m256i a =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 32));
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(out + i),
+            _mm256_shuffle_epi8(a, m));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(out + i + 32),
+            _mm256_shuffle_epi8(b, m));
+    }
+
+    for (; i + 32 <= size; i += 32)
+    {
+        const __m256i tmp =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(out + i),
+            _mm256_shuffle_epi8(tmp, m));
+    }
+
+    return i;
+}
+
+// Copy with non-temporal stores, which write around the caches so a large
+// copy doesn't evict the data that is being worked on. The output is aligned
+// first and the remainder is left for memcpy().
+
+DJV_CPU_TARGET("sse2")
+size_t copy_stream(const uint8_t * in, uint8_t * out, size_t size)
+{
+    size_t i = (16 - (reinterpret_cast<size_t>(out) & 15)) & 15;
+
+    if (i >= size)
+    {
+        return 0;
+    }
+
+    ::memcpy(out, in, i);
+
+    for (; i + 64 <= size; i += 64)
+    {
+        const __m128i * p = reinterpret_cast<const __m128i *>(in + i);
+
+        const __m128i a = _mm_loadu_si128(p);
+        const __m128i b = _mm_loadu_si128(p + 1);
+        const __m128i c = _mm_loadu_si128(p + 2);
+        const __m128i d = _mm_loadu_si128(p + 3);
+
+        __m128i * q = reinterpret_cast<__m128i *>(out + i);
+
+        _mm_stream_si128(q,     a);
+        _mm_stream_si128(q + 1, b);
+        _mm_stream_si128(q + 2, c);
+        _mm_stream_si128(q + 3, d);
+    }
+
+    // Make the stores visible before the copy returns.
+
+    _mm_sfence();
+
+    return i;
+}
+
+#endif // DJV_CPU_SIMD
+
+// Large copies are split into blocks that are processed by the thread pool.
+
+const size_t copy_block = 1024 * 1024;
+
+void copy_range(const uint8_t * in, uint8_t * out, size_t size)
+{
+    size_t done = 0;
+
+#if defined(DJV_CPU_SIMD)
+
+    if (Cpu::global().sse2)
+    {
+        done = copy_stream(in, out, size);
+    }
+
+#endif // DJV_CPU_SIMD
+
+    ::memcpy(out + done, in + done, size - done);
+}
+
+class Copy : public Thread_Range
+{
+public:
+
+    Copy(const uint8_t * in, uint8_t * out, size_t size) :
+        _in  (in),
+        _out (out),
+        _size(size)
+    {}
+
+    void run(int begin, int end)
+    {
+        const size_t a = begin * copy_block;
+        const size_t b = Math::min(end * copy_block, _size);
+
+        copy_range(_in + a, _out + a, b - a);
+    }
+
+private:
+
+    const uint8_t * _in;
+    uint8_t *       _out;
+    size_t          _size;
+};
+
+// Memory accounting. The last entry holds the totals.
+
+struct Stats_Counter
+{
+    volatile int64_t live;
+    volatile int64_t peak;
+};
+
+Stats_Counter stats_counter [Memory::_TAG_SIZE + 1];
+
+inline int64_t atomic_add(volatile int64_t & in, int64_t value)
+{
+#if defined(DJV_WINDOWS)
+    return InterlockedExchangeAdd64(&in, value) + value;
+#else
+    return __sync_add_and_fetch(&in, value);
+#endif
+}
+
+inline void atomic_max(volatile int64_t & in, int64_t value)
+{
+    int64_t tmp = in;
+
+    while (value > tmp)
+    {
+#if defined(DJV_WINDOWS)
+        const int64_t prev = InterlockedCompareExchange64(&in, value, tmp);
+#else
+        const int64_t prev = __sync_val_compare_and_swap(&in, tmp, value);
+#endif
+
+        if (prev == tmp)
+        {
+            break;
+        }
+
+        tmp = prev;
+    }
+}
+
+Memory::Stats stats_get(const Stats_Counter & in)
+{
+    const int64_t live = in.live;
+    const int64_t peak = in.peak;
+
+    Memory::Stats out;
+    out.live = static_cast<uint64_t>(Math::max<int64_t>(live, 0));
+    out.peak = static_cast<uint64_t>(Math::max<int64_t>(peak, 0));
+
+    return out;
+}
+
+// Large allocations.
+
+typedef std::map<void *, size_t> Large_Map;
+
+struct Large
+{
+    Large() :
+        node(-1)
+    {}
+
+    Memory::Policy policy;
+    int            node;
+    Large_Map      blocks;
+    Mutex          mutex;
+};
+
+// The large allocation data is used from multiple threads, so it is created
+// under a lock.
+
+Large * _large = 0;
+Mutex   _large_mutex;
+
+Large * large()
+{
+    Mutex_Scope scope(_large_mutex);
+
+    if (! _large)
+    {
+        _large = new Large;
+    }
+
+    return _large;
+}
+
+#if defined(DJV_LINUX)
+
+// The NUMA memory policies from <numaif.h>, which isn't always installed.
+
+const int numa_preferred  = 1;
+const int numa_interleave = 3;
+
+const size_t numa_mask_size = 4;
+
+// Read the online NUMA nodes, for example "0-1,4".
+
+int numa_online(unsigned long * mask)
+{
+    for (size_t i = 0; i < numa_mask_size; ++i)
+    {
+        mask[i] = 0;
+    }
+
+    const size_t bits = sizeof(unsigned long) * 8;
+
+    int out = 0;
+
+    FILE * f = ::fopen("/sys/devices/system/node/online", "r");
+
+    if (! f)
+    {
+        return out;
+    }
+
+    int a = 0;
+    int b = 0;
+
+    while (::fscanf(f, "%d", &a) == 1)
+    {
+        b = a;
+
+        const int c = ::fgetc(f);
+
+        if ('-' == c && ::fscanf(f, "%d", &b) == 1)
+        {
+            ::fgetc(f);
+        }
+
+        for (int i = a; i <= b && i < int(numa_mask_size * bits); ++i)
+        {
+            mask[i / bits] |= 1UL << (i % bits);
+
+            out = Math::max(out, i + 1);
+        }
+    }
+
+    ::fclose(f);
+
+    return out;
+}
+
+void numa_bind(void * in, size_t size, Memory::NUMA numa, int node)
+{
+    unsigned long mask [numa_mask_size];
+
+    const int nodes = numa_online(mask);
+
+    if (nodes < 2)
+    {
+        return;
+    }
+
+    int mode = numa_preferred;
+
+    switch (numa)
+    {
+        case Memory::NUMA_LOCAL:
+
+            node = Memory::numa_node();
+
+            break;
+
+        case Memory::NUMA_INTERLEAVE:
+
+            mode = numa_interleave;
+
+            break;
+
+        default: break;
+    }
+
+    // A preferred node falls back to the other nodes when it is full instead
+    // of failing the allocation.
+
+    if (mode == numa_preferred)
+    {
+        if (node < 0 || node >= nodes)
+        {
+            return;
+        }
+
+        const size_t bits = sizeof(unsigned long) * 8;
+
+        for (size_t i = 0; i < numa_mask_size; ++i)
+        {
+            mask[i] = 0;
+        }
+
+        mask[node / bits] = 1UL << (node % bits);
+    }
+
+    ::syscall(
+        SYS_mbind,
+        in,
+        size,
+        mode,
+        mask,
+        numa_mask_size * sizeof(unsigned long) * 8 + 1,
+        0);
+}
+
+// Map the buffer so that it starts on a huge page boundary, and set the
+// policy before the pages are first touched.
+
+void * large_get(size_t in, const Memory::Policy & policy, int node)
+{
+    const size_t page = Memory::align;
+    const size_t huge = Memory::huge_page_size;
+
+    const size_t size = (in + page - 1) / page * page;
+
+    void * p = ::mmap(
+        0,
+        size + huge - page,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+
+    if (MAP_FAILED == p)
+    {
+        return 0;
+    }
+
+    uint8_t * start = reinterpret_cast<uint8_t *>(p);
+
+    uint8_t * out = reinterpret_cast<uint8_t *>(
+        (reinterpret_cast<size_t>(start) + huge - 1) / huge * huge);
+
+    if (out > start)
+    {
+        ::munmap(start, out - start);
+    }
+
+    const size_t tail = (start + size + huge - page) - (out + size);
+
+    if (tail)
+    {
+        ::munmap(out + size, tail);
+    }
+
+#if defined(MADV_HUGEPAGE)
+
+    if (policy.huge_pages)
+    {
+        ::madvise(out, size, MADV_HUGEPAGE);
+    }
+
+#endif
+
+    if (policy.numa != Memory::NUMA_DEFAULT)
+    {
+        numa_bind(out, size, policy.numa, node);
+    }
+
+    return out;
+}
+
+#endif // DJV_LINUX
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Memory::Policy
+//------------------------------------------------------------------------------
+
+Memory::Policy::Policy() :
+    large_size(4 * 1024 * 1024),
+    huge_pages(true),
+    numa      (NUMA_DEFAULT),
+    numa_node (-1)
+{}
+
 //------------------------------------------------------------------------------
 // Memory
 //------------------------------------------------------------------------------
@@ -53,8 +576,125 @@ const uint64_t Memory::terabyte = gigabyte * 1024;
 
 const size_t Memory::align = 4096;
 
+const size_t Memory::huge_page_size = 2 * 1024 * 1024;
+
+const size_t Memory::copy_large_size = 8 * 1024 * 1024;
+
+Memory::Stats::Stats() :
+    live(0),
+    peak(0)
+{}
+
+void Memory::stats_add(TAG tag, int64_t in)
+{
+    Stats_Counter & counter = stats_counter[tag];
+
+    atomic_max(counter.peak, atomic_add(counter.live, in));
+
+    Stats_Counter & total = stats_counter[_TAG_SIZE];
+
+    atomic_max(total.peak, atomic_add(total.live, in));
+}
+
+Memory::Stats Memory::stats(TAG in)
+{
+    return stats_get(stats_counter[in]);
+}
+
+Memory::Stats Memory::stats()
+{
+    return stats_get(stats_counter[_TAG_SIZE]);
+}
+
+void Memory::stats_reset()
+{
+    for (int i = 0; i <= _TAG_SIZE; ++i)
+    {
+        stats_counter[i].peak = stats_counter[i].live;
+    }
+}
+
+void Memory::policy(const Policy & in)
+{
+    Large * data = large();
+
+    Mutex_Scope scope(data->mutex);
+
+    data->policy = in;
+    data->node   = in.numa_node >= 0 ? in.numa_node : numa_node();
+}
+
+Memory::Policy Memory::policy()
+{
+    Large * data = large();
+
+    Mutex_Scope scope(data->mutex);
+
+    return data->policy;
+}
+
+int Memory::numa_node()
+{
+#if defined(DJV_LINUX) && defined(SYS_getcpu)
+
+    unsigned int cpu  = 0;
+    unsigned int node = 0;
+
+    if (::syscall(SYS_getcpu, &cpu, &node, 0) == 0)
+    {
+        return static_cast<int>(node);
+    }
+
+#endif
+
+    return -1;
+}
+
+int Memory::numa_nodes()
+{
+#if defined(DJV_LINUX)
+
+    unsigned long mask [numa_mask_size];
+
+    return Math::max(numa_online(mask), 1);
+
+#else
+
+    return 1;
+
+#endif
+}
+
 void * Memory::get(size_t in)
 {
+#if defined(DJV_LINUX)
+
+    Large * data = large();
+
+    Policy policy;
+    int    node = -1;
+
+    {
+        Mutex_Scope scope(data->mutex);
+
+        policy = data->policy;
+        node   = data->node;
+    }
+
+    if (policy.large_size && in >= policy.large_size)
+    {
+        if (void * out = large_get(in, policy, node))
+        {
+            Mutex_Scope scope(data->mutex);
+
+            data->blocks[out] = (in + align - 1) / align * align;
+
+            return out;
+        }
+    }
+
+#endif
+
     //! \todo Is this still necessary?
 
 #if ! (defined(DJV_WINDOWS) || defined(DJV_FREEBSD) || defined(DJV_OSX))
@@ -66,12 +706,62 @@ void * Memory::get(size_t in)
 
 void Memory::del(void * in)
 {
+#if defined(DJV_LINUX)
+
+    // Large allocations always start on a huge page boundary, so most other
+    // pointers don't need to be looked up.
+
+    if (in && ! (reinterpret_cast<size_t>(in) % huge_page_size))
+    {
+        Large * data = large();
+
+        size_t size = 0;
+
+        {
+            Mutex_Scope scope(data->mutex);
+
+            Large_Map::iterator i = data->blocks.find(in);
+
+            if (i != data->blocks.end())
+            {
+                size = i->second;
+
+                data->blocks.erase(i);
+            }
+        }
+
+        if (size)
+        {
+            ::munmap(in, size);
+
+            return;
+        }
+    }
+
+#endif
+
     ::free(in);
 }
 
 void Memory::copy(const void * in, void * out, size_t size)
 {
-    ::memcpy(out, in, size);
+    if (size < copy_large_size)
+    {
+        ::memcpy(out, in, size);
+
+        return;
+    }
+
+    Copy fnc(
+        reinterpret_cast<const uint8_t *>(in),
+        reinterpret_cast<uint8_t *>(out),
+        size);
+
+    Thread_Pool::global()->parallel_for(
+        0,
+        static_cast<int>((size + copy_block - 1) / copy_block),
+        fnc,
+        4);
 }
 
 void Memory::zero(void * out, size_t size)
@@ -84,6 +774,72 @@ int Memory::compare(const void * a, const void * b, size_t size)
     return ::memcmp(a, b, size);
 }
 
+void Memory::endian(
+    void * in,
+    size_t size,
+    size_t word_size)
+{
+    if (word_size > 1)
+    {
+        endian(in, in, size, word_size);
+    }
+}
+
+void Memory::endian(
+    const void * in,
+    void *       out,
+    size_t       size,
+    size_t       word_size)
+{
+    if (word_size != 2 && word_size != 4 && word_size != 8)
+    {
+        if (in != out)
+        {
+            copy(in, out, size * word_size);
+        }
+
+        return;
+    }
+
+    const uint8_t * in_p = reinterpret_cast<const uint8_t *>(in);
+
+    uint8_t * out_p = reinterpret_cast<uint8_t *>(out);
+
+#if defined(DJV_CPU_SIMD)
+
+    // Small conversions such as file header fields aren't worth the SIMD
+    // setup.
+
+    const size_t bytes = size * word_size;
+
+    if (bytes >= 32)
+    {
+        const uint8_t * mask =
+            endian_mask[2 == word_size ? 0 : (4 == word_size ? 1 : 2)];
+
+        size_t done = 0;
+
+        const Cpu & cpu = Cpu::global();
+
+        if (cpu.avx2)
+        {
+            done = endian_avx2(in_p, out_p, bytes, mask);
+        }
+        else if (cpu.ssse3)
+        {
+            done = endian_ssse3(in_p, out_p, bytes, mask);
+        }
+
+        in_p  += done;
+        out_p += done;
+        size  -= done / word_size;
+    }
+
+#endif // DJV_CPU_SIMD
+
+    endian_scalar(in_p, out_p, size, word_size);
+}
+
 const List<String> & Memory::label_endian()
 {
     static const List<String> data = List<String>() <<
@@ -97,9 +853,101 @@ const List<String> & Memory::label_endian()
     return data;
 }
 
+String Memory::label_size(uint64_t in)
+{
+    static const uint64_t size [] =
+    {
+        terabyte,
+        gigabyte,
+        megabyte,
+        kilobyte
+    };
+
+    static const char * label [] =
+    {
+        "TB",
+        "GB",
+        "MB",
+        "KB"
+    };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        if (in >= size[i])
+        {
+            return String_Format("%% %%").
+                arg(in / static_cast<double>(size[i]), 0, 2).
+                arg(label[i]);
+        }
+    }
+
+    return String_Format("%% bytes").arg(in);
+}
+
+List<String> Memory::label_stats()
+{
+    List<String> out;
+
+    for (int i = 0; i < _TAG_SIZE; ++i)
+    {
+        const Stats tmp = stats(static_cast<TAG>(i));
+
+        if (! tmp.peak)
+            continue;
+
+        out += String_Format("%% = %% (peak %%)").
+            arg(label_tag()[i]).
+            arg(label_size(tmp.live)).
+            arg(label_size(tmp.peak));
+    }
+
+    const Stats tmp = stats();
+
+    out += String_Format("Total = %% (peak %%)").
+        arg(label_size(tmp.live)).
+        arg(label_size(tmp.peak));
+
+    out += String_Format("Pool = %%").
+        arg(label_size(Memory_Pool::global()->stats().resident));
+
+    return out;
+}
+
+const List<String> & Memory::label_tag()
+{
+    static const List<String> data = List<String>() <<
+        "Other" <<
+        "Images" <<
+        "Cache" <<
+        "Temporary" <<
+        "OpenGL" <<
+        "LUT" <<
+        "File" <<
+        "Memory-map";
+
+    DJV_ASSERT(data.size() == _TAG_SIZE);
+
+    return data;
+}
+
+const List<String> & Memory::label_numa()
+{
+    static const List<String> data = List<String>() <<
+        "Default" <<
+        "Local" <<
+        "Node" <<
+        "Interleave";
+
+    DJV_ASSERT(data.size() == _NUMA_SIZE);
+
+    return data;
+}
+
 //------------------------------------------------------------------------------
 
 _DJV_STRING_OPERATOR_LABEL(Memory::ENDIAN, Memory::label_endian())
+_DJV_STRING_OPERATOR_LABEL(Memory::TAG, Memory::label_tag())
+_DJV_STRING_OPERATOR_LABEL(Memory::NUMA, Memory::label_numa())
 
 } // djv
 
@@ -54,6 +54,13 @@ struct DJV_CORE_EXPORT Memory
 
     static const size_t align; //!< Memory alignment.
 
+    static const size_t huge_page_size; //!< Huge page size.
+
+    //! Copies of at least this size are split across the thread pool and
+    //! bypass the caches.
+
+    static const size_t copy_large_size;
+
     //! Machine endian
 
     enum ENDIAN
@@ -64,6 +71,101 @@ struct DJV_CORE_EXPORT Memory
         _ENDIAN_SIZE
     };
 
+    //! Memory accounting tags.
+
+    enum TAG
+    {
+        TAG_OTHER,   //!< Other memory
+        TAG_IMAGE,   //!< Images
+        TAG_CACHE,   //!< Cached images
+        TAG_TEMP,    //!< Temporary buffers used for loading and saving
+        TAG_GL,      //!< OpenGL textures
+        TAG_LUT,     //!< Lookup tables
+        TAG_FILE,    //!< File read buffers
+        TAG_MMAP,    //!< Memory-mapped files
+
+        _TAG_SIZE
+    };
+
+    //! NUMA placement of large allocations.
+
+    enum NUMA
+    {
+        NUMA_DEFAULT,     //!< Use the operating system default
+        NUMA_LOCAL,       //!< Prefer the node of the allocating thread
+        NUMA_NODE,        //!< Prefer the node given by the policy
+        NUMA_INTERLEAVE,  //!< Interleave pages across all nodes
+
+        _NUMA_SIZE
+    };
+
+    //! Allocation policy for large buffers such as image frames. Buffers of
+    //! at least the given size are aligned to huge page boundaries, which can
+    //! reduce TLB misses, and placed on a NUMA node before they are first
+    //! used. Only Linux currently supports the policy; other platforms use
+    //! the normal allocator.
+
+    struct DJV_CORE_EXPORT Policy
+    {
+        Policy();
+
+        size_t large_size; //!< Minimum size of large buffers, zero disables.
+        bool   huge_pages; //!< Whether huge pages are used when available.
+        NUMA   numa;       //!< NUMA placement.
+        int    numa_node;  //!< NUMA node for NUMA_NODE, -1 for the current.
+    };
+
+    //! Set the allocation policy. When the NUMA node is -1 it is set to the
+    //! node of the calling thread, so the application's main thread can
+    //! request that frames are placed next to it even when they are
+    //! allocated by worker threads.
+
+    static void policy(const Policy &);
+
+    //! Get the allocation policy.
+
+    static Policy policy();
+
+    //! Get the NUMA node of the calling thread, or -1 if it is unknown.
+
+    static int numa_node();
+
+    //! Get the number of NUMA nodes.
+
+    static int numa_nodes();
+
+    //! Memory accounting statistics.
+
+    struct DJV_CORE_EXPORT Stats
+    {
+        Stats();
+
+        uint64_t live; //!< Bytes currently in use.
+        uint64_t peak; //!< Largest number of bytes in use.
+    };
+
+    //! Add bytes to the memory accounting. Negative values remove bytes.
+    //! Memory_Buffer calls this when it allocates and frees memory.
+
+    static void stats_add(TAG, int64_t);
+
+    //! Get the memory accounting for a tag.
+
+    static Stats stats(TAG);
+
+    //! Get the memory accounting for all tags.
+
+    static Stats stats();
+
+    //! Reset the peak values to the current values.
+
+    static void stats_reset();
+
+    //! Get the memory accounting labels, one for each tag that has been used
+    //! followed by the totals and the memory kept by the Memory_Pool.
+
+    static List<String> label_stats();
+
     //! Allocate memory.
 
     static void * get(size_t);
@@ -72,7 +174,9 @@ struct DJV_CORE_EXPORT Memory
 
     static void del(void *);
 
-    //! Copy memory.
+    //! Copy memory. The input and output must not overlap. Large copies
+    //! such as image frames are split across the global thread pool and use
+    //! non-temporal stores.
 
     static void copy(const void *, void *, size_t size);
 
@@ -97,16 +201,17 @@ struct DJV_CORE_EXPORT Memory
 
     static int compare(const void *, const void *, size_t size);
 
-    //! Endian conversion.
+    //! Endian conversion. The size is given in words.
 
-    static inline void endian(
+    static void endian(
         void *,
         size_t size,
         size_t word_size);
 
-    //! Endian conversion.
+    //! Endian conversion while copying. The size is given in words, and the
+    //! input and output may be the same.
 
-    static inline void endian(
+    static void endian(
         const void *,
         void *,
         size_t size,
@@ -119,14 +224,28 @@ struct DJV_CORE_EXPORT Memory
     //! Get endian labels.
 
     static const List<String> & label_endian();
+
+    //! Get memory accounting tag labels.
+
+    static const List<String> & label_tag();
+
+    //! Get NUMA placement labels.
+
+    static const List<String> & label_numa();
 };
 
 //------------------------------------------------------------------------------
 
 DJV_CORE_EXPORT
 String & operator >> (String &, Memory::ENDIAN &) throw (String);
+DJV_CORE_EXPORT
+String & operator >> (String &, Memory::TAG &) throw (String);
+DJV_CORE_EXPORT
+String & operator >> (String &, Memory::NUMA &) throw (String);
 
 DJV_CORE_EXPORT String & operator << (String &, Memory::ENDIAN);
+DJV_CORE_EXPORT String & operator << (String &, Memory::TAG);
+DJV_CORE_EXPORT String & operator << (String &, Memory::NUMA);
 
 } // djv
 
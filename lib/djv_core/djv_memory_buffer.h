@@ -34,7 +34,7 @@
 #ifndef DJV_MEMORY_BUFFER_H
 #define DJV_MEMORY_BUFFER_H
 
-#include <djv_type.h>
+#include <djv_memory.h>
 
 namespace djv
 {
@@ -43,6 +43,13 @@ namespace djv
 //! \class Memory_Buffer
 //!
 //! This class provides a memory buffer.
+//!
+//! Large buffers are allocated from the global Memory_Pool. The allocated
+//! capacity is kept when the buffer shrinks a little, so changing between
+//! similar sizes does not re-allocate.
+//!
+//! The allocated memory is counted in the Memory accounting statistics under
+//! the buffer's tag.
 //------------------------------------------------------------------------------
 
 template<typename T>
@@ -68,7 +75,8 @@ public:
 
     inline Memory_Buffer & operator = (const Memory_Buffer &);
 
-    //! Set the size.
+    //! Set the size. The contents are not preserved if the memory is
+    //! re-allocated.
 
     inline void size(size_t);
 
@@ -76,6 +84,14 @@ public:
 
     inline size_t size() const;
 
+    //! Reserve memory for the given size. The contents are preserved.
+
+    inline void reserve(size_t);
+
+    //! Get the number of elements that fit without re-allocating.
+
+    inline size_t capacity() const;
+
     //! Get a pointer to the memory.
 
     inline T * data();
@@ -88,16 +104,32 @@ public:
 
     inline void zero();
 
+    //! Swap the memory with another buffer. The tags are also swapped.
+
+    inline void swap(Memory_Buffer &);
+
+    //! Set the memory accounting tag.
+
+    inline void tag(Memory::TAG);
+
+    //! Get the memory accounting tag.
+
+    inline Memory::TAG tag() const;
+
     inline T * operator () ();
 
     inline const T * operator () () const;
 
 private:
 
+    inline void alloc(size_t);
     inline void del();
 
     T * _data;
     size_t _size;
+    size_t _capacity;
+    size_t _bytes;
+    Memory::TAG _tag;
 };
 
 } // djv
@@ -32,6 +32,9 @@
 //! \file djv_memory_buffer_inline.h
 
 #include <djv_memory.h>
+#include <djv_memory_pool.h>
+
+#include <algorithm>
 
 namespace djv
 {
@@ -42,22 +45,31 @@ namespace djv
 
 template<typename T>
 inline Memory_Buffer<T>::Memory_Buffer() :
-    _data(0),
-    _size(0)
+    _data    (0),
+    _size    (0),
+    _capacity(0),
+    _bytes   (0),
+    _tag     (Memory::TAG_OTHER)
 {}
 
 template<typename T>
 inline Memory_Buffer<T>::Memory_Buffer(const Memory_Buffer & in) :
-    _data(0),
-    _size(0)
+    _data    (0),
+    _size    (0),
+    _capacity(0),
+    _bytes   (0),
+    _tag     (Memory::TAG_OTHER)
 {
     *this = in;
 }
 
 template<typename T>
 inline Memory_Buffer<T>::Memory_Buffer(size_t in) :
-    _data(0),
-    _size(0)
+    _data    (0),
+    _size    (0),
+    _capacity(0),
+    _bytes   (0),
+    _tag     (Memory::TAG_OTHER)
 {
     size(in);
 }
@@ -89,10 +101,20 @@ inline void Memory_Buffer<T>::size(size_t in)
         return;
     }
 
-    del();
+    // Keep the memory unless the buffer grows or shrinks to less than half of
+    // the capacity.
+
+    if (! in || in > _capacity || in < _capacity / 2)
+    {
+        del();
+
+        if (in)
+        {
+            alloc(in);
+        }
+    }
 
     _size = in;
-    _data = reinterpret_cast<T *>(Memory::get(_size * sizeof(T) + 1));
 
     //zero(); //! \todo Is this still necessary?
 }
@@ -103,6 +125,38 @@ inline size_t Memory_Buffer<T>::size() const
     return _size;
 }
 
+template<typename T>
+inline void Memory_Buffer<T>::reserve(size_t in)
+{
+    if (in <= _capacity)
+    {
+        return;
+    }
+
+    T *          data  = _data;
+    const size_t size  = _size;
+    const size_t bytes = _bytes;
+
+    alloc(in);
+
+    if (data)
+    {
+        Memory::copy(data, _data, size * sizeof(T));
+
+        Memory_Pool::global()->del(data, bytes);
+
+        Memory::stats_add(_tag, -static_cast<int64_t>(bytes));
+    }
+
+    _size = size;
+}
+
+template<typename T>
+inline size_t Memory_Buffer<T>::capacity() const
+{
+    return _capacity;
+}
+
 template<typename T>
 inline T * Memory_Buffer<T>::data()
 {
@@ -121,6 +175,39 @@ inline void Memory_Buffer<T>::zero()
     Memory::zero(_data, _size * sizeof(T));
 }
 
+template<typename T>
+inline void Memory_Buffer<T>::swap(Memory_Buffer<T> & in)
+{
+    std::swap(_data, in._data);
+    std::swap(_size, in._size);
+    std::swap(_capacity, in._capacity);
+    std::swap(_bytes, in._bytes);
+    std::swap(_tag, in._tag);
+}
+
+template<typename T>
+inline void Memory_Buffer<T>::tag(Memory::TAG in)
+{
+    if (in == _tag)
+    {
+        return;
+    }
+
+    if (_data)
+    {
+        Memory::stats_add(_tag, -static_cast<int64_t>(_bytes));
+        Memory::stats_add(in, _bytes);
+    }
+
+    _tag = in;
+}
+
+template<typename T>
+inline Memory::TAG Memory_Buffer<T>::tag() const
+{
+    return _tag;
+}
+
 template<typename T>
 inline T * Memory_Buffer<T>::operator () ()
 {
@@ -133,14 +220,27 @@ inline const T * Memory_Buffer<T>::operator () () const
     return _data;
 }
 
+template<typename T>
+inline void Memory_Buffer<T>::alloc(size_t in)
+{
+    _bytes    = Memory_Pool::capacity(in * sizeof(T) + 1);
+    _capacity = (_bytes - 1) / sizeof(T);
+    _data     = reinterpret_cast<T *>(Memory_Pool::global()->get(_bytes));
+
+    Memory::stats_add(_tag, _bytes);
+}
+
 template<typename T>
 inline void Memory_Buffer<T>::del()
 {
     if (_data)
     {
-        Memory::del(_data);
-        _data = 0;
-        _size = 0;
+        Memory_Pool::global()->del(_data, _bytes);
+        Memory::stats_add(_tag, -static_cast<int64_t>(_bytes));
+        _data     = 0;
+        _size     = 0;
+        _capacity = 0;
+        _bytes    = 0;
     }
 }
 
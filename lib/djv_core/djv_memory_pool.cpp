@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_memory_pool.cpp
+
+#include <djv_memory_pool.h>
+
+#include <djv_math.h>
+#include <djv_memory.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// Memory_Pool::Stats
+//------------------------------------------------------------------------------
+
+Memory_Pool::Stats::Stats() :
+    hits    (0),
+    misses  (0),
+    used    (0),
+    resident(0)
+{}
+
+//------------------------------------------------------------------------------
+// Memory_Pool
+//------------------------------------------------------------------------------
+
+const size_t Memory_Pool::min_size = 256 * 1024;
+
+const uint64_t Memory_Pool::default_max_bytes = 512 * Memory::megabyte;
+
+Memory_Pool::Memory_Pool() :
+    _max_bytes(default_max_bytes)
+{}
+
+Memory_Pool::~Memory_Pool()
+{
+    clear();
+}
+
+size_t Memory_Pool::capacity(size_t in)
+{
+    if (in < min_size)
+    {
+        return in;
+    }
+
+    // Round up to one of eight size classes between each power of two, which
+    // wastes at most an eighth of the block.
+
+    size_t step = 1;
+
+    while (step <= in / 2)
+    {
+        step *= 2;
+    }
+
+    step /= 8;
+
+    return (in + step - 1) / step * step;
+}
+
+void * Memory_Pool::get(size_t size)
+{
+    //DJV_DEBUG("Memory_Pool::get");
+    //DJV_DEBUG_PRINT("size = " << size);
+
+    if (size < min_size)
+    {
+        return Memory::get(size);
+    }
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        _stats.used += size;
+
+        Block_Map::iterator i = _blocks.find(size);
+
+        if (i != _blocks.end() && i->second.size())
+        {
+            void * out = i->second.back();
+            i->second.pop_back();
+
+            _stats.resident -= size;
+            ++_stats.hits;
+
+            return out;
+        }
+
+        ++_stats.misses;
+    }
+
+    // Allocate the block without holding the lock.
+
+    void * out = Memory::get(size);
+
+    if (! out)
+    {
+        Mutex_Scope scope(_mutex);
+
+        _stats.used -= size;
+    }
+
+    return out;
+}
+
+void Memory_Pool::del(void * in, size_t size)
+{
+    //DJV_DEBUG("Memory_Pool::del");
+    //DJV_DEBUG_PRINT("size = " << size);
+
+    if (! in)
+    {
+        return;
+    }
+
+    if (size < min_size)
+    {
+        Memory::del(in);
+
+        return;
+    }
+
+    Mutex_Scope scope(_mutex);
+
+    _stats.used -= size;
+
+    // Make room for the block by freeing the largest blocks. Blocks that are
+    // larger than the maximum are not kept.
+
+    if (size > _max_bytes)
+    {
+        Memory::del(in);
+
+        return;
+    }
+
+    trim(_max_bytes - size);
+
+    _blocks[size].push_back(in);
+
+    _stats.resident += size;
+}
+
+void Memory_Pool::max_bytes(uint64_t in)
+{
+    Mutex_Scope scope(_mutex);
+
+    _max_bytes = in;
+
+    trim(_max_bytes);
+}
+
+uint64_t Memory_Pool::max_bytes() const
+{
+    Mutex_Scope scope(_mutex);
+
+    return _max_bytes;
+}
+
+void Memory_Pool::clear()
+{
+    Mutex_Scope scope(_mutex);
+
+    trim(0);
+}
+
+Memory_Pool::Stats Memory_Pool::stats() const
+{
+    Mutex_Scope scope(_mutex);
+
+    return _stats;
+}
+
+void Memory_Pool::stats_reset()
+{
+    Mutex_Scope scope(_mutex);
+
+    _stats.hits   = 0;
+    _stats.misses = 0;
+}
+
+namespace
+{
+
+Memory_Pool * _global = 0;
+Mutex         _global_mutex;
+
+} // namespace
+
+Memory_Pool * Memory_Pool::global()
+{
+    Mutex_Scope scope(_global_mutex);
+
+    if (! _global)
+    {
+        _global = new Memory_Pool;
+    }
+
+    return _global;
+}
+
+void Memory_Pool::trim(uint64_t in)
+{
+    Block_Map::iterator i = _blocks.end();
+
+    while (i != _blocks.begin() && _stats.resident > in)
+    {
+        --i;
+
+        while (i->second.size() && _stats.resident > in)
+        {
+            Memory::del(i->second.back());
+            i->second.pop_back();
+
+            _stats.resident -= i->first;
+        }
+    }
+}
+
+} // djv
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_memory_pool.h
+
+#ifndef DJV_MEMORY_POOL_H
+#define DJV_MEMORY_POOL_H
+
+#include <djv_list.h>
+#include <djv_thread.h>
+
+#include <map>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \class Memory_Pool
+//!
+//! This class provides a pool of large memory blocks, such as image frames,
+//! that are recycled instead of being returned to the system. Sizes are
+//! rounded up to a size class so that blocks can be re-used for images that
+//! are about the same size. The pool is thread safe.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Memory_Pool
+{
+public:
+
+    //! Constructor.
+
+    Memory_Pool();
+
+    //! Destructor.
+
+    ~Memory_Pool();
+
+    //! Get the size of the block that is allocated for the given size.
+    //! Sizes smaller than min_size are not pooled and are returned
+    //! unchanged.
+
+    static size_t capacity(size_t);
+
+    //! Allocate memory. The size should be a value returned by capacity().
+
+    void * get(size_t);
+
+    //! De-allocate memory. The size must be the same as when it was allocated.
+
+    void del(void *, size_t);
+
+    //! Set the maximum number of bytes kept for re-use.
+
+    void max_bytes(uint64_t);
+
+    //! Get the maximum number of bytes kept for re-use.
+
+    uint64_t max_bytes() const;
+
+    //! Free the memory that is kept for re-use.
+
+    void clear();
+
+    //! Statistics.
+
+    struct DJV_CORE_EXPORT Stats
+    {
+        Stats();
+
+        uint64_t hits;     //!< Allocations that re-used a block.
+        uint64_t misses;   //!< Allocations that needed a new block.
+        uint64_t used;     //!< Bytes currently allocated from the pool.
+        uint64_t resident; //!< Bytes kept for re-use.
+    };
+
+    //! Get the statistics.
+
+    Stats stats() const;
+
+    //! Reset the hit and miss counts.
+
+    void stats_reset();
+
+    //! The smallest size that is pooled.
+
+    static const size_t min_size;
+
+    //! The default maximum number of bytes kept for re-use.
+
+    static const uint64_t default_max_bytes;
+
+    //! Get the global memory pool.
+
+    static Memory_Pool * global();
+
+private:
+
+    void trim(uint64_t);
+
+    Memory_Pool(const Memory_Pool &);
+    Memory_Pool & operator = (const Memory_Pool &);
+
+    typedef std::map<size_t, List<void *> > Block_Map;
+
+    Block_Map     _blocks;
+    uint64_t      _max_bytes;
+    Stats         _stats;
+    mutable Mutex _mutex;
+};
+
+} // djv
+
+#endif // DJV_MEMORY_POOL_H
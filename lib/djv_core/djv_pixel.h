@@ -301,6 +301,24 @@ struct DJV_CORE_EXPORT Pixel
         int size = 1,
         int stride = 1,
         bool bgr = false);
+
+    //! Pixel conversion function.
+
+    typedef void (Convert_Fnc)(
+        const void * in,
+        void *       out,
+        int          size,
+        int          stride);
+
+    //! Get the pixel conversion function. The function can be looked up once
+    //! and then used for each scanline of an image. Unlike convert() it is
+    //! not split across threads.
+
+    static Convert_Fnc * convert_fnc(
+        PIXEL in,
+        PIXEL out,
+        int stride = 1,
+        bool bgr = false);
 };
 
 //------------------------------------------------------------------------------
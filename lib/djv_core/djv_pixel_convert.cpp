@@ -33,328 +33,583 @@
 
 #include <djv_pixel.h>
 
+#include <djv_pixel_convert_private.h>
+
 #include <djv_memory.h>
+#include <djv_thread_pool.h>
 
 namespace djv
 {
 
-//------------------------------------------------------------------------------
-// Format Conversion
-//------------------------------------------------------------------------------
-
-// Luminance.
-
-#define _L_L_(IN0, IN_T, OUT0, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0);
-#define _L_LA_(IN0, IN_T, OUT0, OUT1, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT1 = PIXEL_##OUT_T##_ONE;
-#define _L_RGB_(IN0, IN_T, OUT0, OUT1, OUT2, OUT_T) \
-    OUT0 = OUT1 = OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN0);
-#define _L_RGBA_(IN0, IN_T, OUT0, OUT1, OUT2, OUT3, OUT_T) \
-    OUT0 = OUT1 = OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT3 = PIXEL_##OUT_T##_ONE;
-
-#define _L_L(IN, IN_T, OUT, OUT_T) \
-    _L_L_(IN[0], IN_T, OUT[0], OUT_T)
-#define _L_LA(IN, IN_T, OUT, OUT_T) \
-    _L_LA_(IN[0], IN_T, OUT[0], OUT[1], OUT_T)
-#define _L_RGB(IN, IN_T, OUT, OUT_T) \
-    _L_RGB_(IN[0], IN_T, OUT[0], OUT[1], OUT[2], OUT_T)
-#define _L_RGB_U10(IN, IN_T, OUT, OUT_T) \
-    _L_RGB_(IN[0], IN_T, OUT->r, OUT->g, OUT->b, OUT_T)
-#define _L_RGBA(IN, IN_T, OUT, OUT_T) \
-    _L_RGBA_(IN[0], IN_T, OUT[0], OUT[1], OUT[2], OUT[3], OUT_T)
-
-// Luminance alpha.
-
-#define _LA_L_(IN0, IN1, IN_T, OUT0, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0);
-#define _LA_LA_(IN0, IN1, IN_T, OUT0, OUT1, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT1 = PIXEL_##IN_T##_TO_##OUT_T(IN1);
-#define _LA_RGB_(IN0, IN1, IN_T, OUT0, OUT1, OUT2, OUT_T) \
-    OUT0 = OUT1 = OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN0);
-#define _LA_RGBA_(IN0, IN1, IN_T, OUT0, OUT1, OUT2, OUT3, OUT_T) \
-    OUT0 = OUT1 = OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT3 = PIXEL_##IN_T##_TO_##OUT_T(IN1);
-
-#define _LA_L(IN, IN_T, OUT, OUT_T) \
-    _LA_L_(IN[0], IN[1], IN_T, OUT[0], OUT_T)
-#define _LA_LA(IN, IN_T, OUT, OUT_T) \
-    _LA_LA_(IN[0], IN[1], IN_T, OUT[0], OUT[1], OUT_T)
-#define _LA_RGB(IN, IN_T, OUT, OUT_T) \
-    _LA_RGB_(IN[0], IN[1], IN_T, OUT[0], OUT[1], OUT[2], OUT_T)
-#define _LA_RGB_U10(IN, IN_T, OUT, OUT_T) \
-    _LA_RGB_(IN[0], IN[1], IN_T, OUT->r, OUT->g, OUT->b, OUT_T)
-#define _LA_RGBA(IN, IN_T, OUT, OUT_T) \
-    _LA_RGBA_(IN[0], IN[1], IN_T, OUT[0], OUT[1], OUT[2], OUT[3], OUT_T)
-
-// RGB.
-
-#define _RGB_L_(IN0, IN1, IN2, IN_T, OUT0, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T((IN0 + IN1 + IN2) / Pixel::IN_T##_T(3));
-#define _RGB_LA_(IN0, IN1, IN2, IN_T, OUT0, OUT1, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T((IN0 + IN1 + IN2) / Pixel::IN_T##_T(3)); \
-    OUT1 = PIXEL_##OUT_T##_ONE;
-#define _RGB_RGB_(IN0, IN1, IN2, IN_T, OUT0, OUT1, OUT2, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT1 = PIXEL_##IN_T##_TO_##OUT_T(IN1); \
-    OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN2);
-#define _RGB_RGBA_(IN0, IN1, IN2, IN_T, OUT0, OUT1, OUT2, OUT3, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT1 = PIXEL_##IN_T##_TO_##OUT_T(IN1); \
-    OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN2); \
-    OUT3 = PIXEL_##OUT_T##_ONE;
-
-#define _RGB_L(IN, IN_T, OUT, OUT_T) \
-    _RGB_L_(IN[0], IN[1], IN[2], IN_T, OUT[0], OUT_T)
-#define _RGB_LA(IN, IN_T, OUT, OUT_T) \
-    _RGB_LA_(IN[0], IN[1], IN[2], IN_T, OUT[0], OUT[1], OUT_T)
-#define _RGB_RGB(IN, IN_T, OUT, OUT_T) \
-    _RGB_RGB_(IN[bgr ? 2 : 0], IN[1], IN[bgr ? 0 : 2], IN_T, \
-        OUT[0], OUT[1], OUT[2], OUT_T)
-#define _RGB_RGB_U10(IN, IN_T, OUT, OUT_T) \
-    _RGB_RGB_(IN[bgr ? 2 : 0], IN[1], IN[bgr ? 0 : 2], IN_T, \
-        OUT->r, OUT->g, OUT->b, OUT_T)
-#define _RGB_RGBA(IN, IN_T, OUT, OUT_T) \
-    _RGB_RGBA_(IN[bgr ? 2 : 0], IN[1], IN[bgr ? 0 : 2], IN_T, \
-        OUT[0], OUT[1], OUT[2], OUT[3], OUT_T)
-
-#define _RGB_U10_L(IN, IN_T, OUT, OUT_T) \
-    _RGB_L_(IN->r, IN->g, IN->b, IN_T, OUT[0], OUT_T)
-#define _RGB_U10_LA(IN, IN_T, OUT, OUT_T) \
-    _RGB_LA_(IN->r, IN->g, IN->b, IN_T, OUT[0], OUT[1], OUT_T)
-#define _RGB_U10_RGB(IN, IN_T, OUT, OUT_T) \
-    _RGB_RGB_(bgr ? IN->b : IN->r, IN->g, bgr ? IN->r : IN->b, IN_T, \
-        OUT[0], OUT[1], OUT[2], OUT_T)
-#define _RGB_U10_RGBA(IN, IN_T, OUT, OUT_T) \
-    _RGB_RGBA_(bgr ? IN->b : IN->r, IN->g, bgr ? IN->r : IN->b, IN_T, \
-        OUT[0], OUT[1], OUT[2], OUT[3], OUT_T)
-
-// RGBA.
-
-#define _RGBA_L_(IN0, IN1, IN2, IN3, IN_T, OUT0, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T((IN0 + IN1 + IN2) / Pixel::IN_T##_T(3));
-#define _RGBA_LA_(IN0, IN1, IN2, IN3, IN_T, OUT0, OUT1, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T((IN0 + IN1 + IN2) / Pixel::IN_T##_T(3)); \
-    OUT1 = PIXEL_##IN_T##_TO_##OUT_T(IN3);
-#define _RGBA_RGB_(IN0, IN1, IN2, IN3, IN_T, OUT0, OUT1, OUT2, OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT1 = PIXEL_##IN_T##_TO_##OUT_T(IN1); \
-    OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN2);
-#define _RGBA_RGBA_(IN0, IN1, IN2, IN3, IN_T, OUT0, OUT1, OUT2, OUT3, \
-    OUT_T) \
-    OUT0 = PIXEL_##IN_T##_TO_##OUT_T(IN0); \
-    OUT1 = PIXEL_##IN_T##_TO_##OUT_T(IN1); \
-    OUT2 = PIXEL_##IN_T##_TO_##OUT_T(IN2); \
-    OUT3 = PIXEL_##IN_T##_TO_##OUT_T(IN3);
-
-#define _RGBA_L(IN, IN_T, OUT, OUT_T) \
-    _RGBA_L_(IN[0], IN[1], IN[2], IN[3], IN_T, OUT[0], OUT_T)
-#define _RGBA_LA(IN, IN_T, OUT, OUT_T) \
-    _RGBA_LA_(IN[0], IN[1], IN[2], IN[3], IN_T, OUT[0], OUT[1], OUT_T)
-#define _RGBA_RGB(IN, IN_T, OUT, OUT_T) \
-    _RGBA_RGB_(IN[bgr ? 2 : 0], IN[1], IN[bgr ? 0 : 2], IN[3], IN_T, \
-        OUT[0], OUT[1], OUT[2], OUT_T)
-#define _RGBA_RGB_U10(IN, IN_T, OUT, OUT_T) \
-    _RGBA_RGB_(IN[bgr ? 2 : 0], IN[1], IN[bgr ? 0 : 2], IN[3], IN_T, \
-        OUT->r, OUT->g, OUT->b, OUT_T)
-#define _RGBA_RGBA(IN, IN_T, OUT, OUT_T) \
-    _RGBA_RGBA_(IN[bgr ? 2 : 0], IN[1], IN[bgr ? 0 : 2], IN[3], IN_T, \
-        OUT[0], OUT[1], OUT[2], OUT[3], OUT_T)
+namespace
+{
 
 //------------------------------------------------------------------------------
-// Functions
+// Type Conversion
 //------------------------------------------------------------------------------
 
-namespace
-{
+// The type conversions are function objects so that the look-up tables are
+// found once for each run of pixels instead of once for each channel.
 
-#define _FNC_ARGS \
+template<Pixel::TYPE IN, Pixel::TYPE OUT>
+struct Type_Convert;
+
+#define _TYPE_CONVERT(IN, OUT) \
     \
-    const void * in, void * out, int size, int stride, bool bgr
+    template<> \
+    struct Type_Convert<Pixel::IN, Pixel::OUT> \
+    { \
+        inline Pixel::OUT##_T operator () (Pixel::IN##_T in) const \
+        { \
+            return PIXEL_##IN##_TO_##OUT(in); \
+        } \
+    };
 
-typedef void (Fnc)(_FNC_ARGS);
+#define _TYPE_U8_SIZE  (Pixel::u8_max + 1)
+#define _TYPE_U10_SIZE (Pixel::u10_max + 1)
+#define _TYPE_U16_SIZE (Pixel::u16_max + 1)
 
-#define _FNC(IN_FORMAT, IN_TYPE, OUT_FORMAT, OUT_TYPE) \
+#define _TYPE_CONVERT_LUT(IN, OUT) \
     \
-    void _##IN_FORMAT##_##IN_TYPE##_##OUT_FORMAT##_##OUT_TYPE(_FNC_ARGS) \
+    template<> \
+    struct Type_Convert<Pixel::IN, Pixel::OUT> \
     { \
-        const Pixel::IN_TYPE##_T * in_p = \
-            reinterpret_cast<const Pixel::IN_TYPE##_T *>(in); \
+        struct Lut \
+        { \
+            Lut() \
+            { \
+                for (int i = 0; i < _TYPE_##IN##_SIZE; ++i) \
+                    data[i] = PIXEL_##IN##_TO_##OUT(i); \
+            } \
+            \
+            Pixel::OUT##_T data [_TYPE_##IN##_SIZE]; \
+        }; \
         \
-        Pixel::OUT_TYPE##_T * out_p = \
-            reinterpret_cast<Pixel::OUT_TYPE##_T *>(out); \
+        Type_Convert() : \
+            _lut(lut()) \
+        {} \
         \
-        const int in_stride = stride * Pixel::channels(Pixel::IN_FORMAT); \
-        const int out_stride = Pixel::channels(Pixel::OUT_FORMAT); \
+        inline Pixel::OUT##_T operator () (Pixel::IN##_T in) const \
+        { \
+            return _lut[in]; \
+        } \
         \
-        for (int i = 0; i < size; ++i, in_p += in_stride, out_p += out_stride) \
+        static const Pixel::OUT##_T * lut() \
         { \
-            _##IN_FORMAT##_##OUT_FORMAT(in_p, IN_TYPE, out_p, OUT_TYPE) \
+            static const Lut data; \
+            \
+            return data.data; \
         } \
-    }
+        \
+    private: \
+        \
+        const Pixel::OUT##_T * _lut; \
+    };
+
+_TYPE_CONVERT(U8, U8)
+_TYPE_CONVERT_LUT(U8, U10)
+_TYPE_CONVERT_LUT(U8, U16)
+_TYPE_CONVERT_LUT(U8, F16)
+_TYPE_CONVERT_LUT(U8, F32)
+_TYPE_CONVERT(U10, U8)
+_TYPE_CONVERT(U10, U10)
+_TYPE_CONVERT_LUT(U10, U16)
+_TYPE_CONVERT_LUT(U10, F16)
+_TYPE_CONVERT_LUT(U10, F32)
+_TYPE_CONVERT(U16, U8)
+_TYPE_CONVERT(U16, U10)
+_TYPE_CONVERT(U16, U16)
+_TYPE_CONVERT_LUT(U16, F16)
+_TYPE_CONVERT_LUT(U16, F32)
+_TYPE_CONVERT(F16, U8)
+_TYPE_CONVERT(F16, U10)
+_TYPE_CONVERT(F16, U16)
+_TYPE_CONVERT(F16, F16)
+_TYPE_CONVERT(F16, F32)
+_TYPE_CONVERT(F32, U8)
+_TYPE_CONVERT(F32, U10)
+_TYPE_CONVERT(F32, U16)
+_TYPE_CONVERT(F32, F16)
+_TYPE_CONVERT(F32, F32)
 
-#define _FNC_DEFINE(OUT_FORMAT, OUT_TYPE) \
-    \
-    _FNC(L, U8, OUT_FORMAT, OUT_TYPE) \
-    _FNC(L, U16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(L, F16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(L, F32, OUT_FORMAT, OUT_TYPE) \
-    _FNC(LA, U8, OUT_FORMAT, OUT_TYPE) \
-    _FNC(LA, U16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(LA, F16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(LA, F32, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGB, U8, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGB, U16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGB, F16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGB, F32, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGBA, U8, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGBA, U16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGBA, F16, OUT_FORMAT, OUT_TYPE) \
-    _FNC(RGBA, F32, OUT_FORMAT, OUT_TYPE)
-
-_FNC_DEFINE(L, U8)
-_FNC_DEFINE(L, U16)
-_FNC_DEFINE(L, F16)
-_FNC_DEFINE(L, F32)
-_FNC_DEFINE(LA, U8)
-_FNC_DEFINE(LA, U16)
-_FNC_DEFINE(LA, F16)
-_FNC_DEFINE(LA, F32)
-_FNC_DEFINE(RGB, U8)
-_FNC_DEFINE(RGB, U16)
-_FNC_DEFINE(RGB, F16)
-_FNC_DEFINE(RGB, F32)
-_FNC_DEFINE(RGBA, U8)
-_FNC_DEFINE(RGBA, U16)
-_FNC_DEFINE(RGBA, F16)
-_FNC_DEFINE(RGBA, F32)
-
-void _RGB_U10_RGB_U10(_FNC_ARGS)
-{
-    const Pixel::U10_S * in_p = reinterpret_cast<const Pixel::U10_S *>(in);
+//------------------------------------------------------------------------------
+// Pixel Traits
+//------------------------------------------------------------------------------
 
-    Pixel::U10_S * out_p = reinterpret_cast<Pixel::U10_S *>(out);
+// The pixel traits describe how the channels of a pixel are stored. Pixels
+// are stored as arrays of channels except for 10-bit pixels, which are
+// packed into a single word.
 
-    _RGB_RGB_(
-        in_p->r, in_p->g, in_p->b, U10, out_p->r, out_p->g, out_p->b, U10);
-}
+template<Pixel::PIXEL PIXEL>
+struct Pixel_Traits;
 
-#define _FNC_RGB_U10(OUT_FORMAT, OUT_TYPE) \
+#define _PIXEL_TRAITS(PIXEL_FORMAT, PIXEL_TYPE, CHANNELS) \
     \
-    void _RGB_U10_##OUT_FORMAT##_##OUT_TYPE(_FNC_ARGS) \
+    template<> \
+    struct Pixel_Traits<Pixel::PIXEL_FORMAT##_##PIXEL_TYPE> \
     { \
-        const Pixel::U10_S * in_p = \
-         reinterpret_cast<const Pixel::U10_S *>(in); \
+        typedef Pixel::PIXEL_TYPE##_T T; \
+        typedef Pixel::PIXEL_TYPE##_T Data; \
         \
-        Pixel::OUT_TYPE##_T * out_p = \
-            reinterpret_cast<Pixel::OUT_TYPE##_T *>(out); \
+        static const Pixel::FORMAT format = Pixel::PIXEL_FORMAT; \
+        static const Pixel::TYPE   type   = Pixel::PIXEL_TYPE; \
+        static const int           step   = CHANNELS; \
         \
-        const int in_stride = stride; \
-        const int out_stride = Pixel::channels(Pixel::OUT_FORMAT); \
+        static inline T one() \
+        { \
+            return T(PIXEL_##PIXEL_TYPE##_ONE); \
+        } \
+        \
+        static inline T get(const Data * in, int channel) \
+        { \
+            return in[channel]; \
+        } \
+        \
+        static inline void set(Data * out, int channel, T value) \
+        { \
+            out[channel] = value; \
+        } \
         \
-        for (int i = 0; i < size; ++i, in_p += in_stride, out_p += out_stride) \
+        static inline void set_rgb(Data * out, T r, T g, T b) \
         { \
-            _RGB_U10_##OUT_FORMAT(in_p, U10, out_p, OUT_TYPE) \
+            out[0] = r; \
+            out[1] = g; \
+            out[2] = b; \
         } \
+    };
+
+_PIXEL_TRAITS(L, U8, 1)
+_PIXEL_TRAITS(L, U16, 1)
+_PIXEL_TRAITS(L, F16, 1)
+_PIXEL_TRAITS(L, F32, 1)
+_PIXEL_TRAITS(LA, U8, 2)
+_PIXEL_TRAITS(LA, U16, 2)
+_PIXEL_TRAITS(LA, F16, 2)
+_PIXEL_TRAITS(LA, F32, 2)
+_PIXEL_TRAITS(RGB, U8, 3)
+_PIXEL_TRAITS(RGB, U16, 3)
+_PIXEL_TRAITS(RGB, F16, 3)
+_PIXEL_TRAITS(RGB, F32, 3)
+_PIXEL_TRAITS(RGBA, U8, 4)
+_PIXEL_TRAITS(RGBA, U16, 4)
+_PIXEL_TRAITS(RGBA, F16, 4)
+_PIXEL_TRAITS(RGBA, F32, 4)
+
+template<>
+struct Pixel_Traits<Pixel::RGB_U10>
+{
+    typedef Pixel::U10_T T;
+    typedef Pixel::U10_S Data;
+
+    static const Pixel::FORMAT format = Pixel::RGB;
+    static const Pixel::TYPE   type   = Pixel::U10;
+    static const int           step   = 1;
+
+    static inline T one()
+    {
+        return T(PIXEL_U10_ONE);
+    }
+
+    static inline T get(const Data * in, int channel)
+    {
+        return 0 == channel ? in->r : (1 == channel ? in->g : in->b);
+    }
+
+    static inline void set(Data * out, int channel, T value)
+    {
+        switch (channel)
+        {
+            case 0: out->r = value; break;
+            case 1: out->g = value; break;
+            case 2: out->b = value; break;
+        }
+    }
+
+    // Write the whole word at once instead of each channel.
+
+    static inline void set_rgb(Data * out, T r, T g, T b)
+    {
+        Data tmp;
+        tmp.r   = r;
+        tmp.g   = g;
+        tmp.b   = b;
+        tmp.pad = 0;
+
+        *out = tmp;
+    }
+};
+
+//------------------------------------------------------------------------------
+// Format Conversion
+//------------------------------------------------------------------------------
+
+// Luminance is the average of the color channels.
+
+template<typename IN>
+inline typename IN::T luminance(const typename IN::Data * in)
+{
+    return
+        (IN::get(in, 0) + IN::get(in, 1) + IN::get(in, 2)) /
+        typename IN::T(3);
+}
+
+template<Pixel::FORMAT IN_FORMAT, Pixel::FORMAT OUT_FORMAT>
+struct Format_Convert;
+
+template<>
+struct Format_Convert<Pixel::L, Pixel::L>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(IN::get(in, 0)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::L, Pixel::LA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(IN::get(in, 0)));
+        OUT::set(out, 1, OUT::one());
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::L, Pixel::RGB>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        const typename OUT::T tmp = convert(IN::get(in, 0));
+
+        OUT::set_rgb(out, tmp, tmp, tmp);
     }
+};
+
+template<>
+struct Format_Convert<Pixel::L, Pixel::RGBA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        const typename OUT::T tmp = convert(IN::get(in, 0));
+
+        OUT::set_rgb(out, tmp, tmp, tmp);
+        OUT::set(out, 3, OUT::one());
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::LA, Pixel::L>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(IN::get(in, 0)));
+    }
+};
 
-_FNC_RGB_U10(L, U8)
-_FNC_RGB_U10(L, U16)
-_FNC_RGB_U10(L, F16)
-_FNC_RGB_U10(L, F32)
-_FNC_RGB_U10(LA, U8)
-_FNC_RGB_U10(LA, U16)
-_FNC_RGB_U10(LA, F16)
-_FNC_RGB_U10(LA, F32)
-_FNC_RGB_U10(RGB, U8)
-_FNC_RGB_U10(RGB, U16)
-_FNC_RGB_U10(RGB, F16)
-_FNC_RGB_U10(RGB, F32)
-_FNC_RGB_U10(RGBA, U8)
-_FNC_RGB_U10(RGBA, U16)
-_FNC_RGB_U10(RGBA, F16)
-_FNC_RGB_U10(RGBA, F32)
-
-#define _FNC2_RGB_U10(IN_FORMAT, IN_TYPE) \
+template<>
+struct Format_Convert<Pixel::LA, Pixel::LA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(IN::get(in, 0)));
+        OUT::set(out, 1, convert(IN::get(in, 1)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::LA, Pixel::RGB>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        const typename OUT::T tmp = convert(IN::get(in, 0));
+
+        OUT::set_rgb(out, tmp, tmp, tmp);
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::LA, Pixel::RGBA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        const typename OUT::T tmp = convert(IN::get(in, 0));
+
+        OUT::set_rgb(out, tmp, tmp, tmp);
+        OUT::set(out, 3, convert(IN::get(in, 1)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGB, Pixel::L>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(luminance<IN>(in)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGB, Pixel::LA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(luminance<IN>(in)));
+        OUT::set(out, 1, OUT::one());
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGB, Pixel::RGB>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set_rgb(
+            out,
+            convert(IN::get(in, BGR ? 2 : 0)),
+            convert(IN::get(in, 1)),
+            convert(IN::get(in, BGR ? 0 : 2)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGB, Pixel::RGBA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set_rgb(
+            out,
+            convert(IN::get(in, BGR ? 2 : 0)),
+            convert(IN::get(in, 1)),
+            convert(IN::get(in, BGR ? 0 : 2)));
+        OUT::set(out, 3, OUT::one());
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGBA, Pixel::L>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(luminance<IN>(in)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGBA, Pixel::LA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set(out, 0, convert(luminance<IN>(in)));
+        OUT::set(out, 1, convert(IN::get(in, 3)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGBA, Pixel::RGB>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set_rgb(
+            out,
+            convert(IN::get(in, BGR ? 2 : 0)),
+            convert(IN::get(in, 1)),
+            convert(IN::get(in, BGR ? 0 : 2)));
+    }
+};
+
+template<>
+struct Format_Convert<Pixel::RGBA, Pixel::RGBA>
+{
+    template<typename IN, typename OUT, bool BGR, typename CONVERT>
+    static inline void fnc(
+        const typename IN::Data * in,
+        typename OUT::Data *      out,
+        const CONVERT &           convert)
+    {
+        OUT::set_rgb(
+            out,
+            convert(IN::get(in, BGR ? 2 : 0)),
+            convert(IN::get(in, 1)),
+            convert(IN::get(in, BGR ? 0 : 2)));
+        OUT::set(out, 3, convert(IN::get(in, 3)));
+    }
+};
+
+//------------------------------------------------------------------------------
+// Kernels
+//------------------------------------------------------------------------------
+
+// The kernels are generated for each pair of pixels, whether the input
+// stride is one, and whether the color channels are swapped, so the inner
+// loops don't have any run-time tests.
+
+template<Pixel::PIXEL IN, Pixel::PIXEL OUT, bool STRIDE, bool BGR>
+void kernel(const void * in, void * out, int size, int stride)
+{
+    typedef Pixel_Traits<IN>  In;
+    typedef Pixel_Traits<OUT> Out;
+
+    const typename In::Data * in_p =
+        reinterpret_cast<const typename In::Data *>(in);
+
+    typename Out::Data * out_p = reinterpret_cast<typename Out::Data *>(out);
+
+    const int in_stride = (STRIDE ? stride : 1) * In::step;
+
+    const Type_Convert<In::type, Out::type> convert;
+
+    for (int i = 0; i < size; ++i, in_p += in_stride, out_p += Out::step)
+    {
+        Format_Convert<In::format, Out::format>::
+            template fnc<In, Out, BGR>(in_p, out_p, convert);
+    }
+}
+
+// Kernels for contiguous pixels copy the data when the pixels are the same,
+// and otherwise use the vectorized conversion when there is one for the
+// current CPU.
+
+template<Pixel::PIXEL IN, Pixel::PIXEL OUT, bool BGR>
+void kernel_simd(const void * in, void * out, int size, int)
+{
+    if (IN == OUT && ! BGR)
+    {
+        Memory::copy(in, out, size * Pixel::bytes(IN));
+
+        return;
+    }
+
+    if (Pixel_Convert_Simd::Fnc * fnc = Pixel_Convert_Simd::fnc(IN, OUT, BGR))
+    {
+        const int count = fnc(in, out, size);
+
+        in   = static_cast<const uint8_t *>(in) + count * Pixel::bytes(IN);
+        out  = static_cast<uint8_t *>(out) + count * Pixel::bytes(OUT);
+        size -= count;
+    }
+
+    kernel<IN, OUT, false, BGR>(in, out, size, 1);
+}
+
+// Kernel table, indexed by the input pixel, output pixel, whether the stride
+// is greater than one, and whether the color channels are swapped.
+
+#define _KERNEL(IN, OUT) \
     \
-    void _##IN_FORMAT##_##IN_TYPE##_RGB_U10(_FNC_ARGS) \
     { \
-        const Pixel::IN_TYPE##_T * in_p = \
-            reinterpret_cast<const Pixel::IN_TYPE##_T *>(in); \
-        \
-        Pixel::U10_S * out_p = reinterpret_cast<Pixel::U10_S *>(out); \
-        \
-        const int in_stride = stride * Pixel::channels(Pixel::IN_FORMAT); \
-        \
-        for (int i = 0; i < size; ++i, in_p += in_stride, ++out_p) \
         { \
-            _##IN_FORMAT##_RGB_U10(in_p, IN_TYPE, out_p, U10) \
+            kernel_simd<Pixel::IN, Pixel::OUT, false>, \
+            kernel_simd<Pixel::IN, Pixel::OUT, true> \
+        }, \
+        { \
+            kernel<Pixel::IN, Pixel::OUT, true, false>, \
+            kernel<Pixel::IN, Pixel::OUT, true, true> \
         } \
     }
 
-_FNC2_RGB_U10(L, U8)
-_FNC2_RGB_U10(L, U16)
-_FNC2_RGB_U10(L, F16)
-_FNC2_RGB_U10(L, F32)
-_FNC2_RGB_U10(LA, U8)
-_FNC2_RGB_U10(LA, U16)
-_FNC2_RGB_U10(LA, F16)
-_FNC2_RGB_U10(LA, F32)
-_FNC2_RGB_U10(RGB, U8)
-_FNC2_RGB_U10(RGB, U16)
-_FNC2_RGB_U10(RGB, F16)
-_FNC2_RGB_U10(RGB, F32)
-_FNC2_RGB_U10(RGBA, U8)
-_FNC2_RGB_U10(RGBA, U16)
-_FNC2_RGB_U10(RGBA, F16)
-_FNC2_RGB_U10(RGBA, F32)
-
-// Function table.
-
-#define _FNC_TABLE(FORMAT) \
+#define _KERNEL_TABLE(IN) \
     \
     { \
-        _##FORMAT##_L_U8, \
-        _##FORMAT##_L_U16, \
-        _##FORMAT##_L_F16, \
-        _##FORMAT##_L_F32, \
-        _##FORMAT##_LA_U8, \
-        _##FORMAT##_LA_U16, \
-        _##FORMAT##_LA_F16, \
-        _##FORMAT##_LA_F32, \
-        _##FORMAT##_RGB_U8, \
-        _##FORMAT##_RGB_U10, \
-        _##FORMAT##_RGB_U16, \
-        _##FORMAT##_RGB_F16, \
-        _##FORMAT##_RGB_F32, \
-        _##FORMAT##_RGBA_U8, \
-        _##FORMAT##_RGBA_U16, \
-        _##FORMAT##_RGBA_F16, \
-        _##FORMAT##_RGBA_F32 \
+        _KERNEL(IN, L_U8), \
+        _KERNEL(IN, L_U16), \
+        _KERNEL(IN, L_F16), \
+        _KERNEL(IN, L_F32), \
+        _KERNEL(IN, LA_U8), \
+        _KERNEL(IN, LA_U16), \
+        _KERNEL(IN, LA_F16), \
+        _KERNEL(IN, LA_F32), \
+        _KERNEL(IN, RGB_U8), \
+        _KERNEL(IN, RGB_U10), \
+        _KERNEL(IN, RGB_U16), \
+        _KERNEL(IN, RGB_F16), \
+        _KERNEL(IN, RGB_F32), \
+        _KERNEL(IN, RGBA_U8), \
+        _KERNEL(IN, RGBA_U16), \
+        _KERNEL(IN, RGBA_F16), \
+        _KERNEL(IN, RGBA_F32) \
     }
 
-Fnc * fnc_tbl[Pixel::_PIXEL_SIZE][Pixel::_PIXEL_SIZE] =
+Pixel::Convert_Fnc * const kernel_table
+    [Pixel::_PIXEL_SIZE][Pixel::_PIXEL_SIZE][2][2] =
 {
-    _FNC_TABLE(L_U8),
-    _FNC_TABLE(L_U16),
-    _FNC_TABLE(L_F16),
-    _FNC_TABLE(L_F32),
-    _FNC_TABLE(LA_U8),
-    _FNC_TABLE(LA_U16),
-    _FNC_TABLE(LA_F16),
-    _FNC_TABLE(LA_F32),
-    _FNC_TABLE(RGB_U8),
-    _FNC_TABLE(RGB_U10),
-    _FNC_TABLE(RGB_U16),
-    _FNC_TABLE(RGB_F16),
-    _FNC_TABLE(RGB_F32),
-    _FNC_TABLE(RGBA_U8),
-    _FNC_TABLE(RGBA_U16),
-    _FNC_TABLE(RGBA_F16),
-    _FNC_TABLE(RGBA_F32)
+    _KERNEL_TABLE(L_U8),
+    _KERNEL_TABLE(L_U16),
+    _KERNEL_TABLE(L_F16),
+    _KERNEL_TABLE(L_F32),
+    _KERNEL_TABLE(LA_U8),
+    _KERNEL_TABLE(LA_U16),
+    _KERNEL_TABLE(LA_F16),
+    _KERNEL_TABLE(LA_F32),
+    _KERNEL_TABLE(RGB_U8),
+    _KERNEL_TABLE(RGB_U10),
+    _KERNEL_TABLE(RGB_U16),
+    _KERNEL_TABLE(RGB_F16),
+    _KERNEL_TABLE(RGB_F32),
+    _KERNEL_TABLE(RGBA_U8),
+    _KERNEL_TABLE(RGBA_U16),
+    _KERNEL_TABLE(RGBA_F16),
+    _KERNEL_TABLE(RGBA_F32)
 };
 
 } // namespace
@@ -363,6 +618,54 @@ Fnc * fnc_tbl[Pixel::_PIXEL_SIZE][Pixel::_PIXEL_SIZE] =
 // Pixel::convert
 //------------------------------------------------------------------------------
 
+namespace
+{
+
+// Large conversions are split into chunks of at least this many pixels and
+// run in the thread pool.
+
+const int convert_grain = 64 * 1024;
+
+class Convert : public Thread_Range
+{
+public:
+
+    Convert(
+        const void *         in,
+        Pixel::PIXEL         in_pixel,
+        void *               out,
+        Pixel::PIXEL         out_pixel,
+        int                  stride,
+        Pixel::Convert_Fnc * fnc) :
+        _in       (static_cast<const uint8_t *>(in)),
+        _in_bytes (Pixel::bytes(in_pixel) * stride),
+        _out      (static_cast<uint8_t *>(out)),
+        _out_bytes(Pixel::bytes(out_pixel)),
+        _stride   (stride),
+        _fnc      (fnc)
+    {}
+
+    void run(int begin, int end)
+    {
+        _fnc(
+            _in + begin * _in_bytes,
+            _out + begin * _out_bytes,
+            end - begin,
+            _stride);
+    }
+
+private:
+
+    const uint8_t *      _in;
+    size_t               _in_bytes;
+    uint8_t *            _out;
+    size_t               _out_bytes;
+    int                  _stride;
+    Pixel::Convert_Fnc * _fnc;
+};
+
+} // namespace
+
 void Pixel::convert(
     const void * in,
     PIXEL        in_pixel,
@@ -383,10 +686,31 @@ void Pixel::convert(
     {
         Memory::copy(in, out, size * bytes(out_pixel));
     }
-    else
+    else if (size >= convert_grain * 2)
     {
-        fnc_tbl[in_pixel][out_pixel](in, out, size, stride, bgr);
+        Convert fnc(
+            in,
+            in_pixel,
+            out,
+            out_pixel,
+            stride,
+            convert_fnc(in_pixel, out_pixel, stride, bgr));
+
+        Thread_Pool::global()->parallel_for(0, size, fnc, convert_grain);
     }
+    else if (size > 0)
+    {
+        convert_fnc(in_pixel, out_pixel, stride, bgr)(in, out, size, stride);
+    }
+}
+
+Pixel::Convert_Fnc * Pixel::convert_fnc(
+    PIXEL in_pixel,
+    PIXEL out_pixel,
+    int   stride,
+    bool  bgr)
+{
+    return kernel_table[in_pixel][out_pixel][stride != 1][bgr];
 }
 
 } // djv
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_pixel_convert_private.h
+
+#ifndef DJV_PIXEL_CONVERT_PRIVATE_H
+#define DJV_PIXEL_CONVERT_PRIVATE_H
+
+#include <djv_pixel.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \struct Pixel_Convert_Simd
+//!
+//! This struct provides vectorized pixel conversions. The conversions are
+//! chosen at run-time for the current CPU and produce the same results as the
+//! scalar conversions.
+//------------------------------------------------------------------------------
+
+struct Pixel_Convert_Simd
+{
+    //! Conversion function. The number of pixels converted is returned, the
+    //! remaining pixels are left for the scalar conversion.
+
+    typedef int (Fnc)(const void * in, void * out, int size);
+
+    //! Get the conversion function for contiguous pixels. Zero is returned
+    //! if there isn't one for the current CPU.
+
+    static Fnc * fnc(Pixel::PIXEL in, Pixel::PIXEL out, bool bgr);
+};
+
+} // djv
+
+#endif // DJV_PIXEL_CONVERT_PRIVATE_H
@@ -0,0 +1,1030 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_pixel_convert_simd.cpp
+
+#include <djv_pixel_convert_private.h>
+
+#include <djv_cpu_private.h>
+#include <djv_math.h>
+
+#if defined(DJV_CPU_SIMD) && ! defined(DJV_MSB)
+#define DJV_PIXEL_CONVERT_SIMD
+#endif
+
+namespace djv
+{
+
+#if defined(DJV_PIXEL_CONVERT_SIMD)
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Channel Kernels
+//
+// These convert a run of channel values and return the number converted.
+//------------------------------------------------------------------------------
+
+DJV_CPU_TARGET("sse2")
+int u16_u8_sse2(const void * in, void * out, int size)
+{
+    const __m128i * in_p  = static_cast<const __m128i *>(in);
+    __m128i *       out_p = static_cast<__m128i *>(out);
+
+    const int count = size / 16;
+
+    for (int i = 0; i < count; ++i, in_p += 2, ++out_p)
+    {
+        const __m128i a = _mm_srli_epi16(_mm_loadu_si128(in_p), 8);
+        const __m128i b = _mm_srli_epi16(_mm_loadu_si128(in_p + 1), 8);
+
+        _mm_storeu_si128(out_p, _mm_packus_epi16(a, b));
+    }
+
+    return count * 16;
+}
+
+DJV_CPU_TARGET("avx2")
+int u16_u8_avx2(const void * in, void * out, int size)
+{
+    const __m256i * in_p  = static_cast<const __m256i *>(in);
+    __m256i *       out_p = static_cast<__m256i *>(out);
+
+    const int count = size / 32;
+
+    for (int i = 0; i < count; ++i, in_p += 2, ++out_p)
+    {
+        const __m256i a = _mm256_srli_epi16(_mm256_loadu_si256(in_p), 8);
+        const __m256i b = _mm256_srli_epi16(_mm256_loadu_si256(in_p + 1), 8);
+
+        // The pack works within 128-bit lanes so the result is reordered.
+
+        _mm256_storeu_si256(
+            out_p,
+            _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8));
+    }
+
+    return count * 32;
+}
+
+// The U8 to F32 conversion matches the look-up table in Pixel::u8_to_f32().
+
+DJV_CPU_TARGET("sse2")
+int u8_f32_sse2(const void * in, void * out, int size)
+{
+    const __m128i * in_p  = static_cast<const __m128i *>(in);
+    float *         out_p = static_cast<float *>(out);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128  max  = _mm_set1_ps(static_cast<float>(Pixel::u8_max));
+
+    const int count = size / 16;
+
+    for (int i = 0; i < count; ++i, ++in_p, out_p += 16)
+    {
+        const __m128i v  = _mm_loadu_si128(in_p);
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+        _mm_storeu_ps(out_p, _mm_div_ps(
+            _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), max));
+        _mm_storeu_ps(out_p + 4, _mm_div_ps(
+            _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), max));
+        _mm_storeu_ps(out_p + 8, _mm_div_ps(
+            _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), max));
+        _mm_storeu_ps(out_p + 12, _mm_div_ps(
+            _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), max));
+    }
+
+    return count * 16;
+}
+
+DJV_CPU_TARGET("avx2")
+int u8_f32_avx2(const void * in, void * out, int size)
+{
+    const uint8_t * in_p  = static_cast<const uint8_t *>(in);
+    float *         out_p = static_cast<float *>(out);
+
+    const __m256 max = _mm256_set1_ps(static_cast<float>(Pixel::u8_max));
+
+    const int count = size / 16;
+
+    for (int i = 0; i < count; ++i, in_p += 16, out_p += 16)
+    {
+        const __m256i a = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in_p)));
+        const __m256i b = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in_p + 8)));
+
+        _mm256_storeu_ps(out_p, _mm256_div_ps(_mm256_cvtepi32_ps(a), max));
+        _mm256_storeu_ps(out_p + 8, _mm256_div_ps(_mm256_cvtepi32_ps(b), max));
+    }
+
+    return count * 16;
+}
+
+// The half conversions round to nearest even like the half class.
+
+DJV_CPU_TARGET("f16c")
+int f16_f32_f16c(const void * in, void * out, int size)
+{
+    const __m128i * in_p  = static_cast<const __m128i *>(in);
+    float *         out_p = static_cast<float *>(out);
+
+    const int count = size / 8;
+
+    for (int i = 0; i < count; ++i, ++in_p, out_p += 8)
+    {
+        const __m128i v = _mm_loadu_si128(in_p);
+
+        _mm_storeu_ps(out_p, _mm_cvtph_ps(v));
+        _mm_storeu_ps(out_p + 4, _mm_cvtph_ps(_mm_srli_si128(v, 8)));
+    }
+
+    return count * 8;
+}
+
+DJV_CPU_TARGET("f16c")
+int f32_f16_f16c(const void * in, void * out, int size)
+{
+    const float * in_p  = static_cast<const float *>(in);
+    __m128i *     out_p = static_cast<__m128i *>(out);
+
+    const int count = size / 8;
+
+    for (int i = 0; i < count; ++i, in_p += 8, ++out_p)
+    {
+        const __m128i a = _mm_cvtps_ph(_mm_loadu_ps(in_p), 0);
+        const __m128i b = _mm_cvtps_ph(_mm_loadu_ps(in_p + 4), 0);
+
+        _mm_storeu_si128(out_p, _mm_unpacklo_epi64(a, b));
+    }
+
+    return count * 8;
+}
+
+// Adapt a channel kernel to pixels.
+
+typedef int (Channel_Fnc)(const void *, void *, int);
+
+template<Channel_Fnc * FNC, int CHANNELS>
+int channels(const void * in, void * out, int size)
+{
+    // A partially converted pixel at the end is left for the scalar
+    // conversion.
+
+    return FNC(in, out, size * CHANNELS) / CHANNELS;
+}
+
+//------------------------------------------------------------------------------
+// RGB_U10 Kernels
+//------------------------------------------------------------------------------
+
+// Unpack four 10-bit pixels into channels, and interleave channels back into
+// RGB or RGBA order. The reverse operations are used to pack pixels.
+
+struct U10_Rgb
+{
+    DJV_CPU_TARGET("sse2")
+    static inline void unpack(
+        const void * in,
+        bool         bgr,
+        __m128 &     r,
+        __m128 &     g,
+        __m128 &     b)
+    {
+        const __m128i mask = _mm_set1_epi32(0x3ff);
+
+        const __m128i v = _mm_loadu_si128(static_cast<const __m128i *>(in));
+
+        r = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 22), mask));
+        g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 12), mask));
+        b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v,  2), mask));
+
+        if (bgr)
+        {
+            const __m128 tmp = r;
+            r = b;
+            b = tmp;
+        }
+    }
+
+    // Divide by the 10-bit maximum, which is what the look-up tables do.
+
+    DJV_CPU_TARGET("sse2")
+    static inline __m128 normalize(const __m128 & in)
+    {
+        return _mm_div_ps(
+            in,
+            _mm_set1_ps(static_cast<float>(Pixel::u10_max)));
+    }
+
+    // The padding bits are cleared.
+
+    DJV_CPU_TARGET("sse2")
+    static inline void pack(
+        __m128i r,
+        __m128i g,
+        __m128i b,
+        bool    bgr,
+        void *  out)
+    {
+        if (bgr)
+        {
+            const __m128i tmp = r;
+            r = b;
+            b = tmp;
+        }
+
+        _mm_storeu_si128(
+            static_cast<__m128i *>(out),
+            _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi32(r, 22), _mm_slli_epi32(g, 12)),
+                _mm_slli_epi32(b, 2)));
+    }
+
+    DJV_CPU_TARGET("sse2")
+    static inline void interleave(
+        const __m128 & r,
+        const __m128 & g,
+        const __m128 & b,
+        __m128 &       out0,
+        __m128 &       out1,
+        __m128 &       out2)
+    {
+        const __m128 rg_lo = _mm_unpacklo_ps(r, g);
+        const __m128 rg_hi = _mm_unpackhi_ps(r, g);
+
+        out0 = _mm_shuffle_ps(
+            rg_lo,
+            _mm_shuffle_ps(b, r, _MM_SHUFFLE(1, 1, 0, 0)),
+            _MM_SHUFFLE(2, 0, 1, 0));
+        out1 = _mm_shuffle_ps(
+            _mm_shuffle_ps(g, b, _MM_SHUFFLE(1, 1, 1, 1)),
+            rg_hi,
+            _MM_SHUFFLE(1, 0, 2, 0));
+        out2 = _mm_shuffle_ps(
+            _mm_shuffle_ps(b, r, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm_shuffle_ps(g, b, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    DJV_CPU_TARGET("sse2")
+    static inline void interleave(
+        const __m128 & r,
+        const __m128 & g,
+        const __m128 & b,
+        const __m128 & a,
+        __m128 &       out0,
+        __m128 &       out1,
+        __m128 &       out2,
+        __m128 &       out3)
+    {
+        const __m128 rg_lo = _mm_unpacklo_ps(r, g);
+        const __m128 rg_hi = _mm_unpackhi_ps(r, g);
+        const __m128 ba_lo = _mm_unpacklo_ps(b, a);
+        const __m128 ba_hi = _mm_unpackhi_ps(b, a);
+
+        out0 = _mm_movelh_ps(rg_lo, ba_lo);
+        out1 = _mm_movehl_ps(ba_lo, rg_lo);
+        out2 = _mm_movelh_ps(rg_hi, ba_hi);
+        out3 = _mm_movehl_ps(ba_hi, rg_hi);
+    }
+
+    DJV_CPU_TARGET("sse2")
+    static inline void deinterleave(
+        const __m128 & in0,
+        const __m128 & in1,
+        const __m128 & in2,
+        __m128 &       r,
+        __m128 &       g,
+        __m128 &       b)
+    {
+        r = _mm_shuffle_ps(
+            _mm_shuffle_ps(in0, in0, _MM_SHUFFLE(3, 3, 3, 0)),
+            _mm_shuffle_ps(in1, in2, _MM_SHUFFLE(1, 1, 2, 2)),
+            _MM_SHUFFLE(2, 0, 1, 0));
+        g = _mm_shuffle_ps(
+            _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(0, 0, 1, 1)),
+            _mm_shuffle_ps(in1, in2, _MM_SHUFFLE(2, 2, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+        b = _mm_shuffle_ps(
+            _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(1, 1, 2, 2)),
+            _mm_shuffle_ps(in2, in2, _MM_SHUFFLE(3, 3, 0, 0)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    // The alpha channel is discarded.
+
+    DJV_CPU_TARGET("sse2")
+    static inline void deinterleave(
+        const __m128 & in0,
+        const __m128 & in1,
+        const __m128 & in2,
+        const __m128 & in3,
+        __m128 &       r,
+        __m128 &       g,
+        __m128 &       b)
+    {
+        const __m128 rg_lo = _mm_unpacklo_ps(in0, in1);
+        const __m128 rg_hi = _mm_unpacklo_ps(in2, in3);
+        const __m128 ba_lo = _mm_unpackhi_ps(in0, in1);
+        const __m128 ba_hi = _mm_unpackhi_ps(in2, in3);
+
+        r = _mm_movelh_ps(rg_lo, rg_hi);
+        g = _mm_movehl_ps(rg_hi, rg_lo);
+        b = _mm_movelh_ps(ba_lo, ba_hi);
+    }
+
+    // Deinterleave RGB or RGBA channels that have been widened to 32-bits.
+
+    DJV_CPU_TARGET("sse2")
+    static inline void deinterleave(
+        const __m128i * in,
+        bool            alpha,
+        __m128i &       r,
+        __m128i &       g,
+        __m128i &       b)
+    {
+        __m128 tmp [3];
+
+        if (alpha)
+        {
+            deinterleave(
+                _mm_castsi128_ps(in[0]),
+                _mm_castsi128_ps(in[1]),
+                _mm_castsi128_ps(in[2]),
+                _mm_castsi128_ps(in[3]),
+                tmp[0], tmp[1], tmp[2]);
+        }
+        else
+        {
+            deinterleave(
+                _mm_castsi128_ps(in[0]),
+                _mm_castsi128_ps(in[1]),
+                _mm_castsi128_ps(in[2]),
+                tmp[0], tmp[1], tmp[2]);
+        }
+
+        r = _mm_castps_si128(tmp[0]);
+        g = _mm_castps_si128(tmp[1]);
+        b = _mm_castps_si128(tmp[2]);
+    }
+
+    // Convert floating point values to 10-bits the same way as
+    // Pixel::f32_to_u10(). The scalar conversion adds one half in double
+    // precision and truncates, so the rounding is done on the fraction
+    // here, which is exact. NaN values become zero.
+
+    DJV_CPU_TARGET("sse2")
+    static inline __m128i quantize(__m128 in)
+    {
+        const __m128 u10_max = _mm_set1_ps(static_cast<float>(Pixel::u10_max));
+
+        in = _mm_min_ps(
+            _mm_max_ps(_mm_mul_ps(in, u10_max), _mm_setzero_ps()),
+            u10_max);
+
+        const __m128i out = _mm_cvttps_epi32(in);
+
+        const __m128 fraction = _mm_sub_ps(in, _mm_cvtepi32_ps(out));
+
+        return _mm_sub_epi32(
+            out,
+            _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f))));
+    }
+};
+
+// These match the look-up tables in Pixel::u10_to_u16(), Pixel::u10_to_f16(),
+// and Pixel::u10_to_f32(). The alpha channel is set to one.
+
+template<bool BGR, bool ALPHA>
+DJV_CPU_TARGET("sse2")
+int u10_u16_sse2(const void * in, void * out, int size)
+{
+    const uint32_t * in_p  = static_cast<const uint32_t *>(in);
+    uint16_t *       out_p = static_cast<uint16_t *>(out);
+
+    const __m128  u16_max = _mm_set1_ps(static_cast<float>(Pixel::u16_max));
+    const __m128i bias    = _mm_set1_epi32(0x8000);
+    const __m128i sign    = _mm_set1_epi16(static_cast<short>(0x8000));
+
+    const int count = size / 4;
+
+    for (int i = 0; i < count; ++i, in_p += 4, out_p += ALPHA ? 16 : 12)
+    {
+        __m128 r, g, b;
+        U10_Rgb::unpack(in_p, BGR, r, g, b);
+
+        r = _mm_mul_ps(U10_Rgb::normalize(r), u16_max);
+        g = _mm_mul_ps(U10_Rgb::normalize(g), u16_max);
+        b = _mm_mul_ps(U10_Rgb::normalize(b), u16_max);
+
+        // Pack without signed saturation by biasing the values.
+
+        __m128 v [4];
+        __m128i a [4];
+
+        if (ALPHA)
+        {
+            U10_Rgb::interleave(r, g, b, u16_max, v[0], v[1], v[2], v[3]);
+
+            for (int j = 0; j < 4; ++j)
+            {
+                a[j] = _mm_sub_epi32(_mm_cvttps_epi32(v[j]), bias);
+            }
+
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(out_p),
+                _mm_xor_si128(_mm_packs_epi32(a[0], a[1]), sign));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(out_p + 8),
+                _mm_xor_si128(_mm_packs_epi32(a[2], a[3]), sign));
+        }
+        else
+        {
+            U10_Rgb::interleave(r, g, b, v[0], v[1], v[2]);
+
+            for (int j = 0; j < 3; ++j)
+            {
+                a[j] = _mm_sub_epi32(_mm_cvttps_epi32(v[j]), bias);
+            }
+
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(out_p),
+                _mm_xor_si128(_mm_packs_epi32(a[0], a[1]), sign));
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i *>(out_p + 8),
+                _mm_xor_si128(_mm_packs_epi32(a[2], a[2]), sign));
+        }
+    }
+
+    return count * 4;
+}
+
+template<bool BGR, bool ALPHA>
+DJV_CPU_TARGET("f16c")
+int u10_f16_f16c(const void * in, void * out, int size)
+{
+    const uint32_t * in_p  = static_cast<const uint32_t *>(in);
+    uint16_t *       out_p = static_cast<uint16_t *>(out);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const int count = size / 4;
+
+    for (int i = 0; i < count; ++i, in_p += 4, out_p += ALPHA ? 16 : 12)
+    {
+        __m128 r, g, b;
+        U10_Rgb::unpack(in_p, BGR, r, g, b);
+
+        r = U10_Rgb::normalize(r);
+        g = U10_Rgb::normalize(g);
+        b = U10_Rgb::normalize(b);
+
+        __m128 v [4];
+
+        if (ALPHA)
+        {
+            U10_Rgb::interleave(r, g, b, one, v[0], v[1], v[2], v[3]);
+        }
+        else
+        {
+            U10_Rgb::interleave(r, g, b, v[0], v[1], v[2]);
+        }
+
+        for (int j = 0; j < (ALPHA ? 4 : 3); ++j)
+        {
+            _mm_storel_epi64(
+                reinterpret_cast<__m128i *>(out_p + j * 4),
+                _mm_cvtps_ph(v[j], 0));
+        }
+    }
+
+    return count * 4;
+}
+
+template<bool BGR, bool ALPHA>
+DJV_CPU_TARGET("sse2")
+int u10_f32_sse2(const void * in, void * out, int size)
+{
+    const uint32_t * in_p  = static_cast<const uint32_t *>(in);
+    float *          out_p = static_cast<float *>(out);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const int count = size / 4;
+
+    for (int i = 0; i < count; ++i, in_p += 4, out_p += ALPHA ? 16 : 12)
+    {
+        __m128 r, g, b;
+        U10_Rgb::unpack(in_p, BGR, r, g, b);
+
+        r = U10_Rgb::normalize(r);
+        g = U10_Rgb::normalize(g);
+        b = U10_Rgb::normalize(b);
+
+        __m128 v [4];
+
+        if (ALPHA)
+        {
+            U10_Rgb::interleave(r, g, b, one, v[0], v[1], v[2], v[3]);
+        }
+        else
+        {
+            U10_Rgb::interleave(r, g, b, v[0], v[1], v[2]);
+        }
+
+        for (int j = 0; j < (ALPHA ? 4 : 3); ++j)
+        {
+            _mm_storeu_ps(out_p + j * 4, v[j]);
+        }
+    }
+
+    return count * 4;
+}
+
+// These match Pixel::u16_to_u10(), Pixel::f16_to_u10(), and
+// Pixel::f32_to_u10(). The alpha channel is ignored.
+
+template<bool BGR, bool ALPHA>
+DJV_CPU_TARGET("sse2")
+int u16_u10_sse2(const void * in, void * out, int size)
+{
+    const uint16_t * in_p  = static_cast<const uint16_t *>(in);
+    uint32_t *       out_p = static_cast<uint32_t *>(out);
+
+    const __m128i zero = _mm_setzero_si128();
+
+    const int count = size / 4;
+
+    for (int i = 0; i < count; ++i, in_p += ALPHA ? 16 : 12, out_p += 4)
+    {
+        const __m128i v0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_p));
+        const __m128i v1 = ALPHA ?
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_p + 8)) :
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in_p + 8));
+
+        const __m128i v [] =
+        {
+            _mm_unpacklo_epi16(v0, zero),
+            _mm_unpackhi_epi16(v0, zero),
+            _mm_unpacklo_epi16(v1, zero),
+            _mm_unpackhi_epi16(v1, zero)
+        };
+
+        __m128i r, g, b;
+        U10_Rgb::deinterleave(v, ALPHA, r, g, b);
+
+        U10_Rgb::pack(
+            _mm_srli_epi32(r, 6),
+            _mm_srli_epi32(g, 6),
+            _mm_srli_epi32(b, 6),
+            BGR,
+            out_p);
+    }
+
+    return count * 4;
+}
+
+template<bool BGR, bool ALPHA>
+DJV_CPU_TARGET("f16c")
+int f16_u10_f16c(const void * in, void * out, int size)
+{
+    const uint16_t * in_p  = static_cast<const uint16_t *>(in);
+    uint32_t *       out_p = static_cast<uint32_t *>(out);
+
+    const int count = size / 4;
+
+    for (int i = 0; i < count; ++i, in_p += ALPHA ? 16 : 12, out_p += 4)
+    {
+        __m128 v [4];
+
+        for (int j = 0; j < (ALPHA ? 4 : 3); ++j)
+        {
+            v[j] = _mm_cvtph_ps(
+                _mm_loadl_epi64(
+                    reinterpret_cast<const __m128i *>(in_p + j * 4)));
+        }
+
+        __m128 r, g, b;
+
+        if (ALPHA)
+        {
+            U10_Rgb::deinterleave(v[0], v[1], v[2], v[3], r, g, b);
+        }
+        else
+        {
+            U10_Rgb::deinterleave(v[0], v[1], v[2], r, g, b);
+        }
+
+        U10_Rgb::pack(
+            U10_Rgb::quantize(r),
+            U10_Rgb::quantize(g),
+            U10_Rgb::quantize(b),
+            BGR,
+            out_p);
+    }
+
+    return count * 4;
+}
+
+template<bool BGR, bool ALPHA>
+DJV_CPU_TARGET("sse2")
+int f32_u10_sse2(const void * in, void * out, int size)
+{
+    const float * in_p  = static_cast<const float *>(in);
+    uint32_t *    out_p = static_cast<uint32_t *>(out);
+
+    const int count = size / 4;
+
+    for (int i = 0; i < count; ++i, in_p += ALPHA ? 16 : 12, out_p += 4)
+    {
+        __m128 r, g, b;
+
+        if (ALPHA)
+        {
+            U10_Rgb::deinterleave(
+                _mm_loadu_ps(in_p),
+                _mm_loadu_ps(in_p + 4),
+                _mm_loadu_ps(in_p + 8),
+                _mm_loadu_ps(in_p + 12),
+                r, g, b);
+        }
+        else
+        {
+            U10_Rgb::deinterleave(
+                _mm_loadu_ps(in_p),
+                _mm_loadu_ps(in_p + 4),
+                _mm_loadu_ps(in_p + 8),
+                r, g, b);
+        }
+
+        U10_Rgb::pack(
+            U10_Rgb::quantize(r),
+            U10_Rgb::quantize(g),
+            U10_Rgb::quantize(b),
+            BGR,
+            out_p);
+    }
+
+    return count * 4;
+}
+
+//------------------------------------------------------------------------------
+// Shuffle Kernels
+//
+// These reorder the bytes of pixels with the same channel type: RGB to RGBA,
+// RGBA to RGB, and the BGR swizzle. The kernels may write past the last pixel
+// they convert, but never past the end of the output; the extra values are
+// overwritten by the following pixels.
+//------------------------------------------------------------------------------
+
+// Shuffle masks for SSSE3; -1 clears the byte.
+
+struct Shuffle
+{
+    int8_t mask  [16];
+    int8_t alpha [16];
+    int    in_step;   // Bytes read per iteration.
+    int    out_step;  // Bytes written per iteration.
+    int    pixels;    // Pixels per iteration.
+    int    in_bytes;  // Bytes per input pixel.
+    int    out_bytes; // Bytes per output pixel.
+};
+
+DJV_CPU_TARGET("ssse3")
+int shuffle_ssse3(
+    const Shuffle & shuffle,
+    const void *    in,
+    void *          out,
+    int             size)
+{
+    const uint8_t * in_p  = static_cast<const uint8_t *>(in);
+    uint8_t *       out_p = static_cast<uint8_t *>(out);
+
+    const __m128i mask = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(shuffle.mask));
+    const __m128i alpha = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(shuffle.alpha));
+
+    // Each iteration reads and writes a full 16 bytes.
+
+    const int in_size  = size * shuffle.in_bytes;
+    const int out_size = size * shuffle.out_bytes;
+
+    int i = 0;
+
+    for (
+        ;
+        i * shuffle.in_bytes + 16 <= in_size &&
+        i * shuffle.out_bytes + 16 <= out_size;
+        i += shuffle.pixels,
+        in_p += shuffle.in_step,
+        out_p += shuffle.out_step)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_p));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(out_p),
+            _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+    }
+
+    return i;
+}
+
+// Build the shuffle for a conversion between RGB and RGBA with the given
+// channel size in bytes.
+
+Shuffle shuffle_init(
+    int  in_channels,
+    int  out_channels,
+    int  channel_bytes,
+    bool bgr,
+    const uint8_t * one)
+{
+    Shuffle out;
+
+    out.in_bytes  = in_channels * channel_bytes;
+    out.out_bytes = out_channels * channel_bytes;
+    out.pixels    = 16 / Math::max(out.in_bytes, out.out_bytes);
+    out.in_step   = out.pixels * out.in_bytes;
+    out.out_step  = out.pixels * out.out_bytes;
+
+    static const int rgb [] = { 2, 1, 0 };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        out.mask[i]  = -1;
+        out.alpha[i] = 0;
+    }
+
+    for (int i = 0; i < out.pixels; ++i)
+    {
+        for (int c = 0; c < out_channels; ++c)
+        {
+            for (int j = 0; j < channel_bytes; ++j)
+            {
+                const int o = i * out.out_bytes + c * channel_bytes + j;
+
+                if (c < 3)
+                {
+                    out.mask[o] = static_cast<int8_t>(
+                        i * out.in_bytes +
+                        (bgr ? rgb[c] : c) * channel_bytes + j);
+                }
+                else if (in_channels > 3)
+                {
+                    out.mask[o] = static_cast<int8_t>(
+                        i * out.in_bytes + c * channel_bytes + j);
+                }
+                else
+                {
+                    out.alpha[o] = static_cast<int8_t>(one[j]);
+                }
+            }
+        }
+    }
+
+    return out;
+}
+
+//------------------------------------------------------------------------------
+// Function Table
+//------------------------------------------------------------------------------
+
+// The shuffles for each pixel type with one channel byte order.
+
+const uint8_t one_u8  [] = { 0xff };
+const uint8_t one_u16 [] = { 0xff, 0xff };
+const uint8_t one_f16 [] = { 0x00, 0x3c };
+const uint8_t one_f32 [] = { 0x00, 0x00, 0x80, 0x3f };
+
+#define _SHUFFLE(NAME, IN, OUT, BYTES, BGR, ONE) \
+    \
+    const Shuffle NAME##_shuffle = shuffle_init(IN, OUT, BYTES, BGR, ONE); \
+    \
+    int NAME(const void * in, void * out, int size) \
+    { \
+        return shuffle_ssse3(NAME##_shuffle, in, out, size); \
+    }
+
+_SHUFFLE(rgb_rgba_u8,      3, 4, 1, false, one_u8)
+_SHUFFLE(rgb_rgba_u8_bgr,  3, 4, 1, true,  one_u8)
+_SHUFFLE(rgba_rgb_u8,      4, 3, 1, false, one_u8)
+_SHUFFLE(rgba_rgb_u8_bgr,  4, 3, 1, true,  one_u8)
+_SHUFFLE(rgb_rgb_u8_bgr,   3, 3, 1, true,  one_u8)
+_SHUFFLE(rgba_rgba_u8_bgr, 4, 4, 1, true,  one_u8)
+
+_SHUFFLE(rgb_rgba_u16,      3, 4, 2, false, one_u16)
+_SHUFFLE(rgb_rgba_u16_bgr,  3, 4, 2, true,  one_u16)
+_SHUFFLE(rgba_rgb_u16,      4, 3, 2, false, one_u16)
+_SHUFFLE(rgba_rgb_u16_bgr,  4, 3, 2, true,  one_u16)
+_SHUFFLE(rgb_rgb_u16_bgr,   3, 3, 2, true,  one_u16)
+_SHUFFLE(rgba_rgba_u16_bgr, 4, 4, 2, true,  one_u16)
+
+_SHUFFLE(rgb_rgba_f16,      3, 4, 2, false, one_f16)
+_SHUFFLE(rgb_rgba_f16_bgr,  3, 4, 2, true,  one_f16)
+_SHUFFLE(rgba_rgb_f16,      4, 3, 2, false, one_f16)
+_SHUFFLE(rgba_rgb_f16_bgr,  4, 3, 2, true,  one_f16)
+_SHUFFLE(rgb_rgb_f16_bgr,   3, 3, 2, true,  one_f16)
+_SHUFFLE(rgba_rgba_f16_bgr, 4, 4, 2, true,  one_f16)
+
+_SHUFFLE(rgb_rgba_f32,      3, 4, 4, false, one_f32)
+_SHUFFLE(rgb_rgba_f32_bgr,  3, 4, 4, true,  one_f32)
+_SHUFFLE(rgba_rgb_f32,      4, 3, 4, false, one_f32)
+_SHUFFLE(rgba_rgb_f32_bgr,  4, 3, 4, true,  one_f32)
+_SHUFFLE(rgb_rgb_f32_bgr,   3, 3, 4, true,  one_f32)
+_SHUFFLE(rgba_rgba_f32_bgr, 4, 4, 4, true,  one_f32)
+
+struct Table
+{
+    Table()
+    {
+        for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+            for (int j = 0; j < Pixel::_PIXEL_SIZE; ++j)
+                for (int k = 0; k < 2; ++k)
+                    fnc[i][j][k] = 0;
+
+        const Cpu & cpu = Cpu::global();
+
+        //DJV_DEBUG("Pixel_Convert_Simd::Table");
+        //DJV_DEBUG_PRINT("sse2 = " << cpu.sse2);
+        //DJV_DEBUG_PRINT("ssse3 = " << cpu.ssse3);
+        //DJV_DEBUG_PRINT("avx2 = " << cpu.avx2);
+        //DJV_DEBUG_PRINT("f16c = " << cpu.f16c);
+
+        if (! cpu.sse2)
+            return;
+
+        // U16 to U8.
+
+        set(Pixel::L_U16, Pixel::L_U8, false,
+            cpu.avx2 ?
+            channels<u16_u8_avx2, 1> :
+            channels<u16_u8_sse2, 1>);
+        set(Pixel::LA_U16, Pixel::LA_U8, false,
+            cpu.avx2 ?
+            channels<u16_u8_avx2, 2> :
+            channels<u16_u8_sse2, 2>);
+        set(Pixel::RGB_U16, Pixel::RGB_U8, false,
+            cpu.avx2 ?
+            channels<u16_u8_avx2, 3> :
+            channels<u16_u8_sse2, 3>);
+        set(Pixel::RGBA_U16, Pixel::RGBA_U8, false,
+            cpu.avx2 ?
+            channels<u16_u8_avx2, 4> :
+            channels<u16_u8_sse2, 4>);
+
+        // U8 to F32.
+
+        set(Pixel::L_U8, Pixel::L_F32, false,
+            cpu.avx2 ?
+            channels<u8_f32_avx2, 1> :
+            channels<u8_f32_sse2, 1>);
+        set(Pixel::LA_U8, Pixel::LA_F32, false,
+            cpu.avx2 ?
+            channels<u8_f32_avx2, 2> :
+            channels<u8_f32_sse2, 2>);
+        set(Pixel::RGB_U8, Pixel::RGB_F32, false,
+            cpu.avx2 ?
+            channels<u8_f32_avx2, 3> :
+            channels<u8_f32_sse2, 3>);
+        set(Pixel::RGBA_U8, Pixel::RGBA_F32, false,
+            cpu.avx2 ?
+            channels<u8_f32_avx2, 4> :
+            channels<u8_f32_sse2, 4>);
+
+        // RGB_U10.
+
+#define _U10_SET(FORMAT, ALPHA, TYPE, UNPACK, PACK) \
+    \
+    set(Pixel::RGB_U10, Pixel::FORMAT##_##TYPE, false, UNPACK<false, ALPHA>); \
+    set(Pixel::RGB_U10, Pixel::FORMAT##_##TYPE, true,  UNPACK<true,  ALPHA>); \
+    set(Pixel::FORMAT##_##TYPE, Pixel::RGB_U10, false, PACK<false, ALPHA>); \
+    set(Pixel::FORMAT##_##TYPE, Pixel::RGB_U10, true,  PACK<true,  ALPHA>);
+
+        _U10_SET(RGB,  false, U16, u10_u16_sse2, u16_u10_sse2)
+        _U10_SET(RGBA, true,  U16, u10_u16_sse2, u16_u10_sse2)
+        _U10_SET(RGB,  false, F32, u10_f32_sse2, f32_u10_sse2)
+        _U10_SET(RGBA, true,  F32, u10_f32_sse2, f32_u10_sse2)
+
+        if (cpu.f16c)
+        {
+            _U10_SET(RGB,  false, F16, u10_f16_f16c, f16_u10_f16c)
+            _U10_SET(RGBA, true,  F16, u10_f16_f16c, f16_u10_f16c)
+
+            // F16 and F32.
+
+            set(Pixel::L_F16,    Pixel::L_F32,    false,
+                channels<f16_f32_f16c, 1>);
+            set(Pixel::LA_F16,   Pixel::LA_F32,   false,
+                channels<f16_f32_f16c, 2>);
+            set(Pixel::RGB_F16,  Pixel::RGB_F32,  false,
+                channels<f16_f32_f16c, 3>);
+            set(Pixel::RGBA_F16, Pixel::RGBA_F32, false,
+                channels<f16_f32_f16c, 4>);
+
+            set(Pixel::L_F32,    Pixel::L_F16,    false,
+                channels<f32_f16_f16c, 1>);
+            set(Pixel::LA_F32,   Pixel::LA_F16,   false,
+                channels<f32_f16_f16c, 2>);
+            set(Pixel::RGB_F32,  Pixel::RGB_F16,  false,
+                channels<f32_f16_f16c, 3>);
+            set(Pixel::RGBA_F32, Pixel::RGBA_F16, false,
+                channels<f32_f16_f16c, 4>);
+        }
+
+        // RGB, RGBA, and the BGR swizzle.
+
+        if (cpu.ssse3)
+        {
+#define _SHUFFLE_SET(TYPE, NAME) \
+    \
+    set(Pixel::RGB_##TYPE, Pixel::RGBA_##TYPE, false, rgb_rgba_##NAME); \
+    set(Pixel::RGB_##TYPE, Pixel::RGBA_##TYPE, true, rgb_rgba_##NAME##_bgr); \
+    set(Pixel::RGBA_##TYPE, Pixel::RGB_##TYPE, false, rgba_rgb_##NAME); \
+    set(Pixel::RGBA_##TYPE, Pixel::RGB_##TYPE, true, rgba_rgb_##NAME##_bgr); \
+    set(Pixel::RGB_##TYPE, Pixel::RGB_##TYPE, true, rgb_rgb_##NAME##_bgr); \
+    set(Pixel::RGBA_##TYPE, Pixel::RGBA_##TYPE, true, rgba_rgba_##NAME##_bgr);
+
+            _SHUFFLE_SET(U8, u8)
+            _SHUFFLE_SET(U16, u16)
+            _SHUFFLE_SET(F16, f16)
+            _SHUFFLE_SET(F32, f32)
+        }
+    }
+
+    void set(
+        Pixel::PIXEL              in,
+        Pixel::PIXEL              out,
+        bool                      bgr,
+        Pixel_Convert_Simd::Fnc * in_fnc)
+    {
+        fnc[in][out][bgr] = in_fnc;
+    }
+
+    Pixel_Convert_Simd::Fnc * fnc [Pixel::_PIXEL_SIZE][Pixel::_PIXEL_SIZE][2];
+};
+
+// The table is initialized when the library is loaded so that it is safe to
+// use from multiple threads.
+
+const Table table;
+
+} // namespace
+
+#endif // DJV_PIXEL_CONVERT_SIMD
+
+//------------------------------------------------------------------------------
+// Pixel_Convert_Simd
+//------------------------------------------------------------------------------
+
+Pixel_Convert_Simd::Fnc * Pixel_Convert_Simd::fnc(
+    Pixel::PIXEL in,
+    Pixel::PIXEL out,
+    bool         bgr)
+{
+#if defined(DJV_PIXEL_CONVERT_SIMD)
+
+    return table.fnc[in][out][bgr];
+
+#else
+
+    return 0;
+
+#endif
+}
+
+} // djv
@@ -98,14 +98,50 @@ const List<String> & Pixel_Data_Info::label_proxy()
 // Pixel_Data
 //------------------------------------------------------------------------------
 
+namespace
+{
+
+// Thread safe reference counting.
+
+long ref(volatile long & in)
+{
+#if defined(DJV_WINDOWS)
+    return InterlockedIncrement(&in);
+#else
+    return __sync_add_and_fetch(&in, 1);
+#endif
+}
+
+long unref(volatile long & in)
+{
+#if defined(DJV_WINDOWS)
+    return InterlockedDecrement(&in);
+#else
+    return __sync_sub_and_fetch(&in, 1);
+#endif
+}
+
+} // namespace
+
+Pixel_Data::Shared::Shared() :
+    count(1),
+    io   (0)
+{}
+
+Pixel_Data::Shared::~Shared()
+{
+    delete io;
+}
+
 void Pixel_Data::init()
 {
     _channels       = 0;
+    _shared         = 0;
     _bytes_pixel    = 0;
     _bytes_scanline = 0;
     _bytes_data     = 0;
     _p              = 0;
-    _io             = 0;
+    _tag            = Memory::TAG_IMAGE;
 }
 
 Pixel_Data::Pixel_Data()
@@ -138,7 +174,7 @@ Pixel_Data::Pixel_Data(
 
 Pixel_Data::~Pixel_Data()
 {
-    delete _io;
+    release();
 }
 
 Pixel_Data & Pixel_Data::operator = (const Pixel_Data & in)
@@ -153,8 +189,21 @@ Pixel_Data & Pixel_Data::operator = (const Pixel_Data & in)
 
 void Pixel_Data::set(const Pixel_Data & in)
 {
-    set(in._info);
-    Memory::copy(in.data(), data(), _bytes_data);
+    if (in._shared)
+    {
+        ref(in._shared->count);
+    }
+
+    release();
+
+    _info           = in._info;
+    _channels       = in._channels;
+    _shared         = in._shared;
+    _bytes_pixel    = in._bytes_pixel;
+    _bytes_scanline = in._bytes_scanline;
+    _bytes_data     = in._bytes_data;
+    _p              = in._p;
+    _tag            = in._tag;
 }
 
 void Pixel_Data::set(
@@ -165,8 +214,6 @@ void Pixel_Data::set(
     //DJV_DEBUG("Pixel_Data::Pixel_Data");
     //DJV_DEBUG_PRINT("in = " << in);
 
-    delete _io;
-
     _info = in;
 
     _channels = Pixel::channels(_info.pixel);
@@ -179,126 +226,91 @@ void Pixel_Data::set(
     //DJV_DEBUG_PRINT("bytes scanline = " << _bytes_scanline);
     //DJV_DEBUG_PRINT("bytes data = " << _bytes_data);
 
+    // Re-use the memory unless it is shared with another copy.
+
+    if (_shared && _shared->count > 1)
+    {
+        release();
+    }
+
+    if (! _shared)
+    {
+        _shared = new Shared;
+    }
+
+    _shared->data.tag(_tag);
+
+    delete _shared->io;
+    _shared->io = io;
+
     if (p)
     {
-        _data.size(0);
+        _shared->data.size(0);
         
         _p = p;
     }
     else
     {
-        _data.size(_bytes_data);
+        _shared->data.size(_bytes_data);
         
-        _p = _data();
+        _p = _shared->data();
     }
-    
-    _io = io;
 }
 
 void Pixel_Data::zero()
 {
     //DJV_DEBUG("Pixel_Data::zero");
 
-    _data.zero();
+    Memory::zero(data(), _bytes_data);
 }
 
-size_t Pixel_Data::bytes_scanline(const Pixel_Data_Info & in)
+void Pixel_Data::detach_copy()
 {
-    return (in.size.x * Pixel::bytes(in.pixel) * in.align) / in.align;
-}
-
-size_t Pixel_Data::bytes_data(const Pixel_Data_Info & in)
-{
-    return in.size.y * bytes_scanline(in);
-}
+    //DJV_DEBUG("Pixel_Data::detach_copy");
 
-void Pixel_Data::proxy_scale(
-    const Pixel_Data &     in,
-    Pixel_Data *           out,
-    Pixel_Data_Info::PROXY proxy)
-{
-    DJV_ASSERT(out);
+    Shared * shared = new Shared;
+    shared->data.tag(_tag);
+    shared->data.size(_bytes_data);
 
-    //DJV_DEBUG("Pixel_Data::proxy_scale");
-    //DJV_DEBUG_PRINT("in = " << in);
-    //DJV_DEBUG_PRINT("out = " << *out);
-    //DJV_DEBUG_PRINT("proxy = " << proxy);
+    Memory::copy(_p, shared->data(), _bytes_data);
 
-    const int  w           = out->w();
-    const int  h           = out->h();
-    const int  proxy_scale = Pixel_Data::proxy_scale(proxy);
-    const bool bgr         = in.info().bgr != out->info().bgr;
-    const bool endian      = in.info().endian != Memory::endian();
+    release();
 
-    const bool fast = in.pixel() == out->pixel() && ! bgr;
+    _shared = shared;
+    _p = _shared->data();
+}
 
-    Memory_Buffer<uint8_t> tmp;
+void Pixel_Data::memory_tag(Memory::TAG in)
+{
+    _tag = in;
 
-    if (! fast && endian)
+    if (_shared)
     {
-        tmp.size(w * proxy_scale * Pixel::bytes(in.pixel()));
+        _shared->data.tag(in);
     }
+}
 
-    for (int y = 0; y < h; ++y)
+void Pixel_Data::release()
+{
+    if (_shared && 0 == unref(_shared->count))
     {
-        const uint8_t * in_p = in.data(0, y * proxy_scale);
-        uint8_t * out_p = out->data(0, y);
-
-        if (fast)
-        {
-            const size_t bytes_pixel = in.bytes_pixel();
-            const size_t in_stride   = bytes_pixel * proxy_scale;
-            const size_t out_stride  = bytes_pixel;
-
-            for (
-                int x = 0;
-                x < w;
-                ++x, in_p += in_stride, out_p += out_stride)
-            {
-                switch (bytes_pixel)
-                {
-                    case 16: out_p[15] = in_p[15];
-                    case 15: out_p[14] = in_p[14];
-                    case 14: out_p[13] = in_p[13];
-                    case 13: out_p[12] = in_p[12];
-                    case 12: out_p[11] = in_p[11];
-                    case 11: out_p[10] = in_p[10];
-                    case 10: out_p[9]  = in_p[9];
-                    case 9:  out_p[8]  = in_p[8];
-                    case 8:  out_p[7]  = in_p[7];
-                    case 7:  out_p[6]  = in_p[6];
-                    case 6:  out_p[5]  = in_p[5];
-                    case 5:  out_p[4]  = in_p[4];
-                    case 4:  out_p[3]  = in_p[3];
-                    case 3:  out_p[2]  = in_p[2];
-                    case 2:  out_p[1]  = in_p[1];
-                    case 1:  out_p[0]  = in_p[0];
-                }
-            }
-        }
-        else
-        {
-            if (endian)
-            {
-                Memory::endian(
-                    in_p,
-                    tmp(),
-                    w * proxy_scale,
-                    Pixel::bytes(in.pixel()));
-                
-                in_p = tmp();
-            }
-
-            Pixel::convert(
-                in_p,
-                in.pixel(),
-                out_p,
-                out->pixel(),
-                w,
-                proxy_scale,
-                bgr);
-        }
+        delete _shared;
     }
+
+    _shared = 0;
+    _p = 0;
+}
+
+size_t Pixel_Data::bytes_scanline(const Pixel_Data_Info & in)
+{
+    const size_t align = Math::max(in.align, 1);
+
+    return (in.size.x * Pixel::bytes(in.pixel) + align - 1) / align * align;
+}
+
+size_t Pixel_Data::bytes_data(const Pixel_Data_Info & in)
+{
+    return in.size.y * bytes_scanline(in);
 }
 
 int Pixel_Data::proxy_scale(Pixel_Data_Info::PROXY proxy)
@@ -326,102 +338,26 @@ Box2i Pixel_Data::proxy_scale(const Box2i & in, Pixel_Data_Info::PROXY proxy)
         Math::ceil(in.size.y / static_cast<double>(scale)));
 }
 
-void Pixel_Data::planar_interleave(
+void Pixel_Data::crop(
     const Pixel_Data & in,
-    Pixel_Data * out,
-    Pixel_Data_Info::PROXY proxy)
+    Pixel_Data *       out,
+    const Box2i &      area)
 {
     DJV_ASSERT(out);
-    DJV_ASSERT(in.pixel() == out->pixel());
-    DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
 
-    //DJV_DEBUG("Pixel_Data::planar_interleave");
+    //DJV_DEBUG("Pixel_Data::crop");
     //DJV_DEBUG_PRINT("in = " << in);
-    //DJV_DEBUG_PRINT("out = " << *out);
-    //DJV_DEBUG_PRINT("proxy = " << proxy);
-
-    const int w = out->w(), h = out->h();
-    const int proxy_scale = Pixel_Data::proxy_scale(proxy);
-    const int channels = out->channels();
-    const size_t bytes_pixel = out->bytes_pixel();
-    const int channel_bytes = Pixel::channel_bytes(out->pixel());
-
-    for (int c = 0; c < channels; ++c)
-    {
-        for (int y = 0; y < h; ++y)
-        {
-            const uint8_t * in_p = in.data() + (c * in.h() + y * proxy_scale) *
-                in.w() * channel_bytes;
-            
-            uint8_t * out_p = out->data(0, y) + c * channel_bytes;
-
-            for (
-                int x = 0;
-                x < w;
-                ++x, in_p += channel_bytes * proxy_scale, out_p += bytes_pixel)
-            {
-                switch (channel_bytes)
-                {
-                    case 4:
-                        out_p[3] = in_p[3];
-
-                    case 3:
-                        out_p[2] = in_p[2];
-
-                    case 2:
-                        out_p[1] = in_p[1];
-
-                    case 1:
-                        out_p[0] = in_p[0];
-                }
-            }
-        }
-    }
-}
+    //DJV_DEBUG_PRINT("area = " << area);
 
-void Pixel_Data::planar_deinterleave(const Pixel_Data & in, Pixel_Data * out)
-{
-    DJV_ASSERT(out);
-    DJV_ASSERT(in.pixel() == out->pixel());
-    DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
+    const Pixel_Data_View view(in, area);
 
-    //DJV_DEBUG("Pixel_Data::planar_deinterleave");
-    //DJV_DEBUG_PRINT("in = " << in);
-    //DJV_DEBUG_PRINT("out = " << *out);
+    out->set(view.info());
 
-    const int w = out->w(), h = out->h();
-    const int channels = out->channels();
-    const size_t bytes_pixel = out->bytes_pixel();
-    const int channel_bytes = Pixel::channel_bytes(out->pixel());
+    const size_t bytes = area.w * in.bytes_pixel();
 
-    for (int c = 0; c < channels; ++c)
+    for (int y = 0; y < area.h; ++y)
     {
-        for (int y = 0; y < h; ++y)
-        {
-            const uint8_t * in_p = in.data(0, y) + c * channel_bytes;
-            uint8_t * out_p = out->data() + (c * h + y) * w * channel_bytes;
-
-            for (
-                int x = 0;
-                x < w;
-                ++x, in_p += bytes_pixel, out_p += channel_bytes)
-            {
-                switch (channel_bytes)
-                {
-                    case 4:
-                        out_p[3] = in_p[3];
-
-                    case 3:
-                        out_p[2] = in_p[2];
-
-                    case 2:
-                        out_p[1] = in_p[1];
-
-                    case 1:
-                        out_p[0] = in_p[0];
-                }
-            }
-        }
+        Memory::copy(view.data(0, y), out->data(0, y), bytes);
     }
 }
 
@@ -449,6 +385,50 @@ void Pixel_Data::gradient(Pixel_Data * out)
     }
 }
 
+//------------------------------------------------------------------------------
+// Pixel_Data_View
+//------------------------------------------------------------------------------
+
+Pixel_Data_View::Pixel_Data_View() :
+    _bytes_pixel   (0),
+    _bytes_scanline(0),
+    _p             (0),
+    _writable      (false)
+{}
+
+Pixel_Data_View::Pixel_Data_View(const Pixel_Data & in, const Box2i & area)
+{
+    init(in, area);
+
+    _p        = in.is_valid() ? in.data(area.x, area.y) : 0;
+    _writable = false;
+}
+
+Pixel_Data_View::Pixel_Data_View(Pixel_Data * in, const Box2i & area)
+{
+    DJV_ASSERT(in);
+
+    init(*in, area);
+
+    _p        = in->is_valid() ? in->data(area.x, area.y) : 0;
+    _writable = true;
+}
+
+void Pixel_Data_View::init(const Pixel_Data & in, const Box2i & area)
+{
+    DJV_ASSERT(area.x >= 0 && area.x + area.w <= in.w());
+    DJV_ASSERT(area.y >= 0 && area.y + area.h <= in.h());
+
+    //DJV_DEBUG("Pixel_Data_View::init");
+    //DJV_DEBUG_PRINT("in = " << in);
+    //DJV_DEBUG_PRINT("area = " << area);
+
+    _info           = in.info();
+    _info.size      = area.size;
+    _bytes_pixel    = in.bytes_pixel();
+    _bytes_scanline = in.bytes_scanline();
+}
+
 //------------------------------------------------------------------------------
 
 bool operator == (const Pixel_Data_Info & a, const Pixel_Data_Info & b)
@@ -470,10 +450,29 @@ bool operator != (const Pixel_Data_Info & a, const Pixel_Data_Info & b)
 
 bool operator == (const Pixel_Data & a, const Pixel_Data & b)
 {
-    return
-        a.info() == b.info() &&
-        a.bytes_data() == b.bytes_data() &&
-        Memory::compare(a.data(), b.data(), a.bytes_data());
+    if (a.info() != b.info() || a.bytes_data() != b.bytes_data())
+    {
+        return false;
+    }
+
+    // Don't compare the alignment padding.
+
+    const size_t bytes = a.w() * a.bytes_pixel();
+
+    if (bytes == a.bytes_scanline())
+    {
+        return 0 == Memory::compare(a.data(), b.data(), a.bytes_data());
+    }
+
+    for (int y = 0; y < a.h(); ++y)
+    {
+        if (Memory::compare(a.data(0, y), b.data(0, y), bytes) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 bool operator != (const Pixel_Data & a, const Pixel_Data & b)
@@ -509,5 +508,10 @@ Debug & operator << (Debug & debug, const Pixel_Data & in)
     return debug << in.info();
 }
 
+Debug & operator << (Debug & debug, const Pixel_Data_View & in)
+{
+    return debug << in.info();
+}
+
 } // djv
 
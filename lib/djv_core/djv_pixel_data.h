@@ -50,6 +50,11 @@ class File_Io;
 //! \class Pixel_Data_Info
 //!
 //! This class provides pixel data information.
+//!
+//! Scanlines are padded to a multiple of the alignment, in bytes, which must
+//! be a power of two. The default of one packs the scanlines together; file
+//! formats may need four, and 32 or 64 starts every scanline on a SIMD
+//! boundary.
 //------------------------------------------------------------------------------
 
 class DJV_CORE_EXPORT Pixel_Data_Info
@@ -108,6 +113,10 @@ private:
 //! \class Pixel_Data
 //!
 //! This class provides pixel data.
+//!
+//! Copies share the same memory, which is only copied when it is modified
+//! with one of the non-const functions. Pointers returned by the non-const
+//! functions should not be kept after the pixel data is copied.
 //------------------------------------------------------------------------------
 
 class DJV_CORE_EXPORT Pixel_Data
@@ -132,7 +141,8 @@ public:
 
     Pixel_Data & operator = (const Pixel_Data &);
 
-    //! Copy the ppixel data.
+    //! Copy the pixel data. The memory is shared until either copy is
+    //! modified.
 
     void set(const Pixel_Data &);
 
@@ -196,7 +206,8 @@ public:
 
     inline size_t bytes_pixel() const;
 
-    //! Get the number of bytes in a scanline.
+    //! Get the number of bytes in a scanline, including the alignment
+    //! padding.
 
     inline size_t bytes_scanline() const;
 
@@ -204,13 +215,30 @@ public:
 
     inline size_t bytes_data() const;
 
-    //! Proxy scale.
+    //! Set the memory accounting tag. The default is Memory::TAG_IMAGE.
+
+    void memory_tag(Memory::TAG);
+
+    //! Get the memory accounting tag.
+
+    inline Memory::TAG memory_tag() const;
+
+    //! Proxy scale. Each output pixel is the average of the block of input
+    //! pixels it covers; blocks on the right and bottom edges are averaged
+    //! over the pixels inside the image.
 
     static void proxy_scale(
         const Pixel_Data &,
         Pixel_Data *,
         Pixel_Data_Info::PROXY);
 
+    //! Create the 1/2, 1/4, and 1/8 proxy scales from a single pass over the
+    //! input. The output uses the input pixel type and the machine endian.
+    //! The results are the same as proxy_scale(), up to floating-point
+    //! rounding.
+
+    static void proxy_pyramid(const Pixel_Data &, List<Pixel_Data> *);
+
     //! Calculate the proxy scale.
 
     static int proxy_scale(Pixel_Data_Info::PROXY);
@@ -223,7 +251,13 @@ public:
 
     static Box2i proxy_scale(const Box2i &, Pixel_Data_Info::PROXY);
 
-    //! Get the number of bytes in a scanline.
+    //! Copy a region of the pixel data. The output is resized to the region,
+    //! which must be inside the input.
+
+    static void crop(const Pixel_Data &, Pixel_Data *, const Box2i &);
+
+    //! Get the number of bytes in a scanline, including the alignment
+    //! padding.
 
     static size_t bytes_scanline(const Pixel_Data_Info &);
 
@@ -231,14 +265,16 @@ public:
 
     static size_t bytes_data(const Pixel_Data_Info &);
 
-    //! Interleave channels.
+    //! Interleave channels. The planes are packed together, so the planar
+    //! data must use an alignment of one.
 
     static void planar_interleave(
         const Pixel_Data &,
         Pixel_Data *,
         Pixel_Data_Info::PROXY = Pixel_Data_Info::PROXY_NONE);
 
-    //! De-interleave channels.
+    //! De-interleave channels. The planes are packed together, so the
+    //! planar data must use an alignment of one.
 
     static void planar_deinterleave(const Pixel_Data &, Pixel_Data *);
 
@@ -248,18 +284,122 @@ public:
 
 private:
 
+    struct Shared
+    {
+        Shared();
+
+        ~Shared();
+
+        volatile long          count;
+        Memory_Buffer<uint8_t> data;
+        File_Io *              io;
+    };
+
     void init();
-    void alloc();
-    void del();
-
-    Pixel_Data_Info        _info;
-    int                    _channels;
-    Memory_Buffer<uint8_t> _data;
-    size_t                 _bytes_pixel;
-    size_t                 _bytes_scanline;
-    size_t                 _bytes_data;
-    const uint8_t *        _p;
-    File_Io *              _io;
+    inline void detach();
+    void detach_copy();
+    void release();
+
+    Pixel_Data_Info _info;
+    int             _channels;
+    Shared *        _shared;
+    size_t          _bytes_pixel;
+    size_t          _bytes_scanline;
+    size_t          _bytes_data;
+    const uint8_t * _p;
+    Memory::TAG     _tag;
+};
+
+//------------------------------------------------------------------------------
+//! \class Pixel_Data_View
+//!
+//! This class provides a view of a region of pixel data.
+//!
+//! The view references the memory of the pixel data instead of copying it,
+//! using the scanline stride of the pixel data. It is only valid until the
+//! pixel data is modified, re-allocated, or destroyed.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Pixel_Data_View
+{
+public:
+
+    //! Constructor.
+
+    Pixel_Data_View();
+
+    //! Constructor. The region must be inside the pixel data. The view is
+    //! read-only.
+
+    Pixel_Data_View(const Pixel_Data &, const Box2i &);
+
+    //! Constructor. The region must be inside the pixel data. The pixel
+    //! data is detached from any copies before the view is created.
+
+    Pixel_Data_View(Pixel_Data *, const Box2i &);
+
+    //! Get the information. The size is the size of the region.
+
+    inline const Pixel_Data_Info & info() const;
+
+    //! Get the dimensions.
+
+    inline const V2i & size() const;
+
+    //! Get the width.
+
+    inline int w() const;
+
+    //! Get the height.
+
+    inline int h() const;
+
+    //! Get the pixel.
+
+    inline Pixel::PIXEL pixel() const;
+
+    //! Get whether the view is valid.
+
+    inline bool is_valid() const;
+
+    //! Get whether the view can be modified.
+
+    inline bool is_writable() const;
+
+    //! Get a pointer to the data. The view must be writable.
+
+    inline uint8_t * data();
+
+    //! Get a pointer to the data.
+
+    inline const uint8_t * data() const;
+
+    //! Get a pointer to the data. The view must be writable.
+
+    inline uint8_t * data(int x, int y);
+
+    //! Get a pointer to the data.
+
+    inline const uint8_t * data(int x, int y) const;
+
+    //! Get the number of bytes in a pixel.
+
+    inline size_t bytes_pixel() const;
+
+    //! Get the number of bytes in a scanline. This is the stride of the pixel
+    //! data rather than the width of the region.
+
+    inline size_t bytes_scanline() const;
+
+private:
+
+    void init(const Pixel_Data &, const Box2i &);
+
+    Pixel_Data_Info _info;
+    size_t          _bytes_pixel;
+    size_t          _bytes_scanline;
+    const uint8_t * _p;
+    bool            _writable;
 };
 
 //------------------------------------------------------------------------------
@@ -282,6 +422,7 @@ DJV_CORE_EXPORT String & operator << (String &, Pixel_Data_Info::PROXY);
 DJV_CORE_EXPORT Debug & operator << (Debug &, Pixel_Data_Info::PROXY);
 DJV_CORE_EXPORT Debug & operator << (Debug &, const Pixel_Data_Info &);
 DJV_CORE_EXPORT Debug & operator << (Debug &, const Pixel_Data &);
+DJV_CORE_EXPORT Debug & operator << (Debug &, const Pixel_Data_View &);
 
 } // djv
 
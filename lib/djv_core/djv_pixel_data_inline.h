@@ -31,6 +31,8 @@
 
 //! \file djv_pixel_data_inline.h
 
+#include <djv_assert.h>
+
 namespace djv
 {
 
@@ -80,7 +82,9 @@ bool Pixel_Data::is_valid() const
 
 inline uint8_t * Pixel_Data::data()
 {
-    return _data();
+    detach();
+
+    return const_cast<uint8_t *>(_p);
 }
 
 inline const uint8_t * Pixel_Data::data() const
@@ -90,12 +94,14 @@ inline const uint8_t * Pixel_Data::data() const
 
 inline uint8_t * Pixel_Data::data(int x, int y)
 {
-    return _data() + (y * _info.size.x + x) * _bytes_pixel;
+    detach();
+
+    return const_cast<uint8_t *>(_p) + y * _bytes_scanline + x * _bytes_pixel;
 }
 
 inline const uint8_t * Pixel_Data::data(int x, int y) const
 {
-    return _p + (y * _info.size.x + x) * _bytes_pixel;
+    return _p + y * _bytes_scanline + x * _bytes_pixel;
 }
 
 inline size_t Pixel_Data::bytes_pixel() const
@@ -113,4 +119,93 @@ inline size_t Pixel_Data::bytes_data() const
     return _bytes_data;
 }
 
+inline Memory::TAG Pixel_Data::memory_tag() const
+{
+    return _tag;
+}
+
+inline void Pixel_Data::detach()
+{
+    // Copy the memory if it is shared with another copy or if it belongs to
+    // someone else, like a memory mapped file.
+
+    if (_p && (_shared->count > 1 || _p != _shared->data()))
+    {
+        detach_copy();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Pixel_Data_View
+//------------------------------------------------------------------------------
+
+inline const Pixel_Data_Info & Pixel_Data_View::info() const
+{
+    return _info;
+}
+
+inline const V2i & Pixel_Data_View::size() const
+{
+    return _info.size;
+}
+
+inline int Pixel_Data_View::w() const
+{
+    return _info.size.x;
+}
+
+inline int Pixel_Data_View::h() const
+{
+    return _info.size.y;
+}
+
+inline Pixel::PIXEL Pixel_Data_View::pixel() const
+{
+    return _info.pixel;
+}
+
+inline bool Pixel_Data_View::is_valid() const
+{
+    return _p;
+}
+
+inline bool Pixel_Data_View::is_writable() const
+{
+    return _writable;
+}
+
+inline uint8_t * Pixel_Data_View::data()
+{
+    DJV_ASSERT(_writable);
+
+    return const_cast<uint8_t *>(_p);
+}
+
+inline const uint8_t * Pixel_Data_View::data() const
+{
+    return _p;
+}
+
+inline uint8_t * Pixel_Data_View::data(int x, int y)
+{
+    DJV_ASSERT(_writable);
+
+    return const_cast<uint8_t *>(_p) + y * _bytes_scanline + x * _bytes_pixel;
+}
+
+inline const uint8_t * Pixel_Data_View::data(int x, int y) const
+{
+    return _p + y * _bytes_scanline + x * _bytes_pixel;
+}
+
+inline size_t Pixel_Data_View::bytes_pixel() const
+{
+    return _bytes_pixel;
+}
+
+inline size_t Pixel_Data_View::bytes_scanline() const
+{
+    return _bytes_scanline;
+}
+
 } // djv
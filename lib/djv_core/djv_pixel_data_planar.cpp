@@ -0,0 +1,559 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_pixel_data_planar.cpp
+
+#include <djv_pixel_data.h>
+
+#include <djv_assert.h>
+#include <djv_cpu_private.h>
+#include <djv_thread_pool.h>
+
+namespace djv
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Scalar Kernels
+//------------------------------------------------------------------------------
+
+template<typename T, int CHANNELS>
+inline void interleave_scalar(
+    const uint8_t * const * in,
+    uint8_t *               out,
+    int                     begin,
+    int                     end)
+{
+    T * out_p = reinterpret_cast<T *>(out) + begin * CHANNELS;
+
+    for (int x = begin; x < end; ++x)
+    {
+        for (int c = 0; c < CHANNELS; ++c, ++out_p)
+        {
+            *out_p = reinterpret_cast<const T *>(in[c])[x];
+        }
+    }
+}
+
+template<typename T, int CHANNELS>
+inline void deinterleave_scalar(
+    const uint8_t * in,
+    uint8_t * const * out,
+    int               begin,
+    int               end)
+{
+    const T * in_p = reinterpret_cast<const T *>(in) + begin * CHANNELS;
+
+    for (int x = begin; x < end; ++x)
+    {
+        for (int c = 0; c < CHANNELS; ++c, ++in_p)
+        {
+            reinterpret_cast<T *>(out[c])[x] = *in_p;
+        }
+    }
+}
+
+#if defined(DJV_CPU_SIMD)
+
+//------------------------------------------------------------------------------
+// SIMD Kernels
+//------------------------------------------------------------------------------
+
+// The SIMD kernels transpose sixteen bytes from each channel at a time. Each
+// output vector is built by shuffling the bytes it needs out of each input
+// vector, and the shuffle masks are computed once for every combination of
+// channels and channel bytes.
+
+struct Masks
+{
+    Masks()
+    {
+        for (int channels = 2; channels <= 4; ++channels)
+        {
+            for (int bytes = 1, b = 0; bytes <= 4; bytes *= 2, ++b)
+            {
+                init(channels, bytes, b);
+            }
+        }
+    }
+
+    void init(int channels, int bytes, int b)
+    {
+        uint8_t (* const in)[4][16]  = interleave  [channels - 2][b];
+        uint8_t (* const out)[4][16] = deinterleave[channels - 2][b];
+
+        for (int k = 0; k < channels; ++k)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                for (int i = 0; i < 16; ++i)
+                {
+                    // Interleaved byte (16 * k + i) comes from channel c.
+
+                    const int j = 16 * k + i;
+                    const int e = j / bytes;
+
+                    in[k][c][i] = e % channels == c ?
+                        (e / channels) * bytes + j % bytes :
+                        0x80;
+
+                    // Planar byte i of channel c comes from interleaved
+                    // vector k.
+
+                    const int src =
+                        ((i / bytes) * channels + c) * bytes + i % bytes;
+
+                    out[k][c][i] = src / 16 == k ? src % 16 : 0x80;
+                }
+            }
+        }
+    }
+
+    uint8_t interleave   [3][3][4][4][16];
+    uint8_t deinterleave [3][3][4][4][16];
+};
+
+const Masks & masks()
+{
+    static const Masks data;
+
+    return data;
+}
+
+// The kernels return the number of bytes processed in each channel; the
+// remainder is left for the scalar kernel.
+
+template<int CHANNELS>
+DJV_CPU_TARGET("ssse3")
+int interleave_ssse3(
+    const uint8_t * const * in,
+    uint8_t *               out,
+    int                     size,
+    const uint8_t           (* mask)[4][16])
+{
+    __m128i m [CHANNELS][CHANNELS];
+
+    for (int k = 0; k < CHANNELS; ++k)
+    {
+        for (int c = 0; c < CHANNELS; ++c)
+        {
+            m[k][c] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(mask[k][c]));
+        }
+    }
+
+    int i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i v [CHANNELS];
+
+        for (int c = 0; c < CHANNELS; ++c)
+        {
+            v[c] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(in[c] + i));
+        }
+
+        __m128i * out_p = reinterpret_cast<__m128i *>(out + i * CHANNELS);
+
+        for (int k = 0; k < CHANNELS; ++k)
+        {
+            __m128i tmp = _mm_shuffle_epi8(v[0], m[k][0]);
+
+            for (int c = 1; c < CHANNELS; ++c)
+            {
+                tmp = _mm_or_si128(tmp, _mm_shuffle_epi8(v[c], m[k][c]));
+            }
+
+            _mm_storeu_si128(out_p + k, tmp);
+        }
+    }
+
+    return i;
+}
+
+template<int CHANNELS>
+DJV_CPU_TARGET("ssse3")
+int deinterleave_ssse3(
+    const uint8_t *   in,
+    uint8_t * const * out,
+    int               size,
+    const uint8_t     (* mask)[4][16])
+{
+    __m128i m [CHANNELS][CHANNELS];
+
+    for (int k = 0; k < CHANNELS; ++k)
+    {
+        for (int c = 0; c < CHANNELS; ++c)
+        {
+            m[k][c] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(mask[k][c]));
+        }
+    }
+
+    int i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i * in_p =
+            reinterpret_cast<const __m128i *>(in + i * CHANNELS);
+
+        __m128i v [CHANNELS];
+
+        for (int k = 0; k < CHANNELS; ++k)
+        {
+            v[k] = _mm_loadu_si128(in_p + k);
+        }
+
+        for (int c = 0; c < CHANNELS; ++c)
+        {
+            __m128i tmp = _mm_shuffle_epi8(v[0], m[0][c]);
+
+            for (int k = 1; k < CHANNELS; ++k)
+            {
+                tmp = _mm_or_si128(tmp, _mm_shuffle_epi8(v[k], m[k][c]));
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out[c] + i), tmp);
+        }
+    }
+
+    return i;
+}
+
+#endif // DJV_CPU_SIMD
+
+//------------------------------------------------------------------------------
+// Scanline Functions
+//------------------------------------------------------------------------------
+
+template<typename T, int CHANNELS>
+void interleave(const uint8_t * const * in, uint8_t * out, int w)
+{
+    int x = 0;
+
+#if defined(DJV_CPU_SIMD)
+
+    if (Cpu::global().ssse3)
+    {
+        const int b = sizeof(T) / 2;
+
+        x = interleave_ssse3<CHANNELS>(
+            in,
+            out,
+            w * sizeof(T),
+            masks().interleave[CHANNELS - 2][b]) / sizeof(T);
+    }
+
+#endif // DJV_CPU_SIMD
+
+    interleave_scalar<T, CHANNELS>(in, out, x, w);
+}
+
+template<typename T, int CHANNELS>
+void deinterleave(const uint8_t * in, uint8_t * const * out, int w)
+{
+    int x = 0;
+
+#if defined(DJV_CPU_SIMD)
+
+    if (Cpu::global().ssse3)
+    {
+        const int b = sizeof(T) / 2;
+
+        x = deinterleave_ssse3<CHANNELS>(
+            in,
+            out,
+            w * sizeof(T),
+            masks().deinterleave[CHANNELS - 2][b]) / sizeof(T);
+    }
+
+#endif // DJV_CPU_SIMD
+
+    deinterleave_scalar<T, CHANNELS>(in, out, x, w);
+}
+
+typedef void (Interleave_Fnc)(const uint8_t * const *, uint8_t *, int);
+typedef void (Deinterleave_Fnc)(const uint8_t *, uint8_t * const *, int);
+
+// The tables are indexed by the number of channels minus two and the channel
+// bytes divided by two.
+
+Interleave_Fnc * const interleave_table [3][3] =
+{
+    {
+        interleave<uint8_t, 2>,
+        interleave<uint16_t, 2>,
+        interleave<uint32_t, 2>
+    },
+    {
+        interleave<uint8_t, 3>,
+        interleave<uint16_t, 3>,
+        interleave<uint32_t, 3>
+    },
+    {
+        interleave<uint8_t, 4>,
+        interleave<uint16_t, 4>,
+        interleave<uint32_t, 4>
+    }
+};
+
+Deinterleave_Fnc * const deinterleave_table [3][3] =
+{
+    {
+        deinterleave<uint8_t, 2>,
+        deinterleave<uint16_t, 2>,
+        deinterleave<uint32_t, 2>
+    },
+    {
+        deinterleave<uint8_t, 3>,
+        deinterleave<uint16_t, 3>,
+        deinterleave<uint32_t, 3>
+    },
+    {
+        deinterleave<uint8_t, 4>,
+        deinterleave<uint16_t, 4>,
+        deinterleave<uint32_t, 4>
+    }
+};
+
+//------------------------------------------------------------------------------
+// Planar_Interleave
+//------------------------------------------------------------------------------
+
+// Scanlines are interleaved one at a time, so the channel planes are read
+// sequentially and each output scanline is only written once. When a proxy
+// scale is given, the input scanlines for each output scanline are
+// interleaved into a small temporary image which is then box filtered.
+
+class Planar_Interleave : public Thread_Range
+{
+public:
+
+    Planar_Interleave(
+        const Pixel_Data &     in,
+        Pixel_Data *           out,
+        Pixel_Data_Info::PROXY proxy) :
+        _in      (in),
+        _out     (out),
+        _proxy   (proxy),
+        _scale   (Pixel_Data::proxy_scale(proxy)),
+        _channels(in.channels()),
+        _bytes   (Pixel::channel_bytes(in.pixel())),
+        _fnc     (
+            _channels > 1 ?
+            interleave_table[_channels - 2][_bytes / 2] :
+            0)
+    {}
+
+    void run(int begin, int end)
+    {
+        if (Pixel_Data_Info::PROXY_NONE == _proxy)
+        {
+            for (int y = begin; y < end; ++y)
+            {
+                scanline(y, _out->data(0, y));
+            }
+
+            return;
+        }
+
+        Pixel_Data_Info info = _in.info();
+        info.proxy = Pixel_Data_Info::PROXY_NONE;
+
+        Pixel_Data tmp;
+        tmp.memory_tag(Memory::TAG_TEMP);
+
+        Pixel_Data proxy;
+        proxy.memory_tag(Memory::TAG_TEMP);
+        proxy.set(Pixel_Data_Info(V2i(_out->w(), 1), _in.pixel()));
+
+        for (int y = begin; y < end; ++y)
+        {
+            info.size.y = Math::min(_scale, _in.h() - y * _scale);
+
+            tmp.set(info);
+
+            for (int i = 0; i < info.size.y; ++i)
+            {
+                scanline(y * _scale + i, tmp.data(0, i));
+            }
+
+            Pixel_Data::proxy_scale(tmp, &proxy, _proxy);
+
+            Memory::copy(
+                static_cast<const Pixel_Data &>(proxy).data(),
+                _out->data(0, y),
+                _out->bytes_scanline());
+        }
+    }
+
+private:
+
+    void scanline(int y, uint8_t * out)
+    {
+        const size_t plane = _in.w() * _in.h() * _bytes;
+
+        const uint8_t * in [Pixel::channels_max];
+
+        in[0] = _in.data() + y * _in.w() * _bytes;
+
+        for (int c = 1; c < _channels; ++c)
+        {
+            in[c] = in[c - 1] + plane;
+        }
+
+        if (_fnc)
+        {
+            _fnc(in, out, _in.w());
+        }
+        else
+        {
+            Memory::copy(in[0], out, _in.w() * _bytes);
+        }
+    }
+
+    const Pixel_Data &     _in;
+    Pixel_Data *           _out;
+    Pixel_Data_Info::PROXY _proxy;
+    int                    _scale;
+    int                    _channels;
+    int                    _bytes;
+    Interleave_Fnc *       _fnc;
+};
+
+//------------------------------------------------------------------------------
+// Planar_Deinterleave
+//------------------------------------------------------------------------------
+
+class Planar_Deinterleave : public Thread_Range
+{
+public:
+
+    Planar_Deinterleave(const Pixel_Data & in, Pixel_Data * out) :
+        _in      (in),
+        _out     (out),
+        _channels(in.channels()),
+        _bytes   (Pixel::channel_bytes(in.pixel())),
+        _fnc     (
+            _channels > 1 ?
+            deinterleave_table[_channels - 2][_bytes / 2] :
+            0)
+    {}
+
+    void run(int begin, int end)
+    {
+        const int w = _out->w();
+
+        const size_t plane = w * _out->h() * _bytes;
+
+        for (int y = begin; y < end; ++y)
+        {
+            uint8_t * out [Pixel::channels_max];
+
+            out[0] = _out->data() + y * w * _bytes;
+
+            for (int c = 1; c < _channels; ++c)
+            {
+                out[c] = out[c - 1] + plane;
+            }
+
+            if (_fnc)
+            {
+                _fnc(_in.data(0, y), out, w);
+            }
+            else
+            {
+                Memory::copy(_in.data(0, y), out[0], w * _bytes);
+            }
+        }
+    }
+
+private:
+
+    const Pixel_Data & _in;
+    Pixel_Data *       _out;
+    int                _channels;
+    int                _bytes;
+    Deinterleave_Fnc * _fnc;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Pixel_Data
+//------------------------------------------------------------------------------
+
+void Pixel_Data::planar_interleave(
+    const Pixel_Data &     in,
+    Pixel_Data *           out,
+    Pixel_Data_Info::PROXY proxy)
+{
+    DJV_ASSERT(out);
+    DJV_ASSERT(in.pixel() == out->pixel());
+    DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
+    DJV_ASSERT(out->size() == proxy_scale(in.size(), proxy));
+    DJV_ASSERT(in.bytes_scanline() == in.w() * in.bytes_pixel());
+
+    //DJV_DEBUG("Pixel_Data::planar_interleave");
+    //DJV_DEBUG_PRINT("in = " << in);
+    //DJV_DEBUG_PRINT("out = " << *out);
+    //DJV_DEBUG_PRINT("proxy = " << proxy);
+
+    out->data();
+
+    Planar_Interleave fnc(in, out, proxy);
+
+    Thread_Pool::global()->parallel_for(0, out->h(), fnc, 16);
+}
+
+void Pixel_Data::planar_deinterleave(const Pixel_Data & in, Pixel_Data * out)
+{
+    DJV_ASSERT(out);
+    DJV_ASSERT(in.pixel() == out->pixel());
+    DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
+    DJV_ASSERT(out->size() == in.size());
+    DJV_ASSERT(out->bytes_scanline() == out->w() * out->bytes_pixel());
+
+    //DJV_DEBUG("Pixel_Data::planar_deinterleave");
+    //DJV_DEBUG_PRINT("in = " << in);
+    //DJV_DEBUG_PRINT("out = " << *out);
+
+    out->data();
+
+    Planar_Deinterleave fnc(in, out);
+
+    Thread_Pool::global()->parallel_for(0, out->h(), fnc, 16);
+}
+
+} // djv
@@ -0,0 +1,706 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_pixel_data_proxy.cpp
+
+#include <djv_pixel_data.h>
+
+#include <djv_assert.h>
+#include <djv_cpu_private.h>
+#include <djv_math.h>
+#include <djv_memory_buffer.h>
+#include <djv_thread_pool.h>
+
+namespace djv
+{
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+// Accumulation
+//------------------------------------------------------------------------------
+
+// The box filter sums the input scanlines into an accumulator with one value
+// for each channel, and then sums and normalizes each block of pixels in the
+// accumulator. Integer pixels are summed with 32-bit integers, which is
+// exact for blocks of up to 8x8 16-bit pixels, and floating-point pixels are
+// summed with floats.
+
+template<Pixel::TYPE TYPE>
+struct Box_Traits;
+
+template<>
+struct Box_Traits<Pixel::U8>
+{
+    typedef Pixel::U8_T T;
+    typedef uint32_t    Acc;
+};
+
+template<>
+struct Box_Traits<Pixel::U10>
+{
+    typedef Pixel::U10_S T;
+    typedef uint32_t     Acc;
+};
+
+template<>
+struct Box_Traits<Pixel::U16>
+{
+    typedef Pixel::U16_T T;
+    typedef uint32_t     Acc;
+};
+
+template<>
+struct Box_Traits<Pixel::F16>
+{
+    typedef Pixel::F16_T T;
+    typedef float        Acc;
+};
+
+template<>
+struct Box_Traits<Pixel::F32>
+{
+    typedef Pixel::F32_T T;
+    typedef float        Acc;
+};
+
+#if defined(DJV_CPU_SIMD)
+
+// The SIMD kernels return the number of values accumulated; the remainder is
+// left for the scalar kernel.
+
+DJV_CPU_TARGET("sse2")
+size_t accumulate_sse2(const uint8_t * in, uint32_t * acc, size_t size)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+        const __m128i tmp [] =
+        {
+            _mm_unpacklo_epi16(lo, zero),
+            _mm_unpackhi_epi16(lo, zero),
+            _mm_unpacklo_epi16(hi, zero),
+            _mm_unpackhi_epi16(hi, zero)
+        };
+
+        __m128i * p = reinterpret_cast<__m128i *>(acc + i);
+
+        for (int j = 0; j < 4; ++j)
+        {
+            _mm_storeu_si128(
+                p + j,
+                _mm_add_epi32(_mm_loadu_si128(p + j), tmp[j]));
+        }
+    }
+
+    return i;
+}
+
+DJV_CPU_TARGET("sse2")
+size_t accumulate_sse2(const uint16_t * in, uint32_t * acc, size_t size)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+
+        __m128i * p = reinterpret_cast<__m128i *>(acc + i);
+
+        _mm_storeu_si128(
+            p,
+            _mm_add_epi32(_mm_loadu_si128(p), _mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_si128(
+            p + 1,
+            _mm_add_epi32(_mm_loadu_si128(p + 1), _mm_unpackhi_epi16(v, zero)));
+    }
+
+    return i;
+}
+
+DJV_CPU_TARGET("sse2")
+size_t accumulate_sse2(const float * in, float * acc, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        _mm_storeu_ps(
+            acc + i,
+            _mm_add_ps(_mm_loadu_ps(acc + i), _mm_loadu_ps(in + i)));
+        _mm_storeu_ps(
+            acc + i + 4,
+            _mm_add_ps(_mm_loadu_ps(acc + i + 4), _mm_loadu_ps(in + i + 4)));
+    }
+
+    return i;
+}
+
+#endif // DJV_CPU_SIMD
+
+// Add a scanline to the accumulator. The size is given in channels.
+
+template<typename T, typename ACC>
+inline void accumulate_scalar(const T * in, ACC * acc, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        acc[i] += in[i];
+    }
+}
+
+template<typename T, typename ACC>
+inline void accumulate(const T * in, ACC * acc, size_t size)
+{
+    size_t i = 0;
+
+#if defined(DJV_CPU_SIMD)
+
+    if (Cpu::global().sse2)
+    {
+        i = accumulate_sse2(in, acc, size);
+    }
+
+#endif // DJV_CPU_SIMD
+
+    accumulate_scalar(in + i, acc + i, size - i);
+}
+
+inline void accumulate(const Pixel::F16_T * in, float * acc, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        acc[i] += static_cast<float>(in[i]);
+    }
+}
+
+// The 10-bit channels are unpacked, so the size is given in pixels.
+
+inline void accumulate(const Pixel::U10_S * in, uint32_t * acc, size_t size)
+{
+    for (size_t i = 0; i < size; ++i, ++in, acc += 3)
+    {
+        acc[0] += in->r;
+        acc[1] += in->g;
+        acc[2] += in->b;
+    }
+}
+
+// Add one accumulator to another.
+
+template<typename ACC>
+inline void add(const ACC * in, ACC * acc, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        acc[i] += in[i];
+    }
+}
+
+// Normalize a sum.
+
+template<typename T>
+inline T normalize(uint32_t in, uint32_t count)
+{
+    return static_cast<T>((in + count / 2) / count);
+}
+
+template<typename T>
+inline T normalize(float in, uint32_t count)
+{
+    return static_cast<T>(in / count);
+}
+
+// Sum and normalize each block of pixels in the accumulator, giving one
+// output scanline. The rows are the number of scanlines in the accumulator.
+
+template<typename T, typename ACC>
+void store(
+    const ACC * acc,
+    int         w,
+    int         channels,
+    int         scale,
+    int         rows,
+    T *         out,
+    int         out_w)
+{
+    ACC tmp [Pixel::channels_max];
+
+    for (int x = 0; x < out_w; ++x)
+    {
+        const int size = Math::min(scale, w - x * scale);
+
+        const uint32_t count = size * rows;
+
+        const ACC * p = acc + x * scale * channels;
+
+        for (int c = 0; c < channels; ++c)
+        {
+            tmp[c] = p[c];
+        }
+
+        for (int i = 1; i < size; ++i)
+        {
+            p += channels;
+
+            for (int c = 0; c < channels; ++c)
+            {
+                tmp[c] += p[c];
+            }
+        }
+
+        for (int c = 0; c < channels; ++c, ++out)
+        {
+            *out = normalize<T>(tmp[c], count);
+        }
+    }
+}
+
+void store(
+    const uint32_t * acc,
+    int              w,
+    int,
+    int              scale,
+    int              rows,
+    Pixel::U10_S *   out,
+    int              out_w)
+{
+    for (int x = 0; x < out_w; ++x, ++out)
+    {
+        const int size = Math::min(scale, w - x * scale);
+
+        const uint32_t count = size * rows;
+
+        const uint32_t * p = acc + x * scale * 3;
+
+        uint32_t r = 0;
+        uint32_t g = 0;
+        uint32_t b = 0;
+
+        for (int i = 0; i < size; ++i, p += 3)
+        {
+            r += p[0];
+            g += p[1];
+            b += p[2];
+        }
+
+        Pixel::U10_S tmp;
+        tmp.r   = normalize<Pixel::U10_T>(r, count);
+        tmp.g   = normalize<Pixel::U10_T>(g, count);
+        tmp.b   = normalize<Pixel::U10_T>(b, count);
+        tmp.pad = 0;
+
+        *out = tmp;
+    }
+}
+
+// Swap the bytes of a scanline while copying it. The input and output may be
+// the same.
+
+void endian(const void * in, void * out, int w, Pixel::PIXEL pixel)
+{
+    if (Pixel::RGB_U10 == pixel)
+    {
+        Memory::endian(in, out, w, 4);
+    }
+    else
+    {
+        Memory::endian(
+            in,
+            out,
+            w * Pixel::channels(pixel),
+            Pixel::channel_bytes(pixel));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Box_Filter
+//------------------------------------------------------------------------------
+
+// This class provides the scanline processing shared by the proxy scale and
+// the proxy pyramid. Input scanlines are swapped to the machine endian before
+// they are accumulated, and output scanlines are converted to the output
+// pixel when it is different from the input and swapped to the output
+// endian.
+
+class Box_Filter
+{
+public:
+
+    Box_Filter(const Pixel_Data & in) :
+        _in      (in),
+        _w       (in.w()),
+        _channels(in.channels()),
+        _size    (Pixel::RGB_U10 == in.pixel() ? in.w() : in.w() * _channels),
+        _endian  (in.info().endian != Memory::endian())
+    {}
+
+    const Pixel_Data & in() const
+    {
+        return _in;
+    }
+
+    // Get an input scanline.
+
+    const uint8_t * scanline(int y, Memory_Buffer<uint8_t> & tmp) const
+    {
+        const uint8_t * p = _in.data(0, y);
+
+        if (_endian)
+        {
+            tmp.size(_in.bytes_scanline());
+
+            endian(p, tmp(), _w, _in.pixel());
+
+            p = tmp();
+        }
+
+        return p;
+    }
+
+    // Sum the input scanlines [y, y + rows) into the accumulator, and return
+    // the number of scanlines that are inside the image.
+
+    template<Pixel::TYPE TYPE>
+    int sum(
+        int                                 y,
+        int                                 rows,
+        typename Box_Traits<TYPE>::Acc *    acc,
+        Memory_Buffer<uint8_t> &            tmp) const
+    {
+        typedef typename Box_Traits<TYPE>::T T;
+
+        rows = Math::min(rows, _in.h() - y);
+
+        Memory::zero(acc, _w * _channels * sizeof(*acc));
+
+        for (int i = 0; i < rows; ++i)
+        {
+            accumulate(
+                reinterpret_cast<const T *>(scanline(y + i, tmp)),
+                acc,
+                _size);
+        }
+
+        return rows;
+    }
+
+    // Write an output scanline from the accumulator.
+
+    template<Pixel::TYPE TYPE>
+    void store(
+        const typename Box_Traits<TYPE>::Acc * acc,
+        int                                    scale,
+        int                                    rows,
+        Pixel_Data *                           out,
+        int                                    y,
+        Memory_Buffer<uint8_t> &               tmp) const
+    {
+        typedef typename Box_Traits<TYPE>::T T;
+
+        const bool convert =
+            out->pixel() != _in.pixel() ||
+            out->info().bgr != _in.info().bgr;
+
+        uint8_t * p = out->data(0, y);
+
+        if (convert)
+        {
+            tmp.size(out->w() * Pixel::bytes(_in.pixel()));
+
+            p = tmp();
+        }
+
+        djv::store(
+            acc,
+            _w,
+            _channels,
+            scale,
+            rows,
+            reinterpret_cast<T *>(p),
+            out->w());
+
+        if (convert)
+        {
+            Pixel::convert(
+                p,
+                _in.pixel(),
+                out->data(0, y),
+                out->pixel(),
+                out->w(),
+                1,
+                out->info().bgr != _in.info().bgr);
+        }
+
+        if (out->info().endian != Memory::endian())
+        {
+            endian(out->data(0, y), out->data(0, y), out->w(), out->pixel());
+        }
+    }
+
+    size_t acc_size() const
+    {
+        return _w * _channels;
+    }
+
+private:
+
+    const Pixel_Data & _in;
+    int                _w;
+    int                _channels;
+    size_t             _size;
+    bool               _endian;
+};
+
+//------------------------------------------------------------------------------
+// Proxy_Scale
+//------------------------------------------------------------------------------
+
+class Proxy_Scale : public Thread_Range
+{
+public:
+
+    Proxy_Scale(
+        const Pixel_Data & in,
+        Pixel_Data *       out,
+        int                scale) :
+        _filter(in),
+        _out   (out),
+        _scale (scale)
+    {}
+
+    void run(int begin, int end)
+    {
+        switch (Pixel::type(_filter.in().pixel()))
+        {
+            case Pixel::U8:  run<Pixel::U8> (begin, end); break;
+            case Pixel::U10: run<Pixel::U10>(begin, end); break;
+            case Pixel::U16: run<Pixel::U16>(begin, end); break;
+            case Pixel::F16: run<Pixel::F16>(begin, end); break;
+            case Pixel::F32: run<Pixel::F32>(begin, end); break;
+
+            default: break;
+        }
+    }
+
+private:
+
+    template<Pixel::TYPE TYPE>
+    void run(int begin, int end)
+    {
+        typedef typename Box_Traits<TYPE>::Acc Acc;
+
+        Memory_Buffer<Acc> acc(_filter.acc_size());
+
+        Memory_Buffer<uint8_t> tmp;
+
+        for (int y = begin; y < end; ++y)
+        {
+            const int rows =
+                _filter.template sum<TYPE>(y * _scale, _scale, acc(), tmp);
+
+            _filter.template store<TYPE>(acc(), _scale, rows, _out, y, tmp);
+        }
+    }
+
+    Box_Filter   _filter;
+    Pixel_Data * _out;
+    int          _scale;
+};
+
+//------------------------------------------------------------------------------
+// Proxy_Pyramid
+//------------------------------------------------------------------------------
+
+// Each task processes bands of eight input scanlines, which give four 1/2
+// scanlines, two 1/4 scanlines, and one 1/8 scanline. The smaller levels are
+// summed from the accumulators of the larger levels, so the results are the
+// same as filtering each level from the input, up to floating-point rounding.
+
+class Proxy_Pyramid : public Thread_Range
+{
+public:
+
+    Proxy_Pyramid(const Pixel_Data & in, List<Pixel_Data> * out) :
+        _filter(in),
+        _out   (out)
+    {}
+
+    void run(int begin, int end)
+    {
+        switch (Pixel::type(_filter.in().pixel()))
+        {
+            case Pixel::U8:  run<Pixel::U8> (begin, end); break;
+            case Pixel::U10: run<Pixel::U10>(begin, end); break;
+            case Pixel::U16: run<Pixel::U16>(begin, end); break;
+            case Pixel::F16: run<Pixel::F16>(begin, end); break;
+            case Pixel::F32: run<Pixel::F32>(begin, end); break;
+
+            default: break;
+        }
+    }
+
+private:
+
+    template<Pixel::TYPE TYPE>
+    void run(int begin, int end)
+    {
+        typedef typename Box_Traits<TYPE>::Acc Acc;
+
+        const size_t size = _filter.acc_size();
+
+        Memory_Buffer<Acc> acc(size * 7);
+
+        Acc * acc2 = acc();
+        Acc * acc4 = acc2 + size * 4;
+        Acc * acc8 = acc4 + size * 2;
+
+        Memory_Buffer<uint8_t> tmp;
+
+        for (int y = begin; y < end; ++y)
+        {
+            int rows4 [2] = { 0, 0 };
+
+            for (int i = 0; i < 2; ++i)
+            {
+                Memory::zero(acc4 + size * i, size * sizeof(Acc));
+
+                for (int j = 0; j < 2; ++j)
+                {
+                    const int k = i * 2 + j;
+                    const int y2 = y * 4 + k;
+
+                    if (y2 >= (*_out)[0].h())
+                        break;
+
+                    const int rows = _filter.template sum<TYPE>(
+                        y2 * 2, 2, acc2 + size * k, tmp);
+
+                    _filter.template store<TYPE>(
+                        acc2 + size * k, 2, rows, &(*_out)[0], y2, tmp);
+
+                    add(acc2 + size * k, acc4 + size * i, size);
+
+                    rows4[i] += rows;
+                }
+
+                const int y4 = y * 2 + i;
+
+                if (y4 < (*_out)[1].h())
+                {
+                    _filter.template store<TYPE>(
+                        acc4 + size * i, 4, rows4[i], &(*_out)[1], y4, tmp);
+                }
+            }
+
+            Memory::copy(acc4, acc8, size * sizeof(Acc));
+
+            add(acc4 + size, acc8, size);
+
+            _filter.template store<TYPE>(
+                acc8, 8, rows4[0] + rows4[1], &(*_out)[2], y, tmp);
+        }
+    }
+
+    Box_Filter         _filter;
+    List<Pixel_Data> * _out;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Pixel_Data
+//------------------------------------------------------------------------------
+
+void Pixel_Data::proxy_scale(
+    const Pixel_Data &     in,
+    Pixel_Data *           out,
+    Pixel_Data_Info::PROXY proxy)
+{
+    DJV_ASSERT(out);
+
+    //DJV_DEBUG("Pixel_Data::proxy_scale");
+    //DJV_DEBUG_PRINT("in = " << in);
+    //DJV_DEBUG_PRINT("out = " << *out);
+    //DJV_DEBUG_PRINT("proxy = " << proxy);
+
+    // Scanlines are processed in parallel, so make sure the output is not
+    // shared before the threads start writing to it.
+
+    out->data();
+
+    Proxy_Scale fnc(in, out, Pixel_Data::proxy_scale(proxy));
+
+    Thread_Pool::global()->parallel_for(0, out->h(), fnc, 16);
+}
+
+void Pixel_Data::proxy_pyramid(const Pixel_Data & in, List<Pixel_Data> * out)
+{
+    DJV_ASSERT(out);
+
+    //DJV_DEBUG("Pixel_Data::proxy_pyramid");
+    //DJV_DEBUG_PRINT("in = " << in);
+
+    out->resize(Pixel_Data_Info::_PROXY_SIZE - 1);
+
+    for (int i = 0; i < Pixel_Data_Info::_PROXY_SIZE - 1; ++i)
+    {
+        const Pixel_Data_Info::PROXY proxy =
+            static_cast<Pixel_Data_Info::PROXY>(i + 1);
+
+        Pixel_Data_Info info = in.info();
+        info.size   = proxy_scale(in.size(), proxy);
+        info.proxy  = proxy;
+        info.endian = Memory::endian();
+
+        (*out)[i].set(info);
+        (*out)[i].data();
+    }
+
+    Proxy_Pyramid fnc(in, out);
+
+    Thread_Pool::global()->parallel_for(0, (*out)[2].h(), fnc, 2);
+}
+
+} // djv
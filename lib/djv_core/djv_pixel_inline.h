@@ -531,17 +531,22 @@ inline int Pixel::max(PIXEL in)
 #define _PIXEL_U10_MAX u10_max
 #define _PIXEL_U16_MAX u16_max
 
+// The look-up tables are initialized with a constructor so that they are
+// safe to use from multiple threads.
+
 #define _PIXEL_LUT(IN, OUT, IN_MAX, OUT_MAX) \
   \
-  static OUT##_T lut [_PIXEL_##IN##_MAX + 1]; \
-  static bool init = true; \
-  if (init) \
+  struct Lut \
   { \
-    for (int i = 0; i <= IN_MAX; ++i) \
-      lut[i] = OUT##_T(i / static_cast<float>(IN_MAX) * OUT_MAX); \
-    init = false; \
-  } \
-  return lut[in];
+    Lut() \
+    { \
+      for (int i = 0; i <= IN_MAX; ++i) \
+        data[i] = OUT##_T(i / static_cast<float>(IN_MAX) * OUT_MAX); \
+    } \
+    OUT##_T data [_PIXEL_##IN##_MAX + 1]; \
+  }; \
+  static const Lut lut; \
+  return lut.data[in];
 
 inline Pixel::U10_T Pixel::u8_to_u10(U8_T in)
 {
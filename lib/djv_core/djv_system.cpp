@@ -41,6 +41,7 @@
 #include <shellapi.h>
 #else // DJV_WINDOWS
 #include <sys/ioctl.h>
+#include <sys/resource.h>
 #include <sys/termios.h>
 #include <sys/utsname.h>
 #include <unistd.h>
@@ -314,6 +315,44 @@ int System::terminal_width()
     return out;
 }
 
+int System::cpu_count()
+{
+    int out = 1;
+
+#if defined(DJV_WINDOWS)
+
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+
+    out = static_cast<int>(info.dwNumberOfProcessors);
+
+#else // DJV_WINDOWS
+
+    out = static_cast<int>(::sysconf(_SC_NPROCESSORS_ONLN));
+
+#endif // DJV_WINDOWS
+
+    return out > 0 ? out : 1;
+}
+
+uint64_t System::page_faults()
+{
+    uint64_t out = 0;
+
+#if ! defined(DJV_WINDOWS)
+
+    struct rusage usage;
+
+    if (0 == ::getrusage(RUSAGE_SELF, &usage))
+    {
+        out = usage.ru_minflt + usage.ru_majflt;
+    }
+
+#endif // DJV_WINDOWS
+
+    return out;
+}
+
 void System::print(const String & in, bool newline)
 {
     if (newline)
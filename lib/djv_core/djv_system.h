@@ -64,6 +64,15 @@ struct DJV_CORE_EXPORT System
 
     static int terminal_width();
 
+    //! Get the number of processors.
+
+    static int cpu_count();
+
+    //! Get the number of page faults taken by the process so far. This is
+    //! zero on Windows.
+
+    static uint64_t page_faults();
+
     //! Print a message to the terminal.
 
     static void print(const String &, bool newline = true);
@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_thread.cpp
+
+#include <djv_thread.h>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// Mutex
+//------------------------------------------------------------------------------
+
+Mutex::Mutex()
+{
+#if defined(DJV_WINDOWS)
+
+    ::InitializeCriticalSection(&_mutex);
+
+#else // DJV_WINDOWS
+
+    ::pthread_mutex_init(&_mutex, 0);
+
+#endif // DJV_WINDOWS
+}
+
+Mutex::~Mutex()
+{
+#if defined(DJV_WINDOWS)
+
+    ::DeleteCriticalSection(&_mutex);
+
+#else // DJV_WINDOWS
+
+    ::pthread_mutex_destroy(&_mutex);
+
+#endif // DJV_WINDOWS
+}
+
+void Mutex::lock()
+{
+#if defined(DJV_WINDOWS)
+
+    ::EnterCriticalSection(&_mutex);
+
+#else // DJV_WINDOWS
+
+    ::pthread_mutex_lock(&_mutex);
+
+#endif // DJV_WINDOWS
+}
+
+void Mutex::unlock()
+{
+#if defined(DJV_WINDOWS)
+
+    ::LeaveCriticalSection(&_mutex);
+
+#else // DJV_WINDOWS
+
+    ::pthread_mutex_unlock(&_mutex);
+
+#endif // DJV_WINDOWS
+}
+
+//------------------------------------------------------------------------------
+// Mutex_Scope
+//------------------------------------------------------------------------------
+
+Mutex_Scope::Mutex_Scope(Mutex & in) :
+    _mutex(in)
+{
+    _mutex.lock();
+}
+
+Mutex_Scope::~Mutex_Scope()
+{
+    _mutex.unlock();
+}
+
+//------------------------------------------------------------------------------
+// Condition
+//------------------------------------------------------------------------------
+
+Condition::Condition()
+{
+#if defined(DJV_WINDOWS)
+
+    ::InitializeConditionVariable(&_condition);
+
+#else // DJV_WINDOWS
+
+    ::pthread_cond_init(&_condition, 0);
+
+#endif // DJV_WINDOWS
+}
+
+Condition::~Condition()
+{
+#if ! defined(DJV_WINDOWS)
+
+    ::pthread_cond_destroy(&_condition);
+
+#endif // ! DJV_WINDOWS
+}
+
+void Condition::wait(Mutex & mutex)
+{
+#if defined(DJV_WINDOWS)
+
+    ::SleepConditionVariableCS(&_condition, &mutex._mutex, INFINITE);
+
+#else // DJV_WINDOWS
+
+    ::pthread_cond_wait(&_condition, &mutex._mutex);
+
+#endif // DJV_WINDOWS
+}
+
+void Condition::signal()
+{
+#if defined(DJV_WINDOWS)
+
+    ::WakeConditionVariable(&_condition);
+
+#else // DJV_WINDOWS
+
+    ::pthread_cond_signal(&_condition);
+
+#endif // DJV_WINDOWS
+}
+
+void Condition::broadcast()
+{
+#if defined(DJV_WINDOWS)
+
+    ::WakeAllConditionVariable(&_condition);
+
+#else // DJV_WINDOWS
+
+    ::pthread_cond_broadcast(&_condition);
+
+#endif // DJV_WINDOWS
+}
+
+//------------------------------------------------------------------------------
+// Thread
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+const String
+    error = "Thread",
+    error_start = "Cannot start thread";
+
+} // namespace
+
+Thread::Thread() :
+#if defined(DJV_WINDOWS)
+    _thread (0),
+#endif
+    _running(false)
+{}
+
+Thread::~Thread()
+{
+    wait();
+}
+
+void Thread::start() throw (Error)
+{
+    //DJV_DEBUG("Thread::start");
+
+    if (_running)
+        return;
+
+#if defined(DJV_WINDOWS)
+
+    _thread = ::CreateThread(0, 0, _start, this, 0, 0);
+
+    if (! _thread)
+    {
+        throw Error(error, error_start);
+    }
+
+#else // DJV_WINDOWS
+
+    if (::pthread_create(&_thread, 0, _start, this) != 0)
+    {
+        throw Error(error, error_start);
+    }
+
+#endif // DJV_WINDOWS
+
+    _running = true;
+}
+
+void Thread::wait()
+{
+    if (! _running)
+        return;
+
+    //DJV_DEBUG("Thread::wait");
+
+#if defined(DJV_WINDOWS)
+
+    ::WaitForSingleObject(_thread, INFINITE);
+    ::CloseHandle(_thread);
+    _thread = 0;
+
+#else // DJV_WINDOWS
+
+    ::pthread_join(_thread, 0);
+
+#endif // DJV_WINDOWS
+
+    _running = false;
+}
+
+bool Thread::running() const
+{
+    return _running;
+}
+
+#if defined(DJV_WINDOWS)
+
+DWORD WINAPI Thread::_start(LPVOID in)
+{
+    static_cast<Thread *>(in)->run();
+
+    return 0;
+}
+
+#else // DJV_WINDOWS
+
+void * Thread::_start(void * in)
+{
+    static_cast<Thread *>(in)->run();
+
+    return 0;
+}
+
+#endif // DJV_WINDOWS
+
+} // djv
+
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_thread.h
+
+#ifndef DJV_THREAD_H
+#define DJV_THREAD_H
+
+#include <djv_error.h>
+
+#if defined(DJV_WINDOWS)
+#include <windows.h>
+#else // DJV_WINDOWS
+#include <pthread.h>
+#endif // DJV_WINDOWS
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+//! \class Mutex
+//!
+//! This class provides a mutex.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Mutex
+{
+public:
+
+    //! Constructor.
+
+    Mutex();
+
+    //! Destructor.
+
+    ~Mutex();
+
+    //! Lock the mutex.
+
+    void lock();
+
+    //! Unlock the mutex.
+
+    void unlock();
+
+private:
+
+    Mutex(const Mutex &);
+    Mutex & operator = (const Mutex &);
+
+#if defined(DJV_WINDOWS)
+    CRITICAL_SECTION _mutex;
+#else
+    pthread_mutex_t _mutex;
+#endif
+
+    friend class Condition;
+};
+
+//------------------------------------------------------------------------------
+//! \class Mutex_Scope
+//!
+//! This class provides automatic locking of a mutex for the duration of a
+//! scope.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Mutex_Scope
+{
+public:
+
+    //! Constructor.
+
+    Mutex_Scope(Mutex &);
+
+    //! Destructor.
+
+    ~Mutex_Scope();
+
+private:
+
+    Mutex_Scope(const Mutex_Scope &);
+    Mutex_Scope & operator = (const Mutex_Scope &);
+
+    Mutex & _mutex;
+};
+
+//------------------------------------------------------------------------------
+//! \class Condition
+//!
+//! This class provides a condition variable.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Condition
+{
+public:
+
+    //! Constructor.
+
+    Condition();
+
+    //! Destructor.
+
+    ~Condition();
+
+    //! Wait for the condition. The mutex must be locked.
+
+    void wait(Mutex &);
+
+    //! Wake one waiting thread.
+
+    void signal();
+
+    //! Wake all waiting threads.
+
+    void broadcast();
+
+private:
+
+    Condition(const Condition &);
+    Condition & operator = (const Condition &);
+
+#if defined(DJV_WINDOWS)
+    CONDITION_VARIABLE _condition;
+#else
+    pthread_cond_t _condition;
+#endif
+};
+
+//------------------------------------------------------------------------------
+//! \class Thread
+//!
+//! This class provides the base class for threads. Re-implement run() to
+//! provide the code that is executed in the thread.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Thread
+{
+public:
+
+    //! Constructor.
+
+    Thread();
+
+    //! Destructor. The thread must be finished before it is destroyed.
+
+    virtual ~Thread();
+
+    //! Start the thread.
+
+    void start() throw (Error);
+
+    //! Wait for the thread to finish.
+
+    void wait();
+
+    //! Get whether the thread has been started.
+
+    bool running() const;
+
+protected:
+
+    //! The code executed in the thread.
+
+    virtual void run() = 0;
+
+private:
+
+    Thread(const Thread &);
+    Thread & operator = (const Thread &);
+
+#if defined(DJV_WINDOWS)
+    static DWORD WINAPI _start(LPVOID);
+    HANDLE _thread;
+#else
+    static void * _start(void *);
+    pthread_t _thread;
+#endif
+
+    bool _running;
+};
+
+} // djv
+
+#endif // DJV_THREAD_H
+
@@ -0,0 +1,561 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_thread_pool.cpp
+
+#include <djv_thread_pool.h>
+
+#include <djv_assert.h>
+#include <djv_math.h>
+#include <djv_system.h>
+
+#include <vector>
+
+namespace djv
+{
+
+//------------------------------------------------------------------------------
+// Thread_Task
+//------------------------------------------------------------------------------
+
+Thread_Task::Thread_Task() :
+    _group(0)
+{}
+
+Thread_Task::~Thread_Task()
+{}
+
+//------------------------------------------------------------------------------
+// Thread_Range
+//------------------------------------------------------------------------------
+
+Thread_Range::~Thread_Range()
+{}
+
+//------------------------------------------------------------------------------
+// Thread_Pool::Worker
+//------------------------------------------------------------------------------
+
+#if defined(DJV_WINDOWS)
+#define _THREAD_LOCAL __declspec(thread)
+#else
+#define _THREAD_LOCAL __thread
+#endif
+
+class Thread_Pool::Worker : public Thread
+{
+public:
+
+    Worker(Thread_Pool * pool, int index) :
+        pool (pool),
+        index(index)
+    {}
+
+    Thread_Pool *             pool;
+    int                       index;
+    std::deque<Thread_Task *> queue;
+    Mutex                     mutex;
+
+protected:
+
+    void run();
+};
+
+namespace
+{
+
+// The worker that owns the current thread, or zero for other threads.
+
+_THREAD_LOCAL void * _worker = 0;
+
+} // namespace
+
+void Thread_Pool::Worker::run()
+{
+    //DJV_DEBUG("Thread_Pool::Worker::run");
+    //DJV_DEBUG_PRINT("index = " << index);
+
+    _worker = this;
+
+    while (true)
+    {
+        if (Thread_Task * task = pool->take())
+        {
+            pool->run(task);
+
+            pool->finish(task);
+
+            continue;
+        }
+
+        Mutex_Scope scope(pool->_mutex);
+
+        while (pool->_queued <= 0 && ! pool->_stop)
+        {
+            pool->_work.wait(pool->_mutex);
+        }
+
+        if (pool->_stop && pool->_queued <= 0)
+            break;
+    }
+
+    _worker = 0;
+}
+
+//------------------------------------------------------------------------------
+// Thread_Task_Group
+//------------------------------------------------------------------------------
+
+Thread_Task_Group::Thread_Task_Group(Thread_Pool * pool) :
+    _pool   (pool ? pool : Thread_Pool::global()),
+    _pending(0),
+    _failed (false)
+{}
+
+Thread_Task_Group::~Thread_Task_Group()
+{
+    wait_pending();
+}
+
+void Thread_Task_Group::add(Thread_Task * task)
+{
+    DJV_ASSERT(task);
+
+    task->_group = this;
+
+    if (! _pool->_workers.size())
+    {
+        _pool->run(task);
+
+        return;
+    }
+
+    {
+        Mutex_Scope scope(_pool->_mutex);
+
+        ++_pending;
+    }
+
+    _pool->push(task);
+}
+
+void Thread_Task_Group::wait() throw (Error)
+{
+    wait_pending();
+
+    Mutex_Scope scope(_pool->_mutex);
+
+    if (_failed)
+    {
+        _failed = false;
+
+        throw _error;
+    }
+}
+
+void Thread_Task_Group::wait_pending()
+{
+    while (true)
+    {
+        {
+            Mutex_Scope scope(_pool->_mutex);
+
+            if (! _pending)
+                break;
+        }
+
+        // Help out while waiting.
+
+        if (Thread_Task * task = _pool->take())
+        {
+            _pool->run(task);
+
+            _pool->finish(task);
+
+            continue;
+        }
+
+        Mutex_Scope scope(_pool->_mutex);
+
+        if (_pending)
+        {
+            _pool->_done.wait(_pool->_mutex);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Thread_Pool
+//------------------------------------------------------------------------------
+
+Thread_Pool::Thread_Pool(int thread_count) :
+    _thread_count(1),
+    _queued      (0),
+    _stop        (false)
+{
+    //DJV_DEBUG("Thread_Pool::Thread_Pool");
+    //DJV_DEBUG_PRINT("thread count = " << thread_count);
+
+    start(thread_count);
+}
+
+Thread_Pool::~Thread_Pool()
+{
+    //DJV_DEBUG("Thread_Pool::~Thread_Pool");
+
+    stop();
+}
+
+void Thread_Pool::thread_count(int in)
+{
+    in = Math::max(in, 1);
+
+    if (in == _thread_count)
+        return;
+
+    stop();
+    start(in);
+}
+
+int Thread_Pool::thread_count() const
+{
+    return _thread_count;
+}
+
+int Thread_Pool::default_thread_count()
+{
+    return System::cpu_count();
+}
+
+namespace
+{
+
+class Range_Task : public Thread_Task
+{
+public:
+
+    Range_Task() :
+        fnc  (0),
+        begin(0),
+        end  (0)
+    {}
+
+    void run()
+    {
+        fnc->run(begin, end);
+    }
+
+    Thread_Range * fnc;
+    int            begin;
+    int            end;
+};
+
+} // namespace
+
+void Thread_Pool::parallel_for(
+    int            begin,
+    int            end,
+    Thread_Range & fnc,
+    int            grain)
+{
+    const int size = end - begin;
+
+    if (size <= 0)
+        return;
+
+    // Create a few chunks per thread so that uneven work can be balanced by
+    // stealing.
+
+    const int chunks = Math::min(
+        size / Math::max(grain, 1),
+        _thread_count * 4);
+
+    if (chunks <= 1 || ! _workers.size())
+    {
+        fnc.run(begin, end);
+
+        return;
+    }
+
+    std::vector<Range_Task> tasks(chunks);
+
+    Thread_Task_Group group(this);
+
+    for (int i = 0; i < chunks; ++i)
+    {
+        tasks[i].fnc   = &fnc;
+        tasks[i].begin = begin + static_cast<int>(
+            static_cast<int64_t>(size) * i / chunks);
+        tasks[i].end   = begin + static_cast<int>(
+            static_cast<int64_t>(size) * (i + 1) / chunks);
+
+        group.add(&tasks[i]);
+    }
+
+    group.wait();
+}
+
+namespace
+{
+
+Thread_Pool * _global = 0;
+Mutex         _global_mutex;
+
+} // namespace
+
+Thread_Pool * Thread_Pool::global()
+{
+    Mutex_Scope scope(_global_mutex);
+
+    if (! _global)
+    {
+        _global = new Thread_Pool;
+    }
+
+    return _global;
+}
+
+void Thread_Pool::start(int thread_count)
+{
+    //DJV_DEBUG("Thread_Pool::start");
+    //DJV_DEBUG_PRINT("thread count = " << thread_count);
+
+    _thread_count = Math::max(thread_count, 1);
+    _stop = false;
+
+    // The calling thread also runs tasks while waiting, so one less worker
+    // thread is needed. The workers are all created before any are started
+    // since they steal from each other.
+
+    for (int i = 0; i < _thread_count - 1; ++i)
+    {
+        _workers += new Worker(this, i);
+    }
+
+    int running = 0;
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        try
+        {
+            _workers[i]->start();
+
+            ++running;
+        }
+        catch (const Error &)
+        {}
+    }
+
+    _thread_count = running + 1;
+}
+
+void Thread_Pool::stop()
+{
+    //DJV_DEBUG("Thread_Pool::stop");
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        _stop = true;
+    }
+
+    _work.broadcast();
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        _workers[i]->wait();
+    }
+
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        delete _workers[i];
+    }
+
+    _workers.clear();
+}
+
+Thread_Pool::Worker * Thread_Pool::worker() const
+{
+    Worker * worker = static_cast<Worker *>(_worker);
+
+    return worker && worker->pool == this ? worker : 0;
+}
+
+namespace
+{
+
+const String
+    error = "Thread_Pool",
+    error_task = "Unknown error in task";
+
+} // namespace
+
+void Thread_Pool::run(Thread_Task * task)
+{
+    // Only the first error of a group is kept.
+
+    Error tmp;
+    bool  failed = false;
+
+    try
+    {
+        task->run();
+    }
+    catch (const Error & in)
+    {
+        tmp    = in;
+        failed = true;
+    }
+    catch (...)
+    {
+        tmp    = Error(error, error_task);
+        failed = true;
+    }
+
+    if (failed)
+    {
+        Mutex_Scope scope(_mutex);
+
+        Thread_Task_Group * group = task->_group;
+
+        if (! group->_failed)
+        {
+            group->_failed = true;
+            group->_error  = tmp;
+        }
+    }
+}
+
+void Thread_Pool::push(Thread_Task * task)
+{
+    if (Worker * worker = this->worker())
+    {
+        Mutex_Scope scope(worker->mutex);
+
+        worker->queue.push_back(task);
+    }
+    else
+    {
+        Mutex_Scope scope(_queue_mutex);
+
+        _queue.push_back(task);
+    }
+
+    {
+        Mutex_Scope scope(_mutex);
+
+        ++_queued;
+    }
+
+    _work.signal();
+}
+
+Thread_Task * Thread_Pool::take()
+{
+    Thread_Task * out = 0;
+
+    Worker * worker = this->worker();
+
+    // Take the newest task from our own queue.
+
+    if (worker)
+    {
+        Mutex_Scope scope(worker->mutex);
+
+        if (worker->queue.size())
+        {
+            out = worker->queue.back();
+
+            worker->queue.pop_back();
+        }
+    }
+
+    // Take the oldest task from the shared queue.
+
+    if (! out)
+    {
+        Mutex_Scope scope(_queue_mutex);
+
+        if (_queue.size())
+        {
+            out = _queue.front();
+
+            _queue.pop_front();
+        }
+    }
+
+    // Steal the oldest task from another worker.
+
+    if (! out)
+    {
+        const size_t size  = _workers.size();
+        const size_t start = worker ? worker->index + 1 : 0;
+
+        for (size_t i = 0; i < size && ! out; ++i)
+        {
+            Worker * other = _workers[(start + i) % size];
+
+            if (other == worker)
+                continue;
+
+            Mutex_Scope scope(other->mutex);
+
+            if (other->queue.size())
+            {
+                out = other->queue.front();
+
+                other->queue.pop_front();
+            }
+        }
+    }
+
+    if (out)
+    {
+        Mutex_Scope scope(_mutex);
+
+        --_queued;
+    }
+
+    return out;
+}
+
+void Thread_Pool::finish(Thread_Task * task)
+{
+    Mutex_Scope scope(_mutex);
+
+    if (! --task->_group->_pending)
+    {
+        _done.broadcast();
+    }
+}
+
+} // djv
+
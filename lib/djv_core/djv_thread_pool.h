@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_thread_pool.h
+
+#ifndef DJV_THREAD_POOL_H
+#define DJV_THREAD_POOL_H
+
+#include <djv_list.h>
+#include <djv_thread.h>
+
+#include <deque>
+
+namespace djv
+{
+
+class Thread_Pool;
+
+//------------------------------------------------------------------------------
+//! \class Thread_Task
+//!
+//! This class provides the base class for thread pool tasks. Errors thrown by
+//! a task are passed on by Thread_Task_Group::wait().
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Thread_Task
+{
+public:
+
+    //! Constructor.
+
+    Thread_Task();
+
+    //! Destructor.
+
+    virtual ~Thread_Task();
+
+    //! The code executed by the task.
+
+    virtual void run() = 0;
+
+private:
+
+    class Thread_Task_Group * _group;
+
+    friend class Thread_Task_Group;
+    friend class Thread_Pool;
+};
+
+//------------------------------------------------------------------------------
+//! \class Thread_Task_Group
+//!
+//! This class provides a group of tasks that can be waited on. Tasks are not
+//! owned by the group and must remain valid until wait() returns.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Thread_Task_Group
+{
+public:
+
+    //! Constructor.
+
+    Thread_Task_Group(Thread_Pool * = 0);
+
+    //! Destructor. Waits for any remaining tasks.
+
+    ~Thread_Task_Group();
+
+    //! Add a task.
+
+    void add(Thread_Task *);
+
+    //! Wait for all of the tasks to finish. The calling thread runs queued
+    //! tasks while waiting. If any of the tasks threw an error, the first one
+    //! is thrown once all of the tasks have finished.
+
+    void wait() throw (Error);
+
+private:
+
+    void wait_pending();
+
+    Thread_Task_Group(const Thread_Task_Group &);
+    Thread_Task_Group & operator = (const Thread_Task_Group &);
+
+    Thread_Pool * _pool;
+    int           _pending;
+    bool          _failed;
+    Error         _error;
+
+    friend class Thread_Pool;
+};
+
+//------------------------------------------------------------------------------
+//! \class Thread_Range
+//!
+//! This class provides the base class for parallel_for() functions.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Thread_Range
+{
+public:
+
+    //! Destructor.
+
+    virtual ~Thread_Range();
+
+    //! Process the range [begin, end). This may be called concurrently from
+    //! multiple threads with disjoint ranges.
+
+    virtual void run(int begin, int end) = 0;
+};
+
+//------------------------------------------------------------------------------
+//! \class Thread_Pool
+//!
+//! This class provides a work-stealing thread pool. Each worker thread has
+//! its own task queue; tasks added from a worker are pushed onto that
+//! worker's queue and idle workers steal from the other queues.
+//------------------------------------------------------------------------------
+
+class DJV_CORE_EXPORT Thread_Pool
+{
+public:
+
+    //! Constructor.
+
+    Thread_Pool(int thread_count = default_thread_count());
+
+    //! Destructor.
+
+    ~Thread_Pool();
+
+    //! Set the number of threads, including the calling thread. A value of
+    //! one disables threading. This should only be called when there are no
+    //! tasks running.
+
+    void thread_count(int);
+
+    //! Get the number of threads.
+
+    int thread_count() const;
+
+    //! Get the default number of threads (the number of processors).
+
+    static int default_thread_count();
+
+    //! Process a range of values in parallel. The range is split into chunks
+    //! of at least grain values; small ranges are processed in the calling
+    //! thread. Errors thrown by the function are passed on to the caller.
+
+    void parallel_for(int begin, int end, Thread_Range &, int grain = 1);
+
+    //! Get the global thread pool. The pool is created when the application
+    //! starts.
+
+    static Thread_Pool * global();
+
+private:
+
+    class Worker;
+
+    void start(int);
+    void stop();
+    Worker * worker() const;
+    void run(Thread_Task *);
+    void push(Thread_Task *);
+    Thread_Task * take();
+    void finish(Thread_Task *);
+
+    Thread_Pool(const Thread_Pool &);
+    Thread_Pool & operator = (const Thread_Pool &);
+
+    int                       _thread_count;
+    List<Worker *>            _workers;
+    std::deque<Thread_Task *> _queue;
+    Mutex                     _queue_mutex;
+    int                       _queued;
+    bool                      _stop;
+    Mutex                     _mutex;
+    Condition                 _work;
+    Condition                 _done;
+
+    friend class Worker;
+    friend class Thread_Task_Group;
+};
+
+} // djv
+
+#endif // DJV_THREAD_POOL_H
+
@@ -45,6 +45,7 @@
 #include <djv_style.h>
 
 #include <djv_gl_context.h>
+#include <djv_gl_image.h>
 #include <djv_image_io.h>
 #include <djv_memory.h>
 #include <djv_system.h>
@@ -94,12 +95,22 @@ Application_Info_Dialog::Application_Info_Dialog() :
     layout_v->add(group_box);
     Form_Widget * opengl_form = new Form_Widget;
     group_box->layout()->add(opengl_form);
+
+    // There is no OpenGL context when images are processed with the CPU
+    // backend.
+
+    const Gl_Context * context = DJV_APP->context();
+
+    const String none = "None";
+
     opengl_form->add_row("Vendor:",
-        new Multiline_Label(DJV_APP->context()->vendor()));
+        new Multiline_Label(context ? context->vendor() : none));
     opengl_form->add_row("Renderer:",
-        new Multiline_Label(DJV_APP->context()->renderer()));
+        new Multiline_Label(context ? context->renderer() : none));
     opengl_form->add_row("Version:",
-        new Multiline_Label(DJV_APP->context()->version()));
+        new Multiline_Label(context ? context->version() : none));
+    opengl_form->add_row("Image Backend:",
+        new Multiline_Label(String_Util::label(Gl_Image::default_backend)));
 
     group_box = new Group_Box("Image I/O Plugins");
     layout_v->add(group_box);
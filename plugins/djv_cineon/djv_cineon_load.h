@@ -57,6 +57,7 @@ public:
         COLOR_PROFILE_OPTION,
         FILM_PRINT_OPTION,
         CONVERT_OPTION,
+        STREAM_OPTION,
 
         _OPTIONS_SIZE
     };
@@ -76,6 +77,7 @@ public:
         COLOR_PROFILE color_profile;
         Film_Unprint  film_print;
         CONVERT       convert;
+        bool          stream;
     };
 
     //! Constructor.
@@ -33,6 +33,7 @@
 
 #include <djv_cineon_load_widget.h>
 
+#include <djv_check_button.h>
 #include <djv_form_widget.h>
 #include <djv_float_edit_slider.h>
 #include <djv_group_box.h>
@@ -72,7 +73,9 @@ const String
     label_film_print_white = "White:",
     label_film_print_gamma = "Gamma:",
     label_film_print_soft_clip = "Soft clip:",
-    label_convert_group = "Convert";
+    label_convert_group = "Convert",
+    label_read_group = "Read",
+    label_stream = "Stream instead of memory-map";
 
 } // namespace
 
@@ -83,7 +86,8 @@ Load_Widget::Load_Widget() :
     _white_widget        (0),
     _gamma_widget        (0),
     _soft_clip_widget    (0),
-    _convert_widget      (0)
+    _convert_widget      (0),
+    _stream_widget       (0)
 {
     //DJV_DEBUG("Load_Widget::Load_Widget");
 
@@ -111,6 +115,12 @@ Load_Widget::Load_Widget() :
 
     _convert_widget = new Radio_Button_Group(label_convert());
 
+    // Create read widgets.
+
+    Group_Box * read_group = new Group_Box(label_read_group);
+
+    _stream_widget = new Check_Button(label_stream);
+
     // Layout.
 
     Vertical_Layout * layout = new Vertical_Layout(this);
@@ -131,6 +141,9 @@ Load_Widget::Load_Widget() :
     layout->add(convert_group);
     convert_group->layout()->add(_convert_widget);
 
+    layout->add(read_group);
+    read_group->layout()->add(_stream_widget);
+
     layout->add_stretch();
 
     // Initialize.
@@ -153,6 +166,8 @@ Load_Widget::Load_Widget() :
     _soft_clip_widget->signal.set(this, soft_clip_callback);
 
     _convert_widget->signal.set(this, convert_callback);
+
+    _stream_widget->signal.set(this, stream_callback);
 }
 
 Load_Widget::~Load_Widget()
@@ -219,6 +234,13 @@ void Load_Widget::convert_callback(int in)
     callback(true);
 }
 
+void Load_Widget::stream_callback(bool in)
+{
+    _options.stream = in;
+
+    callback(true);
+}
+
 void Load_Widget::callback(bool)
 {
     if (! _plugin)
@@ -246,6 +268,8 @@ void Load_Widget::plugin_update()
         _plugin->option(_plugin->options()[Load::FILM_PRINT_OPTION], &tmp);
         tmp << _options.convert;
         _plugin->option(_plugin->options()[Load::CONVERT_OPTION], &tmp);
+        tmp << _options.stream;
+        _plugin->option(_plugin->options()[Load::STREAM_OPTION], &tmp);
     }
 
     callbacks(true);
@@ -269,6 +293,8 @@ void Load_Widget::widget_update()
             tmp >> _options.film_print;
             tmp = _plugin->option(_plugin->options()[Load::CONVERT_OPTION]);
             tmp >> _options.convert;
+            tmp = _plugin->option(_plugin->options()[Load::STREAM_OPTION]);
+            tmp >> _options.stream;
         }
     }
     catch (String) {}
@@ -282,6 +308,8 @@ void Load_Widget::widget_update()
 
     _convert_widget->set(_options.convert);
 
+    _stream_widget->set(_options.stream);
+
     callbacks(true);
 }
 
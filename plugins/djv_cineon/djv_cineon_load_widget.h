@@ -41,6 +41,7 @@
 namespace djv
 {
 
+class Check_Button;
 class Float_Edit_Slider;
 class Int_Edit_Slider;
 class Radio_Button_Group;
@@ -83,6 +84,7 @@ private:
     DJV_CALLBACK(Load_Widget, gamma_callback, double);
     DJV_CALLBACK(Load_Widget, soft_clip_callback, int);
     DJV_CALLBACK(Load_Widget, convert_callback, int);
+    DJV_CALLBACK(Load_Widget, stream_callback, bool);
     DJV_CALLBACK(Load_Widget, callback, bool);
 
     void plugin_update();
@@ -96,6 +98,7 @@ private:
     Float_Edit_Slider *  _gamma_widget;
     Int_Edit_Slider *    _soft_clip_widget;
     Radio_Button_Group * _convert_widget;
+    Check_Button *       _stream_widget;
 };
 
 } // djv_cineon
@@ -59,7 +59,8 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_load()
 
 Load::Options::Options() :
     color_profile(djv_cineon::COLOR_PROFILE_AUTO),
-    convert      (djv_cineon::CONVERT_NONE)
+    convert      (djv_cineon::CONVERT_NONE),
+    stream       (false)
 {}
 
 //------------------------------------------------------------------------------
@@ -71,7 +72,8 @@ const List<String> & Load::label_options()
     static const List<String> data = List<String>() <<
         "Color Profile" <<
         "Film Print" <<
-        "Convert";
+        "Convert" <<
+        "Stream";
 
     DJV_ASSERT(data.size() == _OPTIONS_SIZE);
 
@@ -80,7 +82,9 @@ const List<String> & Load::label_options()
 
 Load::Load() :
     _film_print(false)
-{}
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
 
 Plugin * Load::copy() const
 {
@@ -115,6 +119,10 @@ bool Load::option(const String & in, String * data)
         {
             *data >> _options.convert;
         }
+        else if (String_Util::compare_no_case(in, options()[STREAM_OPTION]))
+        {
+            *data >> _options.stream;
+        }
     }
     catch (String)
     {
@@ -140,6 +148,10 @@ String Load::option(const String & in) const
     {
         out << _options.convert;
     }
+    else if (String_Util::compare_no_case(in, options()[STREAM_OPTION]))
+    {
+        out << _options.stream;
+    }
 
     return out;
 }
@@ -156,7 +168,10 @@ void Load::open(const File & in, Image_Io_Info & info) throw (Error)
 
     _file = in;
     
+    // Only the header is needed so don't stream the file.
+
     File_Io io;
+    io.stream(false);
     
     _open(_file.get(_file.seq().start()), info, io);
 
@@ -199,6 +214,11 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
     Image_Io_Info info;
     
     std::auto_ptr<File_Io> io(new File_Io);
+
+    if (_options.stream)
+    {
+        io->stream(true);
+    }
     
     _open(file_name, info, *io);
 
@@ -226,22 +246,45 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
         image.color_profile = Color_Profile();
     }
 
-    // Read the file.
+    // Read the file. When loading a region of interest only the pages that
+    // it covers are touched, so the whole file is not read ahead. Proxy
+    // images are box filtered, which reads every scanline.
 
-    io->read_ahead();
+    const Box2i roi = frame.roi_clip(info.size);
+
+    const bool crop = roi.size != info.size;
+
+    const bool convert =
+        frame.proxy || djv_cineon::CONVERT_NONE != _options.convert;
+
+    if (! crop)
+    {
+        io->read_ahead();
+    }
 
     const uint8_t * p = io->mmap_p();
 
     io->seek(Pixel_Data::bytes_data(info));
 
-    if (! frame.proxy && djv_cineon::CONVERT_NONE == _options.convert)
+    if (crop)
+    {
+        const Pixel_Data tmp(info, p, io.release());
+
+        Pixel_Data::crop(tmp, convert ? &_tmp : &image, roi);
+
+        info.size = roi.size;
+    }
+    else if (! convert)
     {
         image.set(info, p, io.release());
     }
     else
     {
         _tmp.set(info, p, io.release());
+    }
 
+    if (convert)
+    {
         info.size = Pixel_Data::proxy_scale(info.size, frame.proxy);
         info.proxy = frame.proxy;
 
@@ -57,6 +57,7 @@ public:
         COLOR_PROFILE_OPTION,
         FILM_PRINT_OPTION,
         CONVERT_OPTION,
+        STREAM_OPTION,
 
         _OPTIONS_SIZE
     };
@@ -76,6 +77,7 @@ public:
         djv_cineon::COLOR_PROFILE color_profile;
         djv_cineon::Film_Unprint  film_print;
         djv_cineon::CONVERT       convert;
+        bool                      stream;
     };
 
     //! Constructor.
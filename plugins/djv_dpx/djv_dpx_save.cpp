@@ -312,6 +312,7 @@ void Save::save(const Image & in, const Image_Io_Frame_Info & frame)
 
     Header::info_update(_io);
 
+    _io.flush();
     _io.close();
 }
 
@@ -59,6 +59,8 @@ Load::Load() :
     _compression(false)
 {
     _io.endian(Memory::endian() != Memory::MSB);
+
+    _tmp.memory_tag(Memory::TAG_TEMP);
 }
 
 Plugin * Load::copy() const
@@ -140,11 +142,23 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
     //DJV_DEBUG_PRINT("channel_bytes = " << channel_bytes);
     //DJV_DEBUG_PRINT("bytes = " << bytes);
 
-    _io.read_ahead();
+    // Only the tiles that cover the region of interest are decoded.
+
+    const Box2i roi = frame.roi_clip(info.size);
+
+    const bool crop = roi.size != info.size;
+
+    if (! crop)
+    {
+        _io.read_ahead();
+    }
 
     Pixel_Data * data = frame.proxy ? &_tmp : &image;
 
-    data->set(info);
+    Pixel_Data_Info data_info = info;
+    data_info.size = roi.size;
+
+    data->set(data_info);
 
     tiles_rgba = _tiles;
 
@@ -240,6 +254,30 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                             throw_error_unsupported(name(), file_name);
                         }
 
+                        // Skip tiles outside of the region of interest.
+                        // When there is a region of interest the other tiles
+                        // are decoded to a temporary buffer and then copied.
+
+                        const int x0 = Math::max(static_cast<int>(xmin), roi.x);
+                        const int y0 = Math::max(static_cast<int>(ymin), roi.y);
+                        const int x1 = Math::min(xmax + 1, roi.x + roi.w);
+                        const int y1 = Math::min(ymax + 1, roi.y + roi.h);
+
+                        const bool tile_skip = x0 >= x1 || y0 >= y1;
+
+                        Pixel_Data * tile_data = data;
+                        int tile_x = 0;
+                        int tile_y = 0;
+
+                        if (crop && ! tile_skip)
+                        {
+                            _tile.set(Pixel_Data_Info(V2i(tw, th), info.pixel));
+
+                            tile_data = &_tile;
+                            tile_x = xmin;
+                            tile_y = ymin;
+                        }
+
                         bool tile_compress = false;
 
                         // If tile compression fails to be less than
@@ -262,8 +300,12 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                             tile_compress = true;
                         }
 
+                        if (tile_skip)
+                        {
+                            _io.seek(image_size - 8);
+                        }
                         // Handle 8-bit data.
-                        if (info.pixel == Pixel::RGB_U8 ||
+                        else if (info.pixel == Pixel::RGB_U8 ||
                             info.pixel == Pixel::RGBA_U8)
                         {
 
@@ -288,7 +330,8 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
                                     for (uint16_t py = ymin; py <= ymax; py++)
                                     {
-                                        uint8_t * out_dy = data->data(0, py);
+                                        uint8_t * out_dy =
+                                            tile_data->data(0, py - tile_y);
 
                                         for (
                                             uint16_t px = xmin;
@@ -296,7 +339,8 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                                             px++)
                                         {
                                             uint8_t * out_p =
-                                                out_dy + px * bytes + c;
+                                                out_dy + (px - tile_x) * bytes +
+                                                c;
                                             *out_p++ = *in_p++;
                                         }
                                     }
@@ -317,7 +361,8 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                             {
                                 for (uint16_t py = ymin; py <= ymax; py++)
                                 {
-                                    uint8_t * out_dy = data->data(xmin, py);
+                                    uint8_t * out_dy = tile_data->data(
+                                        xmin - tile_x, py - tile_y);
 
                                     // Tile scanline.
 
@@ -414,7 +459,8 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
                                     for (uint16_t py = ymin; py <= ymax; py++)
                                     {
-                                        uint8_t * out_dy = data->data(0, py);
+                                        uint8_t * out_dy =
+                                            tile_data->data(0, py - tile_y);
 
                                         for (
                                             uint16_t px = xmin;
@@ -422,7 +468,8 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                                             px++)
                                         {
                                             uint8_t * out_p =
-                                                out_dy + px * bytes + mc;
+                                                out_dy + (px - tile_x) * bytes +
+                                                mc;
                                             *out_p++ = *in_p++;
                                         }
                                     }
@@ -443,7 +490,8 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                             {
                                 for (uint16_t py = ymin; py <= ymax; py++)
                                 {
-                                    uint8_t * out_dy = data->data(xmin, py);
+                                    uint8_t * out_dy = tile_data->data(
+                                        xmin - tile_x, py - tile_y);
 
                                     // Tile scanline.
 
@@ -501,6 +549,19 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                             _io.seek(chunk_size);
                         }
 
+                        // Copy the tile into the region of interest.
+
+                        if (tile_data != data)
+                        {
+                            for (int y = y0; y < y1; ++y)
+                            {
+                                Memory::copy(
+                                    _tile.data(x0 - xmin, y - ymin),
+                                    data->data(x0 - roi.x, y - roi.y),
+                                    (x1 - x0) * bytes);
+                            }
+                        }
+
                         // Seek to align to chunksize.
                         size = chunk_size - image_size;
 
@@ -541,7 +602,7 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
     if (frame.proxy)
     {
-        info.size = Pixel_Data::proxy_scale(info.size, frame.proxy);
+        info.size = Pixel_Data::proxy_scale(roi.size, frame.proxy);
         info.proxy = frame.proxy;
         image.set(info);
 
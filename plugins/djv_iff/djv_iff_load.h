@@ -74,6 +74,7 @@ private:
     int        _tiles;
     bool       _compression;
     Pixel_Data _tmp;
+    Pixel_Data _tile;
 };
 
 } // djv_iff
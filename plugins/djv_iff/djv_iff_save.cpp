@@ -576,6 +576,7 @@ void Save::save(const Image & in, const Image_Io_Frame_Info & frame)
     // NOTE: FOR4 <size> TBMP
     _io.position (pos + 4);
     _io.set_u32 (p1);
+    _io.flush();
     _io.close();
 }
 
@@ -112,6 +112,7 @@ bool jpeg_init(libjpeg::jpeg_decompress_struct * jpeg, Jpeg_Error * error)
 bool jpeg_open(
     FILE *                            f,
     libjpeg::jpeg_decompress_struct * jpeg,
+    int                               scale,
     Jpeg_Error *                      error)
 {
     if (::setjmp(error->jump))
@@ -128,6 +129,12 @@ bool jpeg_open(
         return false;
     }
 
+    // Let the decoder scale the image down in the DCT, which is much faster
+    // than decoding the full image and scaling it afterwards.
+
+    jpeg->scale_num   = 1;
+    jpeg->scale_denom = scale;
+
     if (! libjpeg::jpeg_start_decompress(jpeg))
     {
         return false;
@@ -138,10 +145,14 @@ bool jpeg_open(
 
 } // namespace
 
-void Load::_open(const String & in, Image_Io_Info & info) throw (Error)
+void Load::_open(
+    const String &         in,
+    Image_Io_Info &        info,
+    Pixel_Data_Info::PROXY proxy) throw (Error)
 {
     //DJV_DEBUG("Load::_open");
     //DJV_DEBUG_PRINT("in = " << in);
+    //DJV_DEBUG_PRINT("proxy = " << proxy);
 
     _close();
 
@@ -174,7 +185,11 @@ void Load::_open(const String & in, Image_Io_Info & info) throw (Error)
         throw_error_open(name(), in);
     }
 
-    if (! jpeg_open(_f, &_jpeg, &_jpeg_error))
+    if (! jpeg_open(
+        _f,
+        &_jpeg,
+        Pixel_Data::proxy_scale(proxy),
+        &_jpeg_error))
     {
         throw Error(name(), _jpeg_error.msg);
     }
@@ -183,7 +198,8 @@ void Load::_open(const String & in, Image_Io_Info & info) throw (Error)
 
     info.file_name = in;
 
-    info.size = V2i(_jpeg.output_width, _jpeg.output_height);
+    info.size  = V2i(_jpeg.output_width, _jpeg.output_height);
+    info.proxy = proxy;
 
     if (! Pixel::pixel_(_jpeg.out_color_components, 8, false, &info.pixel))
     {
@@ -272,23 +288,24 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
     //DJV_DEBUG_PRINT("file name = " << file_name);
 
+    // The proxy scale is handled by libjpeg, so the image is decoded at the
+    // proxy size.
+
     Image_Io_Info info;
     
-    _open(file_name, info);
+    _open(file_name, info, frame.proxy);
     
     image.tag = info.tag;
 
     // Read the file.
 
-    Pixel_Data * data = frame.proxy ? &_tmp : &image;
-    
-    data->set(info);
+    image.set(info);
 
     for (int y = 0; y < info.size.y; ++y)
     {
         if (! jpeg_scanline(
             &_jpeg,
-            data->data(0, data->h() - 1 - y),
+            image.data(0, image.h() - 1 - y),
             &_jpeg_error))
         {
             throw Error(name(), _jpeg_error.msg);
@@ -300,15 +317,6 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
         throw Error(name(), _jpeg_error.msg);
     }
 
-    if (frame.proxy)
-    {
-        info.size = Pixel_Data::proxy_scale(info.size, frame.proxy);
-        info.proxy = frame.proxy;
-        image.set(info);
-
-        Pixel_Data::proxy_scale(_tmp, &image, frame.proxy);
-    }
-
     //DJV_DEBUG_PRINT("image = " << image);
 }
 
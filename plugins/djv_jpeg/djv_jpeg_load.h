@@ -72,7 +72,10 @@ public:
 
 private:
 
-    void _open(const String &, Image_Io_Info &) throw (Error);
+    void _open(
+        const String &,
+        Image_Io_Info &,
+        Pixel_Data_Info::PROXY = Pixel_Data_Info::PROXY_NONE) throw (Error);
     void _close();
 
     File                            _file;
@@ -80,7 +83,6 @@ private:
     libjpeg::jpeg_decompress_struct _jpeg;
     bool                            _jpeg_init;
     Jpeg_Error                      _jpeg_error;
-    Pixel_Data                      _tmp;
 };
 
 } // djv_jpeg
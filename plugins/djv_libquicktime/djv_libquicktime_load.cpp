@@ -79,7 +79,9 @@ Load::Load() :
     _f          (0),
     _start_frame(0),
     _frame      (0)
-{}
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
 
 Load::~Load()
 {
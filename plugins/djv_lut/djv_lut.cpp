@@ -34,8 +34,10 @@
 #include <djv_lut.h>
 
 #include <djv_color.h>
+#include <djv_file_scanner.h>
 
 #include <stdio.h>
+#include <string.h>
 
 namespace djv_lut
 {
@@ -74,21 +76,20 @@ int _bit_depth(File_Io & io) throw (Error)
 
     const size_t position = io.position();
 
-    char tmp [cstring_size] = "";
-
-    while (1)
     {
-        try
-        {
-            File_Io::word(io, tmp, cstring_size);
-        }
-        catch (Error)
+        File_Scanner scanner(io);
+
+        const char * p = 0;
+        size_t size = 0;
+        int64_t value = 0;
+
+        while (scanner.word(p, size))
         {
-            break;
+            if (File_Scanner::to_int(p, size, value))
+            {
+                out = Math::max(static_cast<int>(value), out);
+            }
         }
-
-        out = Math::max(
-            String_Util::string_to_int<int>(tmp, cstring_size), out);
     }
 
     io.position(position);
@@ -113,21 +114,24 @@ void inferno_open(File_Io & io, Pixel_Data_Info & info, TYPE type) throw (Error)
 
     // Header.
 
-    char tmp [cstring_size] = "";
-    File_Io::word(io, tmp, cstring_size);
-
-    //DJV_DEBUG_PRINT("magic = " << tmp);
+    int channels = 0;
+    int size = 0;
 
-    if (String(tmp) != "LUT:")
     {
-        Image_Io_Base::throw_error_unrecognized(name, io.file_name());
-    }
+        File_Scanner scanner(io);
 
-    File_Io::word(io, tmp, cstring_size);
-    const int channels = String_Util::string_to_int<int>(tmp, cstring_size);
+        const String magic = scanner.word();
 
-    File_Io::word(io, tmp, cstring_size);
-    const int size = String_Util::string_to_int<int>(tmp, cstring_size);
+        //DJV_DEBUG_PRINT("magic = " << magic);
+
+        if (magic != "LUT:")
+        {
+            Image_Io_Base::throw_error_unrecognized(name, io.file_name());
+        }
+
+        channels = static_cast<int>(scanner.word_int());
+        size = static_cast<int>(scanner.word_int());
+    }
 
     //DJV_DEBUG_PRINT("size = " << size);
     //DJV_DEBUG_PRINT("channels = " << channels);
@@ -185,64 +189,33 @@ void kodak_open(File_Io & io, Pixel_Data_Info & info, TYPE type) throw (Error)
 
     const size_t position = io.position();
     String header;
-    int8_t c = 0;
-    bool comment = false;
+    int size = 1;
 
-    while (1)
     {
-        try
-        {
-            io.get_8(&c);
-        }
-        catch (Error)
-        {
-            break;
-        }
+        File_Scanner scanner(io);
 
-        if ('#' == c)
-        {
-            comment = true;
-        }
+        const char * p = 0;
+        size_t line_size = 0;
 
-        else if ('\n' == c)
-        {
-            if (comment)
-            {
-                comment = false;
-            }
-            else
-            {
-                break;
-            }
-        }
-        else
+        // The number of channels is taken from the first line, skipping
+        // comments.
+
+        while (scanner.line(p, line_size))
         {
+            const char * comment =
+                static_cast<const char *>(::memchr(p, '#', line_size));
+
+            header += String(p, comment ? comment - p : line_size);
+
             if (! comment)
             {
-                header += c;
+                break;
             }
         }
-    }
-
-    //DJV_DEBUG_PRINT("header = " << header);
-
-    int channels = static_cast<int>(
-        String_Util::split(header, List<char>() << ' ' << '\t').size());
-    int size = 1;
-    comment = false;
 
-    while (1)
-    {
-        try
-        {
-            io.get_8(&c);
-        }
-        catch (Error)
-        {
-            break;
-        }
+        // The number of entries is the number of lines.
 
-        if ('\n' == c)
+        while (scanner.line(p, line_size))
         {
             ++size;
         }
@@ -250,6 +223,11 @@ void kodak_open(File_Io & io, Pixel_Data_Info & info, TYPE type) throw (Error)
 
     io.position(position);
 
+    //DJV_DEBUG_PRINT("header = " << header);
+
+    const int channels = static_cast<int>(
+        String_Util::split(header, List<char>() << ' ' << '\t').size());
+
     //DJV_DEBUG_PRINT("size = " << size);
     //DJV_DEBUG_PRINT("channels = " << channels);
 
@@ -303,12 +281,12 @@ void inferno_load(File_Io & io, Image * out) throw (Error)
         color[x].pixel(out->pixel());
     }
 
+    File_Scanner scanner(io);
+
     for (int c = 0; c < Pixel::channels(out->pixel()); ++c)
         for (int x = 0; x < out->w(); ++x)
         {
-            char tmp [cstring_size] = "";
-            File_Io::word(io, tmp, cstring_size);
-            const int v = String_Util::string_to_int<int>(tmp, cstring_size);
+            const int v = static_cast<int>(scanner.word_int());
 
             switch (Pixel::type(out->pixel()))
             {
@@ -343,15 +321,15 @@ void kodak_load(File_Io & io, Image * out) throw (Error)
 {
     //DJV_DEBUG("kodak_load");
 
+    File_Scanner scanner(io);
+
     for (int x = 0; x < out->w(); ++x)
     {
         Color color(out->pixel());
 
         for (int c = 0; c < Pixel::channels(out->pixel()); ++c)
         {
-            char tmp [cstring_size] = "";
-            File_Io::word(io, tmp, cstring_size);
-            const int v = String_Util::string_to_int<int>(tmp, cstring_size);
+            const int v = static_cast<int>(scanner.word_int());
 
             switch (Pixel::type(out->pixel()))
             {
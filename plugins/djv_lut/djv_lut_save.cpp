@@ -236,6 +236,7 @@ void Save::save(const Image & in, const Image_Io_Frame_Info & frame)
             break;
     }
 
+    _io.flush();
     _io.close();
 }
 
@@ -34,6 +34,7 @@
 #include <djv_openexr_base.h>
 
 #include <djv_assert.h>
+#include <djv_thread_pool.h>
 
 #include <ImfThreading.h>
 
@@ -58,7 +59,7 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_io_base()
 //------------------------------------------------------------------------------
 
 Base::Options::Options() :
-    threads(4)
+    threads(Thread_Pool::default_thread_count())
 {}
 
 //------------------------------------------------------------------------------
@@ -87,7 +87,9 @@ const List<String> & Load::label_options()
 
 Load::Load() :
     _f(0)
-{}
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
 
 Load::~Load()
 {
@@ -324,10 +326,12 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
             image.color_profile = Color_Profile();
         }
         
-        // Read the file.
-
-        Pixel_Data * data = frame.proxy ? &_tmp : &image;
-        data->set(_info);
+        // Read the file. When the display and data windows are the same only
+        // the scanlines that cover the region of interest are read, otherwise
+        // the whole image is read and then cropped. A data window inside the
+        // display window is read directly into its place in the image. Proxy
+        // images read every Nth scanline into a buffer and copy every Nth
+        // pixel.
 
         const bool flip = Imf::DECREASING_Y == _f->header().lineOrder();
 
@@ -336,6 +340,67 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
         const int channels = Pixel::channels(_info.pixel);
         const int bytes    = Pixel::channel_bytes(_info.pixel);
         const V2i sampling = _layers[frame.layer].channel[0].sampling;
+
+        const bool window = _display_window != _data_window;
+
+        const Box2i roi =
+            frame.roi_clip(window ? _display_window.size : _info.size);
+
+        const bool native = ! window && V2i(1, 1) == sampling;
+
+        const bool placed =
+            window &&
+            V2i(1, 1) == sampling &&
+            Box_Util::intersect(_data_window, _display_window) ==
+                _data_window;
+
+        const bool scanlines = native && roi.size != _info.size;
+
+        const bool proxy_lines = native && frame.proxy;
+
+        //DJV_DEBUG_PRINT("roi = " << roi);
+        //DJV_DEBUG_PRINT("scanlines = " << scanlines);
+        //DJV_DEBUG_PRINT("proxy lines = " << proxy_lines);
+        //DJV_DEBUG_PRINT("placed = " << placed);
+
+        const int read_y = scanlines ? roi.y : 0;
+
+        if (scanlines)
+        {
+            _info.size.y = roi.h;
+        }
+
+        Pixel_Data * data = frame.proxy ? &_tmp : &image;
+
+        if (proxy_lines)
+        {
+            data->set(Pixel_Data_Info(V2i(_info.size.x, 1), _info.pixel));
+        }
+        else if (placed)
+        {
+            _info.size = _display_window.size;
+            data->set(_info);
+            data->zero();
+        }
+        else
+        {
+            data->set(_info);
+        }
+
+        Pixel_Data_View view(
+            data,
+            placed ?
+            Box2i(
+                _data_window.position - _display_window.position,
+                _data_window.size) :
+            Box2i(data->size()));
+
+        const int bytes_pixel = channels * bytes;
+
+        // The scanline buffer for proxy images is re-used for each scanline.
+
+        const int y_stride =
+            proxy_lines ? 0 : static_cast<int>(view.bytes_scanline());
         
         Imf::FrameBuffer frame_buffer;
 
@@ -349,12 +414,12 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
                 channel.c_str(),
                 Imf::Slice(
                     pixel_type_to_imf(Pixel::type(data->pixel())),
-                    (char *)data->data() -
-                    (_data_window.y * _info.size.x * channels * bytes) -
-                    (_data_window.x * channels * bytes) +
+                    (char *)view.data() -
+                    ((_data_window.y + read_y) * y_stride) -
+                    (_data_window.x * bytes_pixel) +
                     c * bytes,
-                    channels * bytes,
-                    _info.size.x * channels * bytes,
+                    bytes_pixel,
+                    y_stride,
                     sampling.x,
                     sampling.y,
                     0.0));
@@ -362,25 +427,53 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
         _f->setFrameBuffer(frame_buffer);
 
-        if (flip)
+        if (proxy_lines)
+        {
+            const int proxy_scale = Pixel_Data::proxy_scale(frame.proxy);
+
+            _info.size  = Pixel_Data::proxy_scale(roi.size, frame.proxy);
+            _info.proxy = frame.proxy;
+            image.set(_info);
+
+            for (int i = 0; i < _info.size.y; ++i)
+            {
+                const int y = flip ? (_info.size.y - 1 - i) : i;
+
+                _f->readPixels(_data_window.y + read_y + y * proxy_scale);
+
+                const uint8_t * in_p  = _tmp.data(roi.x, 0);
+                uint8_t *       out_p = image.data(0, y);
+
+                for (
+                    int x = 0;
+                    x < _info.size.x;
+                    ++x, in_p += bytes_pixel * proxy_scale,
+                    out_p += bytes_pixel)
+                {
+                    Memory::copy(in_p, out_p, bytes_pixel);
+                }
+            }
+        }
+        else if (flip)
         {
             for (
                 int y = 0;
-                y < _info.size.y * sampling.y;
+                y < view.h() * sampling.y;
                 y += sampling.y)
             {
                 _f->readPixels(
-                    _data_window.y + (_info.size.y * sampling.y - 1 - y));
+                    _data_window.y + read_y +
+                    (view.h() * sampling.y - 1 - y));
             }
         }
         else
         {
             _f->readPixels(
-                _data_window.y,
-                _data_window.y + _info.size.y * sampling.y - 1);
+                _data_window.y + read_y,
+                _data_window.y + read_y + view.h() * sampling.y - 1);
         }
 
-        if (_display_window != _data_window)
+        if (window && ! placed)
         {
             //DJV_DEBUG_PRINT("display window");
 
@@ -395,11 +488,28 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
             Gl_Image_Options options;
             options.xform.position =
                 _data_window.position - _display_window.position;
-            
-            Gl_Image::copy(tmp, *data, options);
+
+            // Images may be loaded by threads without an OpenGL context, so
+            // the copy is done with the CPU.
+
+            Gl_Image::copy_cpu(tmp, *data, options);
+        }
+
+        if (! proxy_lines && data->size() != roi.size)
+        {
+            //DJV_DEBUG_PRINT("crop");
+
+            Pixel_Data tmp = *data;
+
+            Pixel_Data::crop(
+                tmp,
+                data,
+                scanlines ? Box2i(roi.x, 0, roi.w, roi.h) : roi);
+
+            _info.size = roi.size;
         }
 
-        if (frame.proxy)
+        if (frame.proxy && ! proxy_lines)
         {
             //DJV_DEBUG_PRINT("proxy");
 
@@ -80,7 +80,9 @@ const List<String> & Save::label_options()
 
 Save::Save() :
     _f(0)
-{}
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
 
 Save::~Save()
 {
@@ -60,6 +60,8 @@ Load::Load() :
 
     _compression[0] = false;
     _compression[1] = false;
+
+    _tmp.memory_tag(Memory::TAG_TEMP);
 }
 
 Plugin * Load::copy() const
@@ -58,7 +58,9 @@ Load::Load() :
     _png         (0),
     _png_info    (0),
     _png_info_end(0)
-{}
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
 
 Load::~Load()
 {
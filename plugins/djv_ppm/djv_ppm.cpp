@@ -125,11 +125,14 @@ size_t bytes_scanline(int width, int channels, int bit_depth, DATA data)
     return out;
 }
 
-void ascii_load(File_Io & io, void * out, int size, int bit_depth) throw (Error)
+void ascii_load(
+    File_Scanner & scanner,
+    void *         out,
+    int            size,
+    int            bit_depth) throw (Error)
 {
     //DJV_DEBUG("ascii_load");
 
-    char tmp [cstring_size] = "";
     int i = 0;
 
     switch (bit_depth)
@@ -140,8 +143,7 @@ void ascii_load(File_Io & io, void * out, int size, int bit_depth) throw (Error)
 
             for (; i < size; ++i)
             {
-                File_Io::word(io, tmp, cstring_size);
-                out_p[i] = String_Util::string_to_int(tmp) ? 0 : 255;
+                out_p[i] = scanner.word_int() ? 0 : 255;
             }
         }
         break;
@@ -151,8 +153,7 @@ void ascii_load(File_Io & io, void * out, int size, int bit_depth) throw (Error)
   TYPE * out_p = reinterpret_cast<TYPE *>(out); \
   for (; i < size; ++i) \
   { \
-File_Io::word(io, tmp, cstring_size); \
-out_p[i] = String_Util::string_to_int(tmp); \
+out_p[i] = static_cast<TYPE>(scanner.word_int()); \
   }
 
         case 8:
@@ -35,6 +35,7 @@
 #define DJV_PPM_H
 
 #include <djv_file_io.h>
+#include <djv_file_scanner.h>
 #include <djv_image_io.h>
 
 //! \namespace djv_ppm
@@ -102,10 +103,10 @@ size_t bytes_scanline(
 //! Load ASCII data.
 
 void ascii_load(
-    File_Io & io,
-    void *    out,
-    int       size,
-    int       bit_depth) throw (Error);
+    File_Scanner & scanner,
+    void *         out,
+    int            size,
+    int            bit_depth) throw (Error);
 
 //! Save ASCII data.
 
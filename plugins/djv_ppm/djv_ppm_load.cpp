@@ -53,6 +53,11 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_load()
 // Load
 //------------------------------------------------------------------------------
 
+Load::Load()
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
+
 Plugin * Load::copy() const
 {
     return new Load;
@@ -127,26 +132,20 @@ void Load::_open(const String & in, Image_Io_Info & info, File_Io & io)
 
     // Read the header.
 
-    char tmp [cstring_size] = "";
-
-    int width  = 0;
-    int height = 0;
-    
-    File_Io::word(io, tmp, cstring_size);
-    
-    width = String_Util::string_to_int<int>(tmp, cstring_size);
-    
-    File_Io::word(io, tmp, cstring_size);
-    
-    height = String_Util::string_to_int<int>(tmp, cstring_size);
-
+    int width     = 0;
+    int height    = 0;
     int max_value = 0;
 
-    if (ppm_type != 1 && ppm_type != 4)
     {
-        File_Io::word(io, tmp, cstring_size);
-        
-        max_value = String_Util::string_to_int<int>(tmp, cstring_size);
+        File_Scanner scanner(io);
+
+        width  = static_cast<int>(scanner.word_int());
+        height = static_cast<int>(scanner.word_int());
+
+        if (ppm_type != 1 && ppm_type != 4)
+        {
+            max_value = static_cast<int>(scanner.word_int());
+        }
     }
 
     //DJV_DEBUG_PRINT("max value = " << max_value);
@@ -276,10 +275,12 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame)
         }
         else
         {
+            File_Scanner scanner(*io);
+
             for (int y = 0; y < info.size.y; ++y)
             {
                 ascii_load(
-                    *io,
+                    scanner,
                     data->data(0, y),
                     info.size.x * channels,
                     _bit_depth);
@@ -53,6 +53,10 @@ class Load : public Image_Load
 {
 public:
 
+    //! Constructor.
+
+    Load();
+
     virtual Plugin * copy() const;
 
     virtual String name() const;
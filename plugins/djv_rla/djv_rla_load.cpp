@@ -56,6 +56,8 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_load()
 Load::Load()
 {
     _io.endian(Memory::endian() != Memory::MSB);
+
+    _tmp.memory_tag(Memory::TAG_TEMP);
 }
 
 Plugin * Load::copy() const
@@ -284,39 +286,68 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
     Pixel_Data_Info _info = info[frame.layer];
 
-    // Read the file.
+    // Read the file. Only the scanlines that cover the region of interest
+    // are decoded.
 
-    _io.read_ahead();
+    const Box2i roi = frame.roi_clip(_info.size);
 
-    Pixel_Data * p = frame.proxy ? &_tmp : &image;
-    
-    p->set(_info);
+    if (roi.size == _info.size)
+    {
+        _io.read_ahead();
+    }
 
     const int w        = _info.size.x;
-    const int h        = _info.size.y;
     const int channels = Pixel::channels(_info.pixel);
     const int bytes    = Pixel::channel_bytes(_info.pixel);
 
     //DJV_DEBUG_PRINT("channels = " << channels);
     //DJV_DEBUG_PRINT("bytes = " << bytes);
 
+    _info.size = roi.size;
+
+    Pixel_Data * p = frame.proxy ? &_tmp : &image;
+    
+    p->set(_info);
+
+    const size_t bytes_pixel = channels * bytes;
+
+    Memory_Buffer<uint8_t> line;
+
+    if (roi.w != w)
+    {
+        line.size(w * bytes_pixel);
+    }
+
     uint8_t * data_p = p->data();
 
-    for (int y = 0; y < h; ++y, data_p += w * channels * bytes)
+    for (
+        int y = roi.y;
+        y < roi.y + roi.h;
+        ++y, data_p += roi.w * bytes_pixel)
     {
         _io.position(_rle_offset()[y]);
 
+        uint8_t * line_p = line.size() ? line() : data_p;
+
         for (int c = 0; c < channels; ++c)
         {
             if (Pixel::F32 == Pixel::type(_info.pixel))
             {
-                float_load(_io, data_p + c * bytes, w, channels);
+                float_load(_io, line_p + c * bytes, w, channels);
             }
             else
             {
-                rle_load(_io, data_p + c * bytes, w, channels, bytes);
+                rle_load(_io, line_p + c * bytes, w, channels, bytes);
             }
         }
+
+        if (line.size())
+        {
+            Memory::copy(
+                line() + roi.x * bytes_pixel,
+                data_p,
+                roi.w * bytes_pixel);
+        }
     }
 
     // Proxy scale the image.
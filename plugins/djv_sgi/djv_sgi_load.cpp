@@ -53,6 +53,11 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_load()
 // Load
 //------------------------------------------------------------------------------
 
+Load::Load()
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
+
 Plugin * Load::copy() const
 {
     return new Load;
@@ -138,14 +143,85 @@ void Load::load(Image & image, const Image_Io_Frame_Info & frame) throw (Error)
 
     // Read the file.
 
-    io->read_ahead();
+    const Box2i roi = frame.roi_clip(info.size);
+
+    const bool crop = roi.size != info.size;
+
+    if (! crop)
+    {
+        io->read_ahead();
+    }
 
     const size_t position = io->position();
     const size_t size     = io->size() - position;
     const int channels    = Pixel::channels(info.pixel);
     const int bytes       = Pixel::channel_bytes(info.pixel);
 
-    if (! _compression)
+    if (crop)
+    {
+        // Read only the scanlines that cover the region of interest.
+
+        const V2i image_size = info.size;
+
+        info.size = roi.size;
+
+        _tmp.set(info);
+
+        Memory_Buffer<uint8_t> rle;
+        Memory_Buffer<uint8_t> line;
+
+        if (_compression)
+        {
+            line.size(image_size.x * bytes);
+        }
+
+        uint8_t * out_p = _tmp.data();
+
+        for (int c = 0; c < channels; ++c)
+        {
+            for (
+                int y = roi.y;
+                y < roi.y + roi.h;
+                ++y, out_p += roi.w * bytes)
+            {
+                //DJV_DEBUG_PRINT("y = " << y);
+
+                if (! _compression)
+                {
+                    io->position(
+                        position +
+                        ((c * image_size.y + y) * image_size.x + roi.x) *
+                        bytes);
+
+                    io->get(out_p, roi.w, bytes);
+
+                    continue;
+                }
+
+                const int i = y + image_size.y * c;
+
+                rle.size(_rle_size()[i]);
+
+                io->position(_rle_offset()[i]);
+
+                io->get(rle(), rle.size() / bytes, bytes);
+
+                if (! rle_load(
+                    rle(),
+                    rle() + rle.size(),
+                    line(),
+                    image_size.x,
+                    bytes,
+                    io->endian()))
+                {
+                    throw_error_read(name(), file_name);
+                }
+
+                Memory::copy(line() + roi.x * bytes, out_p, roi.w * bytes);
+            }
+        }
+    }
+    else if (! _compression)
     {
         if (1 == bytes)
         {
@@ -76,6 +76,8 @@ const List<String> & Save::label_options()
 Save::Save()
 {
     _io.endian(Memory::endian() != Memory::MSB);
+
+    _tmp.memory_tag(Memory::TAG_TEMP);
 }
 
 Plugin * Save::copy() const
@@ -261,6 +263,7 @@ void Save::save(const Image & in, const Image_Io_Frame_Info & frame)
         _io.set_u32(_rle_size(), h * channels);
     }
 
+    _io.flush();
     _io.close();
 }
 
@@ -53,6 +53,11 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_load()
 // Load
 //------------------------------------------------------------------------------
 
+Load::Load()
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
+
 Plugin * Load::copy() const
 {
     return new Load;
@@ -220,6 +220,7 @@ void Save::save(const Image & in, const Image_Io_Frame_Info & frame)
         }
     }
 
+    _io.flush();
     _io.close();
 }
 
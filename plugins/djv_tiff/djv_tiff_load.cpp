@@ -57,7 +57,9 @@ DJV_PLUGIN_EXPORT Plugin * djv_image_load()
 
 Load::Load() :
     _f(0)
-{}
+{
+    _tmp.memory_tag(Memory::TAG_TEMP);
+}
 
 Load::~Load()
 {
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_batch_test.cpp
+
+#include <djv_assert.h>
+#include <djv_file_batch.h>
+#include <djv_file_io.h>
+#include <djv_memory.h>
+
+#include <stdio.h>
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    // Write a few files of different sizes.
+
+    List<String> file_names;
+    List<size_t> sizes;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        file_names += String_Format("djv_file_batch_test.%%.tmp").arg(i);
+        sizes += 1000 + i * 100 * 1000;
+
+        Memory_Buffer<uint8_t> tmp(sizes[i]);
+
+        for (size_t j = 0; j < sizes[i]; ++j)
+        {
+            tmp()[j] = static_cast<uint8_t>(i + j);
+        }
+
+        File_Io io;
+        io.open(file_names[i], File_Io::WRITE);
+        io.set(tmp(), sizes[i]);
+        io.flush();
+    }
+
+    // Read the files as a batch. Missing files are skipped.
+
+    File_Batch * batch = File_Batch::global();
+
+    const bool available = batch->read(
+        List<String>(file_names) << "djv_file_batch_test.missing.tmp");
+
+    DJV_ASSERT(available == batch->available());
+    DJV_ASSERT((available ? file_names.size() : 0) == batch->size());
+
+    // Opening the files uses the batch, or reads the files as usual when
+    // batch reads are not available.
+
+    for (size_t i = 0; i < file_names.size(); ++i)
+    {
+        File_Io io;
+        io.open(file_names[i], File_Io::READ);
+
+        DJV_ASSERT(sizes[i] == io.size());
+
+        Memory_Buffer<uint8_t> tmp(sizes[i]);
+        io.get(tmp(), sizes[i]);
+
+        for (size_t j = 0; j < sizes[i]; ++j)
+        {
+            DJV_ASSERT(static_cast<uint8_t>(i + j) == tmp()[j]);
+        }
+    }
+
+    DJV_ASSERT(0 == batch->size());
+
+    // Files that are not opened are discarded with the next batch.
+
+    batch->read(List<String>() << file_names[0]);
+    batch->read(List<String>() << file_names[1]);
+
+    DJV_ASSERT((available ? 1 : 0) == batch->size());
+
+    batch->clear();
+
+    DJV_ASSERT(0 == batch->size());
+
+    for (size_t i = 0; i < file_names.size(); ++i)
+    {
+        ::remove(file_names[i].c_str());
+    }
+
+    return 0;
+}
+
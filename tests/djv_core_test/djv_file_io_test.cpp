@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_io_test.cpp
+
+#include <djv_assert.h>
+#include <djv_file_io.h>
+#include <djv_memory.h>
+
+#include <stdio.h>
+#if defined(DJV_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    const String file_name = "djv_file_io_test.tmp";
+
+    // Write small pieces with endian conversion, a payload larger than the
+    // write buffer, and then go back and patch the header.
+
+    const size_t large_size = File_Io::write_buffer_size * 2 + 3;
+
+    Memory_Buffer<uint8_t> large(large_size);
+
+    for (size_t i = 0; i < large_size; ++i)
+    {
+        large()[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::WRITE);
+        io.endian(true);
+
+        io.set_u32(0);
+
+        for (uint16_t i = 0; i < 1000; ++i)
+        {
+            io.set_u16(i);
+        }
+
+        DJV_ASSERT(4 + 1000 * 2 == io.position());
+
+        io.set(large(), large_size);
+
+        DJV_ASSERT(4 + 1000 * 2 + large_size == io.position());
+
+        io.set_u8(0xab);
+
+        const uint32_t size = static_cast<uint32_t>(io.position());
+
+        io.position(0);
+        io.set_u32(size);
+
+        io.flush();
+        io.close();
+    }
+
+    // Read the file back, both memory-mapped and streamed.
+
+    for (int stream = 0; stream < 2; ++stream)
+    {
+        File_Io io;
+        io.stream(stream != 0);
+        io.open(file_name, File_Io::READ);
+        io.endian(true);
+
+        DJV_ASSERT(4 + 1000 * 2 + large_size + 1 == io.size());
+
+        uint32_t size = 0;
+        io.get_u32(&size);
+
+        DJV_ASSERT(io.size() == size);
+
+        for (uint16_t i = 0; i < 1000; ++i)
+        {
+            uint16_t tmp = 0;
+            io.get_u16(&tmp);
+
+            DJV_ASSERT(i == tmp);
+        }
+
+        Memory_Buffer<uint8_t> tmp(large_size);
+        io.get(tmp(), large_size);
+
+        DJV_ASSERT(0 == Memory::compare(tmp(), large(), large_size));
+
+        uint8_t last = 0;
+        io.get_u8(&last);
+
+        DJV_ASSERT(0xab == last);
+    }
+
+#if defined(DJV_MMAP) && ! defined(DJV_WINDOWS)
+
+    // Memory-maps are re-used when the same file is opened again.
+
+    const uint8_t * p = 0;
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::READ);
+
+        p = io.mmap_p();
+    }
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::READ);
+
+        DJV_ASSERT(p == io.mmap_p());
+        DJV_ASSERT(io.is_valid());
+    }
+
+    // Memory-maps are not re-used when the file has been rewritten, even
+    // within the same second.
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::READ);
+    }
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::WRITE);
+        io.set_u32(0);
+        io.set(large(), large_size);
+        io.set(large(), 1000 * 2 + 1);
+    }
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::READ);
+
+        uint32_t size = 1;
+        io.get_u32(&size);
+
+        DJV_ASSERT(0 == size);
+    }
+
+    File_Io::mmap_recycle(0);
+
+#endif
+
+#if defined(DJV_LINUX) && defined(DJV_MMAP)
+
+    // Populated memory-maps are resident when they are opened.
+
+    {
+        File_Io io;
+        io.populate(true);
+        io.open(file_name, File_Io::READ);
+
+        const size_t page = ::sysconf(_SC_PAGESIZE);
+
+        Memory_Buffer<unsigned char> pages((io.size() + page - 1) / page);
+
+        DJV_ASSERT(0 == ::mincore(
+            const_cast<uint8_t *>(io.mmap_p()), io.size(), pages()));
+
+        for (size_t i = 0; i < pages.size(); ++i)
+        {
+            DJV_ASSERT(pages()[i] & 1);
+        }
+    }
+
+#endif
+
+    ::remove(file_name.c_str());
+
+    return 0;
+}
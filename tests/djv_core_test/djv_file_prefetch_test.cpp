@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_prefetch_test.cpp
+
+#include <djv_assert.h>
+#include <djv_file_io.h>
+#include <djv_file_prefetch.h>
+#include <djv_memory.h>
+#include <djv_time.h>
+
+#include <stdio.h>
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    const String file_name = "djv_file_prefetch_test.tmp";
+
+    const size_t size = 1024 * 1024;
+
+    {
+        Memory_Buffer<uint8_t> tmp(size);
+        Memory::zero(tmp(), size);
+
+        File_Io io;
+        io.open(file_name, File_Io::WRITE);
+        io.set(tmp(), size);
+        io.flush();
+    }
+
+    // Prefetch the file and wait for it to be read.
+
+    File_Prefetch * prefetch = File_Prefetch::global();
+
+    prefetch->files(List<String>() << file_name << file_name);
+
+    for (int i = 0; i < 100 && prefetch->stats().files < 1; ++i)
+    {
+        Time::sleep(0.1);
+    }
+
+    File_Prefetch::Stats stats = prefetch->stats();
+
+    DJV_ASSERT(1 == stats.files);
+    DJV_ASSERT(size == stats.bytes);
+
+    // Opening the file records how much of it was resident.
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::READ);
+    }
+
+    stats = prefetch->stats();
+
+#if defined(DJV_MMAP) && ! defined(DJV_WINDOWS)
+    DJV_ASSERT(1 == stats.opened);
+    DJV_ASSERT(size == stats.total);
+#endif
+
+    // Files are not prefetched again right away.
+
+    prefetch->files(List<String>() << file_name);
+
+    Time::sleep(0.1);
+
+    DJV_ASSERT(1 == prefetch->stats().files);
+
+    // Files are prefetched again later, in case they have been dropped from
+    // the cache.
+
+    Time::sleep(1.0);
+
+    prefetch->files(List<String>() << file_name);
+
+    for (int i = 0; i < 100 && prefetch->stats().files < 2; ++i)
+    {
+        Time::sleep(0.1);
+    }
+
+    DJV_ASSERT(2 == prefetch->stats().files);
+
+    ::remove(file_name.c_str());
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_file_scanner_test.cpp
+
+#include <djv_assert.h>
+#include <djv_debug.h>
+#include <djv_file_io.h>
+#include <djv_file_scanner.h>
+#include <djv_timer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace djv;
+
+namespace
+{
+
+void write(const String & file_name, const String & in)
+{
+    File_Io io;
+    io.open(file_name, File_Io::WRITE);
+    io.set(in.c_str(), in.size());
+}
+
+void scan(const String & file_name)
+{
+    write(file_name,
+        "# Comment\n"
+        "P6 # Trailing comment\r\n"
+        "\t640  480\n"
+        "-12 +34 1.5 -2.5e-3 1e30 0.1#Comment\n"
+        "255\n"
+        "\x01\x02");
+
+    File_Io io;
+    io.open(file_name, File_Io::READ);
+
+    {
+        File_Scanner scanner(io);
+
+        DJV_ASSERT("P6" == scanner.word());
+        DJV_ASSERT(640 == scanner.word_int());
+        DJV_ASSERT(480 == scanner.word_int());
+        DJV_ASSERT(-12 == scanner.word_int());
+        DJV_ASSERT(34 == scanner.word_int());
+        DJV_ASSERT(1.5 == scanner.word_float());
+        DJV_ASSERT(-2.5e-3 == scanner.word_float());
+        DJV_ASSERT(1e30 == scanner.word_float());
+        DJV_ASSERT(0.1 == scanner.word_float());
+        DJV_ASSERT(255 == scanner.word_int());
+    }
+
+    // The file position follows the scanner, including the character that
+    // ends the last word.
+
+    uint8_t tmp [2] = { 0, 0 };
+    io.get(tmp, 2);
+
+    DJV_ASSERT(1 == tmp[0]);
+    DJV_ASSERT(2 == tmp[1]);
+
+    // Running out of words is an error.
+
+    io.position(0);
+
+    {
+        File_Scanner scanner(io);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            scanner.word();
+        }
+
+        const char * p = 0;
+        size_t size = 0;
+
+        DJV_ASSERT(scanner.word(p, size));
+        DJV_ASSERT(2 == size);
+        DJV_ASSERT(! scanner.word(p, size));
+        DJV_ASSERT(! scanner.is_valid());
+
+        bool error = false;
+
+        try
+        {
+            scanner.word();
+        }
+        catch (Error)
+        {
+            error = true;
+        }
+
+        DJV_ASSERT(error);
+    }
+
+    // Lines.
+
+    io.position(0);
+
+    {
+        File_Scanner scanner(io);
+
+        DJV_ASSERT("# Comment" == scanner.line());
+        DJV_ASSERT("P6 # Trailing comment" == scanner.line());
+        DJV_ASSERT("\t640  480" == scanner.line());
+    }
+
+    const List<String> lines = File_Io::lines(file_name);
+
+    DJV_ASSERT(6 == lines.size());
+    DJV_ASSERT("255" == lines[4]);
+}
+
+void numbers()
+{
+    int64_t i = 0;
+
+    DJV_ASSERT(File_Scanner::to_int("0", 1, i) && 0 == i);
+    DJV_ASSERT(File_Scanner::to_int("-1023", 5, i) && -1023 == i);
+    DJV_ASSERT(File_Scanner::to_int("65535xyz", 5, i) && 65535 == i);
+    DJV_ASSERT(! File_Scanner::to_int("", 0, i));
+    DJV_ASSERT(! File_Scanner::to_int("-", 1, i));
+    DJV_ASSERT(! File_Scanner::to_int("12a", 3, i));
+    DJV_ASSERT(! File_Scanner::to_int("1.0", 3, i));
+
+    double f = 0.0;
+
+    DJV_ASSERT(File_Scanner::to_float("1", 1, f) && 1.0 == f);
+    DJV_ASSERT(File_Scanner::to_float(".5", 2, f) && 0.5 == f);
+    DJV_ASSERT(File_Scanner::to_float("-5.", 3, f) && -5.0 == f);
+    DJV_ASSERT(File_Scanner::to_float("1E+2", 4, f) && 100.0 == f);
+    DJV_ASSERT(File_Scanner::to_float("inf", 3, f) && f > 1e308);
+    DJV_ASSERT(! File_Scanner::to_float("", 0, f));
+    DJV_ASSERT(! File_Scanner::to_float(".", 1, f));
+    DJV_ASSERT(! File_Scanner::to_float("1e", 2, f));
+    DJV_ASSERT(! File_Scanner::to_float("1.0f", 4, f));
+
+    // The results match the C library exactly.
+
+    srand(1);
+
+    for (int j = 0; j < 100000; ++j)
+    {
+        char tmp [cstring_size] = "";
+
+        const int size = j % 2 ?
+            SNPRINTF(tmp, cstring_size, "%.*g", 1 + j % 17,
+                (rand() - RAND_MAX / 2) / static_cast<double>(rand() + 1)) :
+            SNPRINTF(tmp, cstring_size, "%d.%de%d",
+                rand() % 100000, rand(), rand() % 80 - 40);
+
+        DJV_ASSERT(File_Scanner::to_float(tmp, size, f));
+        DJV_ASSERT(::strtod(tmp, 0) == f);
+    }
+}
+
+void throughput(const String & file_name)
+{
+    DJV_DEBUG("throughput");
+
+    // Write a large ASCII LUT.
+
+    const int count = 1000000;
+
+    {
+        File_Io io;
+        io.open(file_name, File_Io::WRITE);
+
+        io.set("# LUT\n", 6);
+
+        for (int i = 0; i < count; ++i)
+        {
+            char tmp [cstring_size] = "";
+            const int size = SNPRINTF(tmp, cstring_size, "%6d\n", i % 65536);
+            io.set(tmp, size);
+        }
+    }
+
+    File_Io io;
+    io.open(file_name, File_Io::READ);
+
+    Timer timer;
+    timer.start();
+
+    int64_t sum = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        char tmp [cstring_size] = "";
+        File_Io::word(io, tmp, cstring_size);
+        sum += String_Util::string_to_int<int>(tmp, cstring_size);
+    }
+
+    timer.check();
+
+    DJV_DEBUG_PRINT("File_Io::word = " << timer.seconds() << " seconds");
+
+    io.position(0);
+
+    timer.start();
+
+    int64_t sum2 = 0;
+
+    {
+        File_Scanner scanner(io);
+
+        for (int i = 0; i < count; ++i)
+        {
+            sum2 += scanner.word_int();
+        }
+    }
+
+    timer.check();
+
+    DJV_DEBUG_PRINT("File_Scanner = " << timer.seconds() << " seconds");
+
+    DJV_ASSERT(sum == sum2);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    const String file_name = "djv_file_scanner_test.tmp";
+
+    try
+    {
+        scan(file_name);
+        numbers();
+        throughput(file_name);
+    }
+    catch (Error in)
+    {
+        Error_Util::print(in);
+
+        ::remove(file_name.c_str());
+
+        return 1;
+    }
+
+    ::remove(file_name.c_str());
+
+    return 0;
+}
+
@@ -0,0 +1,576 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_gl_image_test.cpp
+
+#include <djv_assert.h>
+#include <djv_debug.h>
+#include <djv_gl_image.h>
+
+using namespace djv;
+
+namespace
+{
+
+bool compare(const Pixel_Data & a, const Pixel_Data & b, int tolerance)
+{
+    if (a.size() != b.size() || a.pixel() != b.pixel())
+    {
+        return false;
+    }
+
+    const uint8_t * a_p = a.data();
+    const uint8_t * b_p = b.data();
+
+    for (size_t i = 0; i < a.bytes_data(); ++i)
+    {
+        if (Math::abs(static_cast<int>(a_p[i]) - b_p[i]) > tolerance)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The expected values below follow the fragment shader generated by
+// Gl_Image::draw(), in double precision.
+
+bool compare(const float * a, const double * b)
+{
+    for (int c = 0; c < 4; ++c)
+    {
+        if (Math::abs(a[c] - b[c]) > 0.0001 * Math::max(1.0, Math::abs(b[c])))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Pixel_Data lut(double r0, double r1, double g0, double g1, double b0, double b1)
+{
+    Pixel_Data out(Pixel_Data_Info(V2i(256, 1), Pixel::RGB_F32));
+
+    Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(out.data());
+
+    for (int i = 0; i < 256; ++i, p += 3)
+    {
+        const double v = i / 255.0;
+
+        p[0] = static_cast<Pixel::F32_T>(r0 + (r1 - r0) * v * v);
+        p[1] = static_cast<Pixel::F32_T>(g0 + (g1 - g0) * v);
+        p[2] = static_cast<Pixel::F32_T>(b0 + (b1 - b0) * Math::sqrt(v));
+    }
+
+    return out;
+}
+
+// The lookup table textures are sampled with the nearest value.
+
+void lut(const Pixel_Data & in, double * value)
+{
+    const Pixel::F32_T * p = reinterpret_cast<const Pixel::F32_T *>(in.data());
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const int i = Math::clamp(
+            static_cast<int>(Math::floor(value[c] * 256.0)), 0, 255);
+
+        value[c] = p[i * 3 + c];
+    }
+}
+
+double knee(double x, double f)
+{
+    return Math::log(x * f + 1.0) / f;
+}
+
+double knee2(double x, double y)
+{
+    double f0 = 0.0, f1 = 1.0;
+
+    while (knee(x, f1) > y)
+    {
+        f0 = f1;
+        f1 = f1 * 2.0;
+    }
+
+    for (int i = 0; i < 30; ++i)
+    {
+        const double f2 = (f0 + f1) / 2.0;
+
+        if (knee(x, f2) < y)
+        {
+            f1 = f2;
+        }
+        else
+        {
+            f0 = f2;
+        }
+    }
+
+    return (f0 + f1) / 2.0;
+}
+
+void color_profile(const Color_Profile & in, double * value)
+{
+    switch (in.type)
+    {
+        case Color_Profile::LUT:
+
+            lut(in.lut, value);
+
+            break;
+
+        case Color_Profile::GAMMA:
+
+            for (int c = 0; c < 3; ++c)
+            {
+                value[c] = Math::pow(value[c], 1.0 / in.gamma);
+            }
+
+            break;
+
+        case Color_Profile::EXPOSURE:
+        {
+            const double v = Math::pow(2.0, in.exposure.value + 2.47393);
+            const double d = in.exposure.defog;
+            const double k = Math::pow(2.0, in.exposure.knee_low);
+            const double f = knee2(
+                Math::pow(2.0, in.exposure.knee_high) - k,
+                Math::pow(2.0, 3.5) - k);
+
+            for (int c = 0; c < 3; ++c)
+            {
+                value[c] = Math::max(0.0, value[c] - d) * v;
+
+                if (value[c] > k)
+                {
+                    value[c] = k + knee(value[c] - k, f);
+                }
+
+                value[c] *= 0.332;
+            }
+        }
+        break;
+
+        default: break;
+    }
+}
+
+void display_profile(
+    const Gl_Image_Display_Profile & in,
+    Gl_Image_Options::CHANNEL        channel,
+    double *                         value)
+{
+    const Gl_Image_Display_Profile defaults;
+
+    if (Vector_Util::is_size_valid(in.lut.size()))
+    {
+        lut(in.lut, value);
+    }
+
+    // The color matrix multiplies a row vector.
+
+    if (in.color != defaults.color)
+    {
+        const M4f m = Gl_Image_Color::color_matrix(in.color);
+
+        double tmp [3];
+
+        for (int c = 0; c < 3; ++c)
+        {
+            tmp[c] =
+                value[0] * m.e[c] +
+                value[1] * m.e[4 + c] +
+                value[2] * m.e[8 + c] +
+                m.e[12 + c];
+        }
+
+        for (int c = 0; c < 3; ++c)
+        {
+            value[c] = tmp[c];
+        }
+    }
+
+    if (in.levels != defaults.levels)
+    {
+        const double in1  = in.levels.in_high - in.levels.in_low;
+        const double out1 = in.levels.out_high - in.levels.out_low;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            value[c] = Math::pow(
+                Math::max(value[c] - in.levels.in_low, 0.0) / in1,
+                1.0 / in.levels.gamma) * out1 + in.levels.out_low;
+        }
+    }
+
+    if (in.soft_clip != defaults.soft_clip)
+    {
+        const double tmp = 1.0 - in.soft_clip;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            if (value[c] > tmp)
+            {
+                value[c] = tmp +
+                    (1.0 - Math::exp(-(value[c] - tmp) / in.soft_clip)) *
+                    in.soft_clip;
+            }
+        }
+    }
+
+    if (channel)
+    {
+        value[0] = value[1] = value[2] = value[3] = value[channel - 1];
+    }
+}
+
+// Copy the image with the CPU backend and compare it with the shader
+// formulas.
+
+bool compare(const Pixel_Data & in, const Gl_Image_Options & options)
+{
+    Pixel_Data out(Pixel_Data_Info(in.size(), Pixel::RGBA_F32));
+
+    Gl_Image::copy_cpu(in, out, options);
+
+    for (int x = 0; x < in.w(); ++x)
+    {
+        const Pixel::F32_T * in_p =
+            reinterpret_cast<const Pixel::F32_T *>(in.data(x, 0));
+
+        double value [] = { in_p[0], in_p[1], in_p[2], in_p[3] };
+
+        color_profile(options.color_profile, value);
+
+        display_profile(options.display_profile, options.channel, value);
+
+        if (! compare(
+            reinterpret_cast<const Pixel::F32_T *>(out.data(x, 0)), value))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    // Create a test image.
+
+    Pixel_Data input(Pixel_Data_Info(V2i(64, 48), Pixel::RGBA_U16));
+
+    for (int y = 0; y < input.h(); ++y)
+    {
+        for (int x = 0; x < input.w(); ++x)
+        {
+            Pixel::U16_T * p =
+                reinterpret_cast<Pixel::U16_T *>(input.data(x, y));
+
+            p[0] = x * 1000;
+            p[1] = y * 1000;
+            p[2] = (x + y) * 500;
+            p[3] = Pixel::u16_max;
+        }
+    }
+
+    Pixel_Data reference(Pixel_Data_Info(input.size(), Pixel::RGBA_U8));
+
+    Pixel::convert(
+        input.data(), input.pixel(),
+        reference.data(), reference.pixel(),
+        input.w() * input.h());
+
+    // Test a conversion.
+
+    Pixel_Data output(reference.info());
+
+    Gl_Image::copy_cpu(input, output);
+
+    DJV_ASSERT(compare(output, reference, 1));
+
+    // Test converting from and to the opposite endian.
+
+    Pixel_Data_Info endian_info(input.size(), Pixel::RGB_U10);
+
+    Pixel_Data u10(endian_info);
+
+    Gl_Image::copy_cpu(input, u10);
+
+    endian_info.endian = Memory::endian_opposite(Memory::endian());
+
+    Pixel_Data u10_endian(endian_info);
+
+    Gl_Image::copy_cpu(input, u10_endian);
+
+    Memory::endian(u10_endian.data(), u10_endian.w() * u10_endian.h(), 4);
+
+    DJV_ASSERT(compare(u10_endian, u10, 0));
+
+    Memory::endian(u10_endian.data(), u10_endian.w() * u10_endian.h(), 4);
+
+    Gl_Image::copy_cpu(u10_endian, output);
+
+    Pixel_Data u10_output(output.info());
+
+    Gl_Image::copy_cpu(u10, u10_output);
+
+    DJV_ASSERT(compare(output, u10_output, 0));
+
+    // Test aligned scanlines.
+
+    Pixel_Data odd;
+    Pixel_Data::crop(input, &odd, Box2i(0, 0, 61, input.h()));
+
+    Pixel_Data packed(Pixel_Data_Info(odd.size(), Pixel::RGB_U8));
+
+    Gl_Image::copy_cpu(odd, packed);
+
+    Pixel_Data_Info aligned_info = packed.info();
+    aligned_info.align = 32;
+
+    Pixel_Data aligned(aligned_info);
+
+    Gl_Image::copy_cpu(odd, aligned);
+
+    DJV_ASSERT(packed.bytes_scanline() != aligned.bytes_scanline());
+
+    for (int y = 0; y < packed.h(); ++y)
+    {
+        DJV_ASSERT(Memory::compare(
+            static_cast<const Pixel_Data &>(packed).data(0, y),
+            static_cast<const Pixel_Data &>(aligned).data(0, y),
+            packed.w() * packed.bytes_pixel()) == 0);
+    }
+
+    Color packed_average;
+    Color aligned_average;
+
+    Gl_Image::average(packed, &packed_average);
+    Gl_Image::average(aligned, &aligned_average);
+
+    DJV_ASSERT(packed_average == aligned_average);
+
+    Pixel_Data packed_histogram;
+    Pixel_Data aligned_histogram;
+    Color min;
+    Color max;
+
+    Gl_Image::histogram(
+        packed, &packed_histogram, Gl_Image::HISTOGRAM_256, &min, &max);
+    Gl_Image::histogram(
+        aligned, &aligned_histogram, Gl_Image::HISTOGRAM_256, &min, &max);
+
+    DJV_ASSERT(packed_histogram == aligned_histogram);
+
+    // Test mirroring.
+
+    Pixel_Data_Info info = output.info();
+    info.mirror.y = true;
+    output.set(info);
+
+    Gl_Image_Options options;
+    options.xform.mirror.y = true;
+
+    Gl_Image::copy_cpu(input, output, options);
+
+    DJV_ASSERT(compare(output, reference, 1));
+
+    // Test scaling.
+
+    options = Gl_Image_Options();
+    options.xform.scale = V2f(2.0);
+    options.filter = Gl_Image_Filter(
+        Gl_Image_Filter::NEAREST,
+        Gl_Image_Filter::NEAREST);
+
+    output.set(Pixel_Data_Info(input.size() * 2, Pixel::RGBA_U8));
+
+    Gl_Image::copy_cpu(input, output, options);
+
+    for (int y = 0; y < output.h(); ++y)
+    {
+        for (int x = 0; x < output.w(); ++x)
+        {
+            DJV_ASSERT(Memory::compare(
+                output.data(x, y),
+                output.data(x / 2 * 2, y / 2 * 2),
+                4) == 0);
+        }
+    }
+
+    // Filtering a constant color should not change it.
+
+    for (int y = 0; y < input.h(); ++y)
+    {
+        for (int x = 0; x < input.w(); ++x)
+        {
+            Pixel::U16_T * p =
+                reinterpret_cast<Pixel::U16_T *>(input.data(x, y));
+
+            p[0] = p[1] = p[2] = p[3] = Pixel::u16_max / 2;
+        }
+    }
+
+    for (int i = 0; i < Gl_Image_Filter::_FILTER_SIZE; ++i)
+    {
+        const Gl_Image_Filter::FILTER filter =
+            static_cast<Gl_Image_Filter::FILTER>(i);
+
+        options = Gl_Image_Options();
+        options.xform.scale = V2f(0.37, 1.7);
+        options.filter = Gl_Image_Filter(filter, filter);
+
+        output.set(Pixel_Data_Info(
+            Vector_Util::ceil<double, int>(
+                options.xform.scale * V2f(input.size())),
+            Pixel::RGBA_U8));
+
+        Gl_Image::copy_cpu(input, output, options);
+
+        for (size_t j = 0; j < output.bytes_data(); ++j)
+        {
+            DJV_ASSERT(Math::abs(output.data()[j] - 128) <= 1);
+        }
+    }
+
+    // Test the color profile, display profile, and channel options. The
+    // values are in the middle of the lookup table entries, and some are
+    // above one for the soft clip.
+
+    Pixel_Data color(Pixel_Data_Info(V2i(16, 1), Pixel::RGBA_F32));
+
+    for (int x = 0; x < color.w(); ++x)
+    {
+        Pixel::F32_T * p = reinterpret_cast<Pixel::F32_T *>(color.data(x, 0));
+
+        p[0] = (x * 16 + 8) / 256.0f;
+        p[1] = (x * 16 + 4.5f) / 256.0f * 1.25f;
+        p[2] = 128.5f / 256.0f;
+        p[3] = 0.25f;
+    }
+
+    options = Gl_Image_Options();
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.color_profile.type = Color_Profile::LUT;
+    options.color_profile.lut = lut(0.0, 1.0, 1.0, 0.0, 0.2, 0.7);
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.color_profile.type = Color_Profile::GAMMA;
+    options.color_profile.gamma = 2.2;
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.color_profile.type = Color_Profile::EXPOSURE;
+    options.color_profile.exposure.value = 1.0;
+    options.color_profile.exposure.defog = 0.01;
+    options.color_profile.exposure.knee_low = 0.0;
+    options.color_profile.exposure.knee_high = 5.0;
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.display_profile.lut = lut(0.1, 0.9, 0.0, 1.0, 1.0, 0.0);
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.display_profile.color.brightness = 1.2;
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.display_profile.color.contrast = 0.8;
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.display_profile.color.saturation = 0.5;
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.display_profile.levels.in_low = 0.1;
+    options.display_profile.levels.in_high = 0.9;
+    options.display_profile.levels.gamma = 2.0;
+    options.display_profile.levels.out_low = 0.05;
+    options.display_profile.levels.out_high = 0.95;
+
+    DJV_ASSERT(compare(color, options));
+
+    options = Gl_Image_Options();
+    options.display_profile.soft_clip = 0.2;
+
+    DJV_ASSERT(compare(color, options));
+
+    for (int i = 1; i < Gl_Image_Options::_CHANNEL_SIZE; ++i)
+    {
+        options = Gl_Image_Options();
+        options.channel = static_cast<Gl_Image_Options::CHANNEL>(i);
+
+        DJV_ASSERT(compare(color, options));
+    }
+
+    // Test all of the options together.
+
+    options = Gl_Image_Options();
+    options.color_profile.type = Color_Profile::GAMMA;
+    options.color_profile.gamma = 0.8;
+    options.display_profile.lut = lut(0.0, 1.2, 0.1, 1.0, 0.0, 0.9);
+    options.display_profile.color.brightness = 1.1;
+    options.display_profile.color.contrast = 1.3;
+    options.display_profile.color.saturation = 0.7;
+    options.display_profile.levels.in_low = 0.05;
+    options.display_profile.levels.gamma = 1.5;
+    options.display_profile.levels.out_high = 0.9;
+    options.display_profile.soft_clip = 0.1;
+
+    DJV_ASSERT(compare(color, options));
+
+    options.channel = Gl_Image_Options::CHANNEL_GREEN;
+
+    DJV_ASSERT(compare(color, options));
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_memory_pool_test.cpp
+
+#include <djv_assert.h>
+#include <djv_memory_buffer.h>
+#include <djv_memory_pool.h>
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    // Small sizes are not pooled.
+
+    DJV_ASSERT(100 == Memory_Pool::capacity(100));
+
+    // Sizes are rounded up to a size class.
+
+    for (size_t i = Memory_Pool::min_size; i < 64 * 1024 * 1024; i = i * 3 / 2)
+    {
+        const size_t capacity = Memory_Pool::capacity(i);
+
+        DJV_ASSERT(capacity >= i);
+        DJV_ASSERT(capacity - i <= i / 8);
+        DJV_ASSERT(Memory_Pool::capacity(capacity) == capacity);
+    }
+
+    // Blocks are re-used.
+
+    Memory_Pool pool;
+
+    const size_t size = Memory_Pool::capacity(10 * 1024 * 1024);
+
+    void * a = pool.get(size);
+    pool.del(a, size);
+
+    DJV_ASSERT(size == pool.stats().resident);
+
+    void * b = pool.get(size);
+
+    DJV_ASSERT(a == b);
+    DJV_ASSERT(1 == pool.stats().hits);
+    DJV_ASSERT(1 == pool.stats().misses);
+    DJV_ASSERT(size == pool.stats().used);
+    DJV_ASSERT(0 == pool.stats().resident);
+
+    pool.del(b, size);
+
+    // Blocks are freed when the pool is full.
+
+    pool.max_bytes(size / 2);
+
+    DJV_ASSERT(0 == pool.stats().resident);
+
+    pool.del(pool.get(size), size);
+
+    DJV_ASSERT(0 == pool.stats().resident);
+
+    // Buffers keep their memory when they shrink a little.
+
+    Memory_Buffer<float> buffer(1024 * 1024);
+
+    const float * data = buffer.data();
+
+    buffer.size(1000 * 1000);
+
+    DJV_ASSERT(data == buffer.data());
+
+    buffer.size(1024 * 1024);
+
+    DJV_ASSERT(data == buffer.data());
+
+    // Reserving memory keeps the contents.
+
+    buffer()[0] = 1.0;
+    buffer.reserve(4 * 1024 * 1024);
+
+    DJV_ASSERT(buffer.capacity() >= 4 * 1024 * 1024);
+    DJV_ASSERT(1024 * 1024 == buffer.size());
+    DJV_ASSERT(1.0 == buffer()[0]);
+
+    return 0;
+}
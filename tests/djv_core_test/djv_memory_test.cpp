@@ -0,0 +1,407 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_memory_test.cpp
+
+#include <djv_assert.h>
+#include <djv_debug.h>
+#include <djv_memory.h>
+#include <djv_memory_buffer.h>
+#include <djv_pixel_data.h>
+#include <djv_thread_pool.h>
+#include <djv_timer.h>
+
+#include <string.h>
+
+using namespace djv;
+
+namespace
+{
+
+// Reference endian conversion.
+
+void endian_reference(
+    const uint8_t * in,
+    uint8_t *       out,
+    size_t          size,
+    size_t          word_size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        for (size_t j = 0; j < word_size; ++j)
+        {
+            out[i * word_size + j] = in[i * word_size + word_size - 1 - j];
+        }
+    }
+}
+
+void endian_test(size_t word_size)
+{
+    static const size_t guard = 16;
+
+    Memory_Buffer<uint8_t> in   (300 * 8 + guard * 2);
+    Memory_Buffer<uint8_t> out  (300 * 8 + guard * 2);
+    Memory_Buffer<uint8_t> check(300 * 8 + guard * 2);
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in()[i] = static_cast<uint8_t>(i * 13 + 1);
+    }
+
+    // Test a range of sizes and unaligned offsets so both the SIMD and scalar
+    // code paths are used.
+
+    for (size_t size = 0; size < 300; size += (size < 40 ? 1 : 37))
+    {
+        for (size_t offset = 0; offset < 4; ++offset)
+        {
+            const uint8_t * in_p = in() + guard + offset;
+
+            // Conversion while copying.
+
+            out.zero();
+            check.zero();
+
+            uint8_t * out_p = out() + guard + offset;
+
+            endian_reference(in_p, check() + guard + offset, size, word_size);
+
+            Memory::endian(in_p, out_p, size, word_size);
+
+            DJV_ASSERT(0 == Memory::compare(out(), check(), out.size()));
+
+            // In-place conversion.
+
+            Memory::copy(in(), out(), in.size());
+            Memory::copy(in(), check(), in.size());
+
+            endian_reference(in_p, check() + guard + offset, size, word_size);
+
+            Memory::endian(out_p, size, word_size);
+
+            DJV_ASSERT(0 == Memory::compare(out(), check(), out.size()));
+
+            // Converting twice gives back the original.
+
+            Memory::endian(out_p, size, word_size);
+
+            DJV_ASSERT(0 == Memory::compare(out(), in(), out.size()));
+        }
+    }
+}
+
+void endian_throughput(size_t word_size)
+{
+    DJV_DEBUG("endian_throughput");
+    DJV_DEBUG_PRINT("word size = " << static_cast<int>(word_size));
+
+    const size_t size = 64 * Memory::megabyte;
+
+    Memory_Buffer<uint8_t> in (size);
+    Memory_Buffer<uint8_t> out(size);
+    in.zero();
+    out.zero();
+
+    static const int count = 10;
+
+    const double gigabytes =
+        static_cast<double>(count * size) / Memory::gigabyte;
+
+    Timer timer;
+    timer.start();
+
+    for (int i = 0; i < count; ++i)
+    {
+        Memory::endian(in(), out(), size / word_size, word_size);
+    }
+
+    timer.check();
+
+    DJV_DEBUG_PRINT("copy = " << gigabytes / timer.seconds() << " GB/s");
+
+    timer.start();
+
+    for (int i = 0; i < count; ++i)
+    {
+        Memory::endian(out(), size / word_size, word_size);
+    }
+
+    timer.check();
+
+    DJV_DEBUG_PRINT("in-place = " << gigabytes / timer.seconds() << " GB/s");
+}
+
+void copy_test()
+{
+    const size_t size = Memory::copy_large_size * 2 + 12345;
+
+    Memory_Buffer<uint8_t> in (size + 16);
+    Memory_Buffer<uint8_t> out(size + 16);
+
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in()[i] = static_cast<uint8_t>(i * 13 + 1);
+    }
+
+    // Test large copies with unaligned offsets so the streaming stores and
+    // the remainders are used.
+
+    for (size_t offset = 0; offset < 4; ++offset)
+    {
+        out.zero();
+
+        Memory::copy(in() + offset, out() + offset * 3, size);
+
+        DJV_ASSERT(0 == Memory::compare(
+            in() + offset,
+            out() + offset * 3,
+            size));
+        DJV_ASSERT(0 == out()[offset * 3 + size]);
+    }
+
+    // Test small copies.
+
+    out.zero();
+
+    Memory::copy(in(), out(), 100);
+
+    DJV_ASSERT(0 == Memory::compare(in(), out(), 100));
+    DJV_ASSERT(0 == out()[100]);
+}
+
+void copy_throughput(const String & name, size_t size)
+{
+    DJV_DEBUG("copy_throughput");
+    DJV_DEBUG_PRINT("frame = " << name);
+    DJV_DEBUG_PRINT("size = " << Memory::label_size(size));
+    DJV_DEBUG_PRINT("threads = " << Thread_Pool::global()->thread_count());
+
+    Memory_Buffer<uint8_t> in (size);
+    Memory_Buffer<uint8_t> out(size);
+    in.zero();
+    out.zero();
+
+    static const int count = 5;
+
+    const double gigabytes =
+        static_cast<double>(count) * size / Memory::gigabyte;
+
+    Timer timer;
+    timer.start();
+
+    for (int i = 0; i < count; ++i)
+    {
+        ::memcpy(out(), in(), size);
+    }
+
+    timer.check();
+
+    DJV_DEBUG_PRINT("memcpy = " << gigabytes / timer.seconds() << " GB/s");
+
+    timer.start();
+
+    for (int i = 0; i < count; ++i)
+    {
+        Memory::copy(in(), out(), size);
+    }
+
+    timer.check();
+
+    DJV_DEBUG_PRINT("copy = " << gigabytes / timer.seconds() << " GB/s");
+}
+
+void stats_test()
+{
+    const Memory::Stats image = Memory::stats(Memory::TAG_IMAGE);
+    const Memory::Stats cache = Memory::stats(Memory::TAG_CACHE);
+    const Memory::Stats total = Memory::stats();
+
+    {
+        // Memory is counted under the buffer's tag.
+
+        Memory_Buffer<uint8_t> buffer;
+        buffer.tag(Memory::TAG_IMAGE);
+        buffer.size(Memory::megabyte);
+
+        const uint64_t bytes = buffer.capacity() + 1;
+
+        DJV_ASSERT(Memory::stats(Memory::TAG_IMAGE).live == image.live + bytes);
+        DJV_ASSERT(Memory::stats().live == total.live + bytes);
+        DJV_ASSERT(Memory::stats().peak >= total.live + bytes);
+
+        // Changing the tag moves the memory.
+
+        buffer.tag(Memory::TAG_CACHE);
+
+        DJV_ASSERT(Memory::stats(Memory::TAG_IMAGE).live == image.live);
+        DJV_ASSERT(Memory::stats(Memory::TAG_CACHE).live == cache.live + bytes);
+        DJV_ASSERT(Memory::stats().live == total.live + bytes);
+
+        // Pixel data copies share the tag.
+
+        Pixel_Data data;
+        data.memory_tag(Memory::TAG_CACHE);
+        data.set(Pixel_Data_Info(V2i(100, 100), Pixel::RGBA_U8));
+
+        Pixel_Data copy(data);
+
+        DJV_ASSERT(Memory::TAG_CACHE == copy.memory_tag());
+        DJV_ASSERT(
+            Memory::stats(Memory::TAG_CACHE).live >=
+            cache.live + bytes + data.bytes_data());
+    }
+
+    DJV_ASSERT(Memory::stats(Memory::TAG_IMAGE).live == image.live);
+    DJV_ASSERT(Memory::stats(Memory::TAG_CACHE).live == cache.live);
+    DJV_ASSERT(Memory::stats().live == total.live);
+
+    Memory::stats_reset();
+
+    DJV_ASSERT(Memory::stats().peak == Memory::stats().live);
+
+    DJV_ASSERT(Memory::label_stats().size() > 0);
+}
+
+} // namespace
+
+void policy_test()
+{
+    const Memory::Policy policy = Memory::policy();
+
+    DJV_ASSERT(Memory::numa_nodes() >= 1);
+
+    // Large buffers are aligned to huge pages.
+
+    const size_t size = policy.large_size + 12345;
+
+    uint8_t * p = reinterpret_cast<uint8_t *>(Memory::get(size));
+
+    DJV_ASSERT(p);
+
+#if defined(DJV_LINUX)
+    DJV_ASSERT(! (reinterpret_cast<size_t>(p) % Memory::huge_page_size));
+#endif
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        p[i] = static_cast<uint8_t>(i);
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        DJV_ASSERT(static_cast<uint8_t>(i) == p[i]);
+    }
+
+    Memory::del(p);
+
+    // Small buffers use the normal allocator.
+
+    p = reinterpret_cast<uint8_t *>(Memory::get(100));
+
+    DJV_ASSERT(p);
+
+    Memory::del(p);
+
+    // Change the policy.
+
+    Memory::Policy tmp;
+    tmp.huge_pages = false;
+    tmp.numa       = Memory::NUMA_INTERLEAVE;
+
+    Memory::policy(tmp);
+
+    DJV_ASSERT(! Memory::policy().huge_pages);
+    DJV_ASSERT(Memory::NUMA_INTERLEAVE == Memory::policy().numa);
+
+    p = reinterpret_cast<uint8_t *>(Memory::get(size));
+
+    DJV_ASSERT(p);
+
+    Memory::zero(p, size);
+
+    Memory::del(p);
+
+    Memory::policy(policy);
+
+    // Test labels.
+
+    String s = "local";
+
+    Memory::NUMA numa = Memory::NUMA_DEFAULT;
+
+    s >> numa;
+
+    DJV_ASSERT(Memory::NUMA_LOCAL == numa);
+}
+
+int main(int argc, char ** argv)
+{
+    // Single words.
+
+    uint16_t u16 = 0x0102;
+    Memory::endian(&u16, 1, 2);
+    DJV_ASSERT(0x0201 == u16);
+
+    uint32_t u32 = 0x01020304;
+    Memory::endian(&u32, 1, 4);
+    DJV_ASSERT(0x04030201 == u32);
+
+    uint64_t u64 = 0x0102030405060708ULL;
+    Memory::endian(&u64, 1, 8);
+    DJV_ASSERT(0x0807060504030201ULL == u64);
+
+    // Blocks.
+
+    endian_test(2);
+    endian_test(4);
+    endian_test(8);
+
+    // Copies.
+
+    copy_test();
+
+    // Memory accounting.
+
+    stats_test();
+    policy_test();
+
+    endian_throughput(2);
+    endian_throughput(4);
+    endian_throughput(8);
+
+    // 4K and 8K RGBA, 16-bits per channel.
+
+    copy_throughput("4K", 4096 * 2160 * 8);
+    copy_throughput("8K", 8192 * 4320 * 8);
+
+    return 0;
+}
+
@@ -0,0 +1,522 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_pixel_data_test.cpp
+
+#include <djv_assert.h>
+#include <djv_color.h>
+#include <djv_image.h>
+#include <djv_image_io.h>
+
+using namespace djv;
+
+int main(int argc, char ** argv)
+{
+    Pixel_Data a(Pixel_Data_Info(V2i(16, 8), Pixel::RGBA_U8));
+    a.zero();
+
+    // Copies share the memory.
+
+    Pixel_Data b = a;
+
+    DJV_ASSERT(a.info() == b.info());
+    DJV_ASSERT(static_cast<const Pixel_Data &>(a).data() ==
+        static_cast<const Pixel_Data &>(b).data());
+
+    // Modifying a copy does not change the original.
+
+    b.data()[0] = 1;
+
+    DJV_ASSERT(0 == static_cast<const Pixel_Data &>(a).data()[0]);
+    DJV_ASSERT(1 == static_cast<const Pixel_Data &>(b).data()[0]);
+    DJV_ASSERT(a != b);
+
+    a = b;
+
+    DJV_ASSERT(a == b);
+
+    // Setting the information does not change the copies.
+
+    b.set(Pixel_Data_Info(V2i(4, 4), Pixel::L_U8));
+
+    DJV_ASSERT(V2i(16, 8) == a.size());
+    DJV_ASSERT(1 == static_cast<const Pixel_Data &>(a).data()[0]);
+
+    // Images are shared along with their tags.
+
+    Image image(Pixel_Data_Info(V2i(16, 8), Pixel::RGB_U16));
+    image.tag["Test"] = "Value";
+
+    const Image copy = image;
+
+    DJV_ASSERT(static_cast<const Image &>(image).data() == copy.data());
+    DJV_ASSERT(copy.tag["Test"] == "Value");
+
+    // Crop a region of the pixel data.
+
+    Pixel_Data c(Pixel_Data_Info(V2i(16, 8), Pixel::L_U16));
+
+    for (int y = 0; y < c.h(); ++y)
+    {
+        for (int x = 0; x < c.w(); ++x)
+        {
+            reinterpret_cast<uint16_t *>(c.data(x, y))[0] = y * 16 + x;
+        }
+    }
+
+    Pixel_Data d;
+    Pixel_Data::crop(c, &d, Box2i(3, 2, 5, 4));
+
+    DJV_ASSERT(V2i(5, 4) == d.size());
+    DJV_ASSERT(c.pixel() == d.pixel());
+
+    for (int y = 0; y < d.h(); ++y)
+    {
+        for (int x = 0; x < d.w(); ++x)
+        {
+            DJV_ASSERT((y + 2) * 16 + x + 3 ==
+                reinterpret_cast<const uint16_t *>(
+                    static_cast<const Pixel_Data &>(d).data(x, y))[0]);
+        }
+    }
+
+    // Views reference a region of the pixel data without copying it.
+
+    const Pixel_Data_View view(c, Box2i(3, 2, 5, 4));
+
+    DJV_ASSERT(V2i(5, 4) == view.size());
+    DJV_ASSERT(! view.is_writable());
+    DJV_ASSERT(view.data() ==
+        static_cast<const Pixel_Data &>(c).data(3, 2));
+    DJV_ASSERT(view.bytes_scanline() == c.bytes_scanline());
+
+    for (int y = 0; y < view.h(); ++y)
+    {
+        for (int x = 0; x < view.w(); ++x)
+        {
+            DJV_ASSERT((y + 2) * 16 + x + 3 ==
+                reinterpret_cast<const uint16_t *>(view.data(x, y))[0]);
+        }
+    }
+
+    // Writing through a view detaches the pixel data from its copies.
+
+    const Pixel_Data c_copy = c;
+
+    Pixel_Data_View c_view(&c, Box2i(1, 1, 2, 2));
+
+    DJV_ASSERT(c_view.is_writable());
+
+    reinterpret_cast<uint16_t *>(c_view.data(1, 1))[0] = 1000;
+
+    DJV_ASSERT(1000 == reinterpret_cast<const uint16_t *>(
+        static_cast<const Pixel_Data &>(c).data(2, 2))[0]);
+    DJV_ASSERT(2 * 16 + 2 == reinterpret_cast<const uint16_t *>(
+        c_copy.data(2, 2))[0]);
+
+    // Scanlines are padded to the alignment.
+
+    Pixel_Data_Info aligned_info(V2i(5, 3), Pixel::RGB_U8);
+
+    DJV_ASSERT(15 == Pixel_Data::bytes_scanline(aligned_info));
+
+    aligned_info.align = 4;
+
+    DJV_ASSERT(16 == Pixel_Data::bytes_scanline(aligned_info));
+    DJV_ASSERT(48 == Pixel_Data::bytes_data(aligned_info));
+
+    aligned_info.align = 32;
+
+    DJV_ASSERT(32 == Pixel_Data::bytes_scanline(aligned_info));
+    DJV_ASSERT(96 == Pixel_Data::bytes_data(aligned_info));
+
+    Pixel_Data aligned(aligned_info);
+    aligned.zero();
+
+    DJV_ASSERT(32 == aligned.bytes_scanline());
+    DJV_ASSERT(2 * 32 + 3 * 3 ==
+        static_cast<const Pixel_Data &>(aligned).data(3, 2) -
+        static_cast<const Pixel_Data &>(aligned).data());
+
+    for (int y = 0; y < aligned.h(); ++y)
+    {
+        for (int x = 0; x < aligned.w(); ++x)
+        {
+            aligned.data(x, y)[0] = y * 5 + x;
+        }
+    }
+
+    // The alignment padding is not compared.
+
+    Pixel_Data aligned_copy = aligned;
+    aligned_copy.data()[31] = 1;
+
+    DJV_ASSERT(aligned == aligned_copy);
+
+    aligned_copy.data(4, 2)[0] = 0;
+
+    DJV_ASSERT(aligned != aligned_copy);
+
+    // Crop aligned pixel data.
+
+    const Pixel_Data_View aligned_view(aligned, Box2i(1, 1, 3, 2));
+    Pixel_Data aligned_crop;
+    Pixel_Data::crop(aligned, &aligned_crop, Box2i(1, 1, 3, 2));
+
+    DJV_ASSERT(32 == aligned_crop.bytes_scanline());
+
+    for (int y = 0; y < aligned_crop.h(); ++y)
+    {
+        for (int x = 0; x < aligned_crop.w(); ++x)
+        {
+            DJV_ASSERT((y + 1) * 5 + x + 1 ==
+                static_cast<const Pixel_Data &>(aligned_crop).data(x, y)[0]);
+            DJV_ASSERT((y + 1) * 5 + x + 1 == aligned_view.data(x, y)[0]);
+        }
+    }
+
+    // Clip the region of interest to the image.
+
+    const V2i size(16, 8);
+
+    DJV_ASSERT(Box2i(size) == Image_Io_Frame_Info().roi_clip(size));
+    DJV_ASSERT(Box2i(3, 2, 5, 4) ==
+        Image_Io_Frame_Info(-1, 0, Pixel_Data_Info::PROXY_NONE,
+            Box2i(3, 2, 5, 4)).roi_clip(size));
+    DJV_ASSERT(Box2i(12, 6, 4, 2) ==
+        Image_Io_Frame_Info(-1, 0, Pixel_Data_Info::PROXY_NONE,
+            Box2i(12, 6, 10, 10)).roi_clip(size));
+    DJV_ASSERT(Box2i(15, 7, 1, 1) ==
+        Image_Io_Frame_Info(-1, 0, Pixel_Data_Info::PROXY_NONE,
+            Box2i(20, 20, 4, 4)).roi_clip(size));
+
+    // Proxy scales are box filtered, and blocks on the edges are averaged
+    // over the pixels inside the image.
+
+    Pixel_Data e(Pixel_Data_Info(V2i(5, 3), Pixel::L_U16));
+
+    for (int y = 0; y < e.h(); ++y)
+    {
+        for (int x = 0; x < e.w(); ++x)
+        {
+            reinterpret_cast<uint16_t *>(e.data(x, y))[0] = y * 100 + x * 10;
+        }
+    }
+
+    Pixel_Data f(Pixel_Data_Info(
+        Pixel_Data::proxy_scale(e.size(), Pixel_Data_Info::PROXY_1_2),
+        Pixel::L_U16));
+    Pixel_Data::proxy_scale(e, &f, Pixel_Data_Info::PROXY_1_2);
+
+    DJV_ASSERT(V2i(3, 2) == f.size());
+
+    const uint16_t f_values [] = { 55, 75, 90, 205, 225, 240 };
+
+    for (int y = 0; y < f.h(); ++y)
+    {
+        for (int x = 0; x < f.w(); ++x)
+        {
+            DJV_ASSERT(f_values[y * 3 + x] ==
+                reinterpret_cast<const uint16_t *>(
+                    static_cast<const Pixel_Data &>(f).data(x, y))[0]);
+        }
+    }
+
+    // Proxy scale foreign endian pixel data of each pixel type. The output
+    // is written in the endian it is labelled with.
+
+    for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+    {
+        const Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(i);
+
+        Pixel_Data_Info endian_info(V2i(6, 5), pixel);
+
+        Pixel_Data native(endian_info);
+
+        for (int y = 0; y < native.h(); ++y)
+        {
+            for (int x = 0; x < native.w(); ++x)
+            {
+                Color tmp(Pixel::RGBA_F32);
+                tmp.set_f32(x / 8.0, 0);
+                tmp.set_f32(y / 8.0, 1);
+                tmp.set_f32((x + y) / 16.0, 2);
+                tmp.set_f32(1.0, 3);
+
+                Color color(pixel);
+                Color::convert(tmp, color);
+
+                Memory::copy(
+                    color.data(),
+                    native.data(x, y),
+                    native.bytes_pixel());
+            }
+        }
+
+        endian_info.endian = Memory::endian_opposite(Memory::endian());
+
+        Pixel_Data foreign(endian_info);
+
+        const size_t words = Pixel::RGB_U10 == pixel ?
+            native.w() * native.h() :
+            native.w() * native.h() * native.channels();
+        const size_t word_size = Pixel::RGB_U10 == pixel ?
+            4 :
+            Pixel::channel_bytes(pixel);
+
+        Memory::endian(native.data(), foreign.data(), words, word_size);
+
+        endian_info.size = Pixel_Data::proxy_scale(
+            native.size(), Pixel_Data_Info::PROXY_1_2);
+
+        Pixel_Data_Info native_info = endian_info;
+        native_info.endian = Memory::endian();
+
+        Pixel_Data reference(native_info);
+        Pixel_Data::proxy_scale(
+            native, &reference, Pixel_Data_Info::PROXY_1_2);
+
+        Pixel_Data native_out(native_info);
+        Pixel_Data::proxy_scale(
+            foreign, &native_out, Pixel_Data_Info::PROXY_1_2);
+
+        DJV_ASSERT(reference == native_out);
+
+        Pixel_Data foreign_out(endian_info);
+        Pixel_Data::proxy_scale(
+            foreign, &foreign_out, Pixel_Data_Info::PROXY_1_2);
+
+        DJV_ASSERT(Memory::endian_opposite(Memory::endian()) ==
+            foreign_out.info().endian);
+
+        const size_t out_words = words / (native.w() * native.h()) *
+            foreign_out.w() * foreign_out.h();
+
+        Memory::endian(foreign_out.data(), out_words, word_size);
+
+        DJV_ASSERT(0 == Memory::compare(
+            static_cast<const Pixel_Data &>(reference).data(),
+            static_cast<const Pixel_Data &>(foreign_out).data(),
+            reference.bytes_data()));
+    }
+
+    // Proxy scale a checkerboard of each pixel type.
+
+    for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+    {
+        const Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(i);
+
+        Color colors [2] = { Color(pixel), Color(pixel) };
+
+        for (int j = 0; j < 2; ++j)
+        {
+            Color tmp(Pixel::RGBA_F32);
+            tmp.set_f32(j ? 0.5 : 0.25, 0);
+            tmp.set_f32(j ? 0.125 : 1.0, 1);
+            tmp.set_f32(0.75, 2);
+            tmp.set_f32(j ? 0.0 : 1.0, 3);
+
+            Color::convert(tmp, colors[j]);
+        }
+
+        Pixel_Data g(Pixel_Data_Info(V2i(8, 8), pixel));
+
+        for (int y = 0; y < g.h(); ++y)
+        {
+            for (int x = 0; x < g.w(); ++x)
+            {
+                Memory::copy(
+                    colors[(x + y) % 2].data(),
+                    g.data(x, y),
+                    g.bytes_pixel());
+            }
+        }
+
+        Pixel::F32_T average [4] = { 0, 0, 0, 0 };
+
+        for (int j = 0; j < 2; ++j)
+        {
+            Color tmp(Pixel::RGBA_F32);
+            Color::convert(colors[j], tmp);
+
+            for (int c = 0; c < 4; ++c)
+            {
+                average[c] += tmp.get_f32(c) / 2;
+            }
+        }
+
+        Pixel_Data h(Pixel_Data_Info(V2i(2, 2), Pixel::RGBA_F32));
+        Pixel_Data::proxy_scale(g, &h, Pixel_Data_Info::PROXY_1_4);
+
+        const Pixel::F32_T * p = reinterpret_cast<const Pixel::F32_T *>(
+            static_cast<const Pixel_Data &>(h).data());
+
+        for (int j = 0; j < 4; ++j)
+        {
+            for (int c = 0; c < 4; ++c, ++p)
+            {
+                DJV_ASSERT(Math::abs(*p - average[c]) < 0.01);
+            }
+        }
+    }
+
+    // The proxy pyramid is the same as proxy scaling each level.
+
+    for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+    {
+        const Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(i);
+
+        Pixel_Data g(Pixel_Data_Info(V2i(37, 21), pixel));
+
+        for (size_t j = 0; j < g.bytes_data(); ++j)
+        {
+            g.data()[j] = static_cast<uint8_t>(j * 7 + (j >> 3));
+        }
+
+        if (Pixel::F16 == Pixel::type(pixel) ||
+            Pixel::F32 == Pixel::type(pixel))
+        {
+            Pixel_Data tmp(Pixel_Data_Info(g.size(), Pixel::RGBA_U8));
+
+            for (size_t j = 0; j < tmp.bytes_data(); ++j)
+            {
+                tmp.data()[j] = static_cast<uint8_t>(j * 7 + (j >> 3));
+            }
+
+            Pixel::convert(
+                tmp.data(), Pixel::RGBA_U8, g.data(), pixel, g.w() * g.h());
+        }
+
+        List<Pixel_Data> pyramid;
+        Pixel_Data::proxy_pyramid(g, &pyramid);
+
+        DJV_ASSERT(3 == pyramid.size());
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const Pixel_Data_Info::PROXY proxy =
+                static_cast<Pixel_Data_Info::PROXY>(j + 1);
+
+            Pixel_Data_Info info = g.info();
+            info.size  = Pixel_Data::proxy_scale(g.size(), proxy);
+            info.proxy = proxy;
+
+            Pixel_Data level(info);
+            Pixel_Data::proxy_scale(g, &level, proxy);
+
+            DJV_ASSERT(level.info() == pyramid[j].info());
+
+            // Floating-point sums are only the same up to rounding.
+
+            if (Pixel::F32 == Pixel::type(pixel))
+            {
+                const Pixel::F32_T * a = reinterpret_cast<const Pixel::F32_T *>(
+                    static_cast<const Pixel_Data &>(level).data());
+                const Pixel::F32_T * b = reinterpret_cast<const Pixel::F32_T *>(
+                    static_cast<const Pixel_Data &>(pyramid[j]).data());
+
+                for (size_t k = 0; k < level.bytes_data() / 4; ++k)
+                {
+                    DJV_ASSERT(Math::abs(a[k] - b[k]) < 0.00001);
+                }
+            }
+            else
+            {
+                DJV_ASSERT(level == pyramid[j]);
+            }
+        }
+    }
+
+    // Planar data round trips through interleaving, including the scanline
+    // remainders that are not handled by the SIMD kernels.
+
+    for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+    {
+        const Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(i);
+
+        if (Pixel::RGB_U10 == pixel)
+            continue;
+
+        Pixel_Data planar(Pixel_Data_Info(V2i(37, 5), pixel));
+
+        for (size_t j = 0; j < planar.bytes_data(); ++j)
+        {
+            planar.data()[j] = static_cast<uint8_t>(j * 13 + (j >> 4));
+        }
+
+        Pixel_Data interleaved(planar.info());
+        Pixel_Data::planar_interleave(planar, &interleaved);
+
+        const int channels = planar.channels();
+        const int bytes = Pixel::channel_bytes(pixel);
+
+        for (int y = 0; y < planar.h(); ++y)
+        {
+            for (int x = 0; x < planar.w(); ++x)
+            {
+                for (int c = 0; c < channels; ++c)
+                {
+                    DJV_ASSERT(0 == Memory::compare(
+                        static_cast<const Pixel_Data &>(planar).data() +
+                            ((c * planar.h() + y) * planar.w() + x) * bytes,
+                        static_cast<const Pixel_Data &>(interleaved).data(
+                            x, y) + c * bytes,
+                        bytes));
+                }
+            }
+        }
+
+        Pixel_Data tmp(planar.info());
+        Pixel_Data::planar_deinterleave(interleaved, &tmp);
+
+        DJV_ASSERT(tmp == planar);
+
+        // Interleaving with a proxy scale is the same as interleaving and
+        // then proxy scaling.
+
+        Pixel_Data_Info info = planar.info();
+        info.size  = Pixel_Data::proxy_scale(
+            info.size, Pixel_Data_Info::PROXY_1_4);
+        info.proxy = Pixel_Data_Info::PROXY_1_4;
+
+        Pixel_Data proxy(info);
+        Pixel_Data::planar_interleave(
+            planar, &proxy, Pixel_Data_Info::PROXY_1_4);
+
+        Pixel_Data proxy_tmp(info);
+        Pixel_Data::proxy_scale(
+            interleaved, &proxy_tmp, Pixel_Data_Info::PROXY_1_4);
+
+        DJV_ASSERT(proxy == proxy_tmp);
+    }
+
+    return 0;
+}
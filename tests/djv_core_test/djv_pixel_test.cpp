@@ -32,7 +32,12 @@
 //! \file djv_pixel_test.cpp
 
 #include <djv_assert.h>
+#include <djv_debug.h>
+#include <djv_math.h>
+#include <djv_memory.h>
+#include <djv_memory_buffer.h>
 #include <djv_pixel.h>
+#include <djv_timer.h>
 
 using namespace djv;
 
@@ -45,10 +50,230 @@ void convert()
     DJV_ASSERT(255 == Pixel::u10_to_u8(1023));
 }
 
+// Converting a run of pixels should give the same result as converting each
+// pixel individually.
+
+void convert_run(Pixel::PIXEL in_pixel, Pixel::PIXEL out_pixel, int size)
+{
+    const int in_bytes  = Pixel::bytes(in_pixel);
+    const int out_bytes = Pixel::bytes(out_pixel);
+
+    Memory_Buffer<uint8_t> in(size * in_bytes);
+
+    switch (Pixel::type(in_pixel))
+    {
+        case Pixel::F16:
+        case Pixel::F32:
+        {
+            const Pixel::PIXEL tmp_pixel = Pixel::pixel(in_pixel, Pixel::U16);
+
+            Memory_Buffer<uint8_t> tmp(size * Pixel::bytes(tmp_pixel));
+
+            for (size_t i = 0; i < tmp.size(); ++i)
+            {
+                tmp()[i] = static_cast<uint8_t>(Math::rand(256.0));
+            }
+
+            Pixel::convert(tmp(), tmp_pixel, in(), in_pixel, size);
+        }
+        break;
+
+        default:
+
+            for (size_t i = 0; i < in.size(); ++i)
+            {
+                in()[i] = static_cast<uint8_t>(Math::rand(256.0));
+            }
+
+            break;
+    }
+
+    Memory_Buffer<uint8_t> out(size * out_bytes);
+    Memory_Buffer<uint8_t> reference(size * out_bytes);
+
+    // Zero the output since the padding bits of 10-bit pixels are not set.
+
+    out.zero();
+    reference.zero();
+
+    for (int bgr = 0; bgr < 2; ++bgr)
+    {
+        Pixel::convert(in(), in_pixel, out(), out_pixel, size, 1, bgr != 0);
+
+        for (int i = 0; i < size; ++i)
+        {
+            Pixel::convert(
+                in() + i * in_bytes, in_pixel,
+                reference() + i * out_bytes, out_pixel,
+                1, 1, bgr != 0);
+        }
+
+        DJV_ASSERT(0 == Memory::compare(out(), reference(), out.size()));
+    }
+}
+
+// Check every 10-bit value, and the rounding of values around each 10-bit
+// step, against converting each pixel individually.
+
+void convert_u10()
+{
+    const int size = 1024 * 3;
+
+    Memory_Buffer<Pixel::U10_S> u10(size);
+
+    for (int i = 0; i < size; ++i)
+    {
+        u10()[i].r   = i % 1024;
+        u10()[i].g   = (i + 341) % 1024;
+        u10()[i].b   = 1023 - i % 1024;
+        u10()[i].pad = 0;
+    }
+
+    Memory_Buffer<Pixel::F32_T> f32(size * 3);
+
+    for (int i = 0; i < size * 3; ++i)
+    {
+        const int j = i % 1024;
+
+        switch (i / 1024 % 3)
+        {
+            case 0: f32()[i] = (j + 0.5f) / Pixel::u10_max; break;
+            case 1: f32()[i] = (j - 0.5f) / Pixel::u10_max; break;
+            case 2: f32()[i] = j / 511.0f - 0.5f;           break;
+        }
+    }
+
+    const Pixel::PIXEL pixel [] =
+    {
+        Pixel::RGB_U16,
+        Pixel::RGB_F16,
+        Pixel::RGB_F32,
+        Pixel::RGBA_U16,
+        Pixel::RGBA_F16,
+        Pixel::RGBA_F32
+    };
+
+    for (int i = 0; i < 6; ++i)
+    {
+        const int bytes = Pixel::bytes(pixel[i]);
+
+        Memory_Buffer<uint8_t> tmp(size * bytes);
+        Memory_Buffer<uint8_t> reference(size * bytes);
+
+        for (int bgr = 0; bgr < 2; ++bgr)
+        {
+            Pixel::convert(
+                u10(), Pixel::RGB_U10, tmp(), pixel[i], size, 1, bgr != 0);
+
+            for (int j = 0; j < size; ++j)
+            {
+                Pixel::convert(
+                    u10() + j, Pixel::RGB_U10,
+                    reference() + j * bytes, pixel[i],
+                    1, 1, bgr != 0);
+            }
+
+            DJV_ASSERT(0 == Memory::compare(tmp(), reference(), tmp.size()));
+        }
+
+        Pixel::convert(f32(), Pixel::RGB_F32, tmp(), pixel[i], size);
+
+        Memory_Buffer<Pixel::U10_S> out(size);
+        Memory_Buffer<Pixel::U10_S> out_reference(size);
+
+        for (int bgr = 0; bgr < 2; ++bgr)
+        {
+            Pixel::convert(
+                tmp(), pixel[i], out(), Pixel::RGB_U10, size, 1, bgr != 0);
+
+            for (int j = 0; j < size; ++j)
+            {
+                Pixel::convert(
+                    tmp() + j * bytes, pixel[i],
+                    out_reference() + j, Pixel::RGB_U10,
+                    1, 1, bgr != 0);
+            }
+
+            DJV_ASSERT(0 == Memory::compare(
+                out(), out_reference(), out.size() * sizeof(Pixel::U10_S)));
+        }
+    }
+}
+
+// Print the conversion speed in megapixels per second for every pair of
+// pixels. Each row is an input pixel and each column an output pixel.
+
+void convert_throughput(int stride)
+{
+    DJV_DEBUG("convert_throughput");
+    DJV_DEBUG_PRINT("stride = " << stride);
+
+    // Use fewer pixels than are split between threads so that only the
+    // conversion is measured.
+
+    const int size = 100000;
+
+    static const int count = 10;
+
+    Memory_Buffer<uint8_t> in (size * stride * Pixel::bytes_max * 4);
+    Memory_Buffer<uint8_t> out(size * Pixel::bytes_max * 4);
+    in.zero();
+    out.zero();
+
+    Timer timer;
+
+    for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+    {
+        String line;
+
+        for (int j = 0; j < Pixel::_PIXEL_SIZE; ++j)
+        {
+            timer.start();
+
+            for (int k = 0; k < count; ++k)
+            {
+                Pixel::convert(
+                    in(), static_cast<Pixel::PIXEL>(i),
+                    out(), static_cast<Pixel::PIXEL>(j),
+                    size, stride);
+            }
+
+            timer.check();
+
+            line += String_Format(" %%").arg(
+                static_cast<int>(count * size / timer.seconds() / 1000000.0),
+                6);
+        }
+
+        DJV_DEBUG_PRINT(static_cast<Pixel::PIXEL>(i) << ":" << line);
+    }
+}
+
 int main(int argc, char ** argv)
 {
     convert();
 
+    for (int i = 0; i < Pixel::_PIXEL_SIZE; ++i)
+    {
+        for (int j = 0; j < Pixel::_PIXEL_SIZE; ++j)
+        {
+            convert_run(
+                static_cast<Pixel::PIXEL>(i),
+                static_cast<Pixel::PIXEL>(j),
+                1001);
+        }
+    }
+
+    // Large conversions are split between threads.
+
+    convert_run(Pixel::RGB_U10, Pixel::RGB_U16, 2 * 64 * 1024 + 3);
+    convert_run(Pixel::RGBA_U8, Pixel::RGB_U8, 2 * 64 * 1024 + 3);
+
+    convert_u10();
+
+    convert_throughput(1);
+    convert_throughput(2);
+
     return 0;
 }
 
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2012 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+//! \file djv_thread_pool_test.cpp
+
+#include <djv_assert.h>
+#include <djv_debug.h>
+#include <djv_thread_pool.h>
+
+using namespace djv;
+
+namespace
+{
+
+class Sum : public Thread_Range
+{
+public:
+
+    Sum(const List<int> & in) :
+        in   (in),
+        value(0)
+    {}
+
+    void run(int begin, int end)
+    {
+        int64_t tmp = 0;
+
+        for (int i = begin; i < end; ++i)
+        {
+            tmp += in[i];
+        }
+
+        Mutex_Scope scope(mutex);
+
+        value += tmp;
+    }
+
+    const List<int> & in;
+    int64_t           value;
+    Mutex             mutex;
+};
+
+class Nested : public Thread_Range
+{
+public:
+
+    Nested(const List<int> & in) :
+        in   (in),
+        value(0)
+    {}
+
+    void run(int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            Sum sum(in);
+            Thread_Pool::global()->parallel_for(0, in.size(), sum, 100);
+
+            Mutex_Scope scope(mutex);
+
+            value += sum.value;
+        }
+    }
+
+    const List<int> & in;
+    int64_t           value;
+    Mutex             mutex;
+};
+
+class Fail : public Thread_Range
+{
+public:
+
+    void run(int begin, int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            if (50 == i)
+            {
+                throw Error("Fail");
+            }
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    List<int> data(100000);
+
+    int64_t value = 0;
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<int>(i % 13);
+
+        value += data[i];
+    }
+
+    const int thread_count [] = { 1, 2, 4, 8 };
+    const int thread_count_size = sizeof(thread_count) / sizeof(int);
+
+    for (int i = 0; i < thread_count_size; ++i)
+    {
+        Thread_Pool::global()->thread_count(thread_count[i]);
+
+        Sum sum(data);
+        Thread_Pool::global()->parallel_for(0, data.size(), sum, 100);
+        DJV_ASSERT(sum.value == value);
+
+        Nested nested(data);
+        Thread_Pool::global()->parallel_for(0, 16, nested);
+        DJV_ASSERT(nested.value == value * 16);
+
+        // Errors are passed on to the caller.
+
+        bool failed = false;
+
+        try
+        {
+            Fail fail;
+            Thread_Pool::global()->parallel_for(0, 100, fail);
+        }
+        catch (const Error & error)
+        {
+            DJV_ASSERT("Fail" == error.string());
+
+            failed = true;
+        }
+
+        DJV_ASSERT(failed);
+
+        // The pool is still usable afterwards.
+
+        Sum sum2(data);
+        Thread_Pool::global()->parallel_for(0, data.size(), sum2, 100);
+        DJV_ASSERT(sum2.value == value);
+    }
+
+    return 0;
+}
+